@@ -21,6 +21,12 @@
 #include "app/fm.h"
 #endif
 #include "app/scanner.h"
+#if defined(ENABLE_SCAN_HISTORY)
+#include "app/history.h"
+#endif
+#if defined(ENABLE_SPECTRUM)
+#include "app/spectrum.h"
+#endif
 #include "audio.h"
 #include "bsp/dp32g030/gpio.h"
 #include "driver/bk1080.h"
@@ -203,6 +209,20 @@ void ACTION_Modem(void)
 }
 #endif
 
+#if defined(ENABLE_SPECTRUM)
+void ACTION_Spectrum(void)
+{
+	SPECTRUM_Start();
+}
+#endif
+
+#if defined(ENABLE_SCAN_HISTORY)
+void ACTION_History(void)
+{
+	HISTORY_Show();
+}
+#endif
+
 void ACTION_Handle(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 {
 	uint8_t Short;
@@ -282,6 +302,16 @@ void ACTION_Handle(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 	case 9:
 #if defined(ENABLE_MODEM)
 		ACTION_Modem();
+#endif
+		break;
+	case 10:
+#if defined(ENABLE_SPECTRUM)
+		ACTION_Spectrum();
+#endif
+		break;
+	case 11:
+#if defined(ENABLE_SCAN_HISTORY)
+		ACTION_History();
 #endif
 		break;
 	}
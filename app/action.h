@@ -26,6 +26,12 @@ void ACTION_FM(void);
 #if defined(ENABLE_MODEM)
 void ACTION_Modem(void);
 #endif
+#if defined(ENABLE_SPECTRUM)
+void ACTION_Spectrum(void);
+#endif
+#if defined(ENABLE_SCAN_HISTORY)
+void ACTION_History(void);
+#endif
 
 void ACTION_Handle(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
 
@@ -20,6 +20,12 @@
 #include "driver/crc.h"
 #include "driver/eeprom.h"
 #include "frequencies.h"
+#if defined(ENABLE_EEPROM_INTEGRITY)
+#include "integrity.h"
+#endif
+#if defined(ENABLE_EEPROM_JOURNAL)
+#include "journal.h"
+#endif
 #include "misc.h"
 #include "radio.h"
 #include "ui/helper.h"
@@ -35,6 +41,28 @@ uint8_t gAirCopyIsSendMode;
 
 uint16_t g_FSK_Buffer[36];
 
+// Writes a received 64 byte block, leaving out the journal and the region
+// checksums, which belong to this radio rather than to the sender.
+static void StoreBlock(uint16_t Offset, const uint16_t *pData)
+{
+	const uint8_t *pBytes = (const uint8_t *)pData;
+
+#if defined(ENABLE_EEPROM_JOURNAL)
+	JOURNAL_Compact();
+	if (Offset >= JOURNAL_EEPROM && Offset < JOURNAL_EEPROM + (JOURNAL_SLOTS * JOURNAL_RECORD_SIZE)) {
+		return;
+	}
+#endif
+#if defined(ENABLE_EEPROM_INTEGRITY)
+	if (Offset < INTEGRITY_EEPROM + INTEGRITY_SIZE && Offset + 64 > INTEGRITY_EEPROM) {
+		EEPROM_WritePages(Offset, pBytes, INTEGRITY_EEPROM - Offset);
+		EEPROM_WritePages(INTEGRITY_EEPROM + INTEGRITY_SIZE, pBytes + (INTEGRITY_EEPROM + INTEGRITY_SIZE - Offset), Offset + 64 - (INTEGRITY_EEPROM + INTEGRITY_SIZE));
+		return;
+	}
+#endif
+	EEPROM_WritePages(Offset, pBytes, 64);
+}
+
 void AIRCOPY_SendMessage(void)
 {
 	uint8_t i;
@@ -78,17 +106,15 @@ void AIRCOPY_StorePacket(void)
 
 		CRC = CRC_Calculate(&g_FSK_Buffer[1], 2 + 64);
 		if (g_FSK_Buffer[34] == CRC) {
-			const uint16_t *pData;
 			uint16_t Offset;
 
 			Offset = g_FSK_Buffer[1];
 			if (Offset < 0x1E00) {
-				pData = &g_FSK_Buffer[2];
-				for (i = 0; i < 8; i++) {
-					EEPROM_WriteBuffer(Offset, pData);
-					pData += 4;
-					Offset += 8;
-				}
+				StoreBlock(Offset, &g_FSK_Buffer[2]);
+#if defined(ENABLE_CHANNEL_CACHE)
+				RADIO_InvalidateChannels();
+#endif
+				Offset += 64;
 				if (Offset == 0x1E00) {
 					gAircopyState = AIRCOPY_COMPLETE;
 				}
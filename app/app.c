@@ -25,11 +25,17 @@
 #include "app/fm.h"
 #endif
 #include "app/generic.h"
+#if defined(ENABLE_SCAN_HISTORY)
+#include "app/history.h"
+#endif
 #include "app/main.h"
 #include "app/menu.h"
 #if defined(ENABLE_MODEM)
 #include "app/modem.h"
 #endif
+#if defined(ENABLE_SPECTRUM)
+#include "app/spectrum.h"
+#endif
 #include "app/scanner.h"
 #if defined(ENABLE_UART)
 #include "app/uart.h"
@@ -43,6 +49,7 @@
 #include "driver/bk1080.h"
 #endif
 #include "driver/bk4819.h"
+#include "driver/eeprom.h"
 #include "driver/gpio.h"
 #include "driver/keyboard.h"
 #include "driver/st7565.h"
@@ -100,6 +107,7 @@ static void APP_CheckForIncoming(void)
 		}
 		ScanPauseDelayIn10msec = 20;
 		gScheduleScanListen = false;
+		gScanDwellRemaining = 0;
 	}
 	gRxReceptionMode = RX_MODE_DETECTED;
 	FUNCTION_Select(FUNCTION_INCOMING);
@@ -251,6 +259,9 @@ Skip:
 	switch (Mode) {
 	case END_OF_RX_MODE_END:
 		RADIO_SetupRegisters(true);
+#if defined(ENABLE_SCAN_HISTORY)
+		HISTORY_RecordEnd();
+#endif
 #if defined(ENABLE_NOAA)
 		if (IS_NOAA_CHANNEL(gRxVfo->CHANNEL_SAVE)) {
 			gSystickCountdown2 = 300;
@@ -316,6 +327,9 @@ void APP_StartListening(FUNCTION_Type_t Function)
 		gEnableSpeaker = true;
 		BACKLIGHT_TurnOn();
 		if (gScanState != SCAN_OFF) {
+#if defined(ENABLE_SCAN_HISTORY)
+			HISTORY_RecordHit();
+#endif
 			switch (gEeprom.SCAN_RESUME_MODE) {
 			case SCAN_RESUME_TO:
 				if (!gScanPauseMode) {
@@ -400,7 +414,7 @@ static void FREQ_NextChannel(void)
 	RADIO_ConfigureSquelchAndOutputPower(gRxVfo);
 	RADIO_SetupRegisters(true);
 	gUpdateDisplay = true;
-	ScanPauseDelayIn10msec = 10;
+	SCANNER_StartDwell(10);
 	bScanKeepFrequency = false;
 }
 
@@ -454,7 +468,7 @@ static void MR_NextChannel(void)
 		RADIO_SetupRegisters(true);
 		gUpdateDisplay = true;
 	}
-	ScanPauseDelayIn10msec = 20;
+	SCANNER_StartDwell(20);
 	bScanKeepFrequency = false;
 	if (bEnabled) {
 		gCurrentScanList++;
@@ -464,6 +478,118 @@ static void MR_NextChannel(void)
 	}
 }
 
+// The priority look-back in progress: the priority channel being listened
+// to, counted from 1, and what the receiver was doing before.
+static uint8_t gPriorityLookbackIndex;
+static uint32_t gPriorityLookbackFrequency;
+static uint16_t gPriorityLookbackInterruptMask;
+static uint16_t gPriorityLookbackAF;
+
+static uint8_t MR_GetPriorityChannel(uint8_t Index)
+{
+	if (Index == 0) {
+		return gEeprom.SCANLIST_PRIORITY_CH1[gEeprom.SCAN_LIST_DEFAULT];
+	}
+
+	return gEeprom.SCANLIST_PRIORITY_CH2[gEeprom.SCAN_LIST_DEFAULT];
+}
+
+// Puts the receiver back on the channel the scan was on.
+static void MR_EndPriority(void)
+{
+	BK4819_SelectFilter(gRxVfo->pRX->Frequency);
+	BK4819_TuneQuick(gRxVfo->pRX->Frequency);
+	BK4819_WriteRegister(BK4819_REG_47, gPriorityLookbackAF);
+	BK4819_WriteRegister(BK4819_REG_3F, gPriorityLookbackInterruptMask);
+	gPriorityLookbackIndex = 0;
+}
+
+// Tunes to the next valid priority channel after the one listened to last,
+// or back to where the scan was when there is none.
+static void MR_TuneNextPriority(void)
+{
+	for (; gPriorityLookbackIndex < 2; gPriorityLookbackIndex++) {
+		const uint8_t Channel = MR_GetPriorityChannel(gPriorityLookbackIndex);
+
+		if (Channel != gNextMrChannel && RADIO_CheckValidChannel(Channel, false, 0)) {
+			EEPROM_ReadBuffer(Channel * 16, &gPriorityLookbackFrequency, 4);
+			BK4819_SelectFilter(gPriorityLookbackFrequency);
+			BK4819_TuneQuick(gPriorityLookbackFrequency);
+			gPriorityLookbackIndex++;
+			return;
+		}
+	}
+
+	MR_EndPriority();
+}
+
+// Starts listening to the scan list's priority channels while the memory
+// scan is stepping or parked on a busy channel. Traffic on the current
+// channel is muted until MR_CheckPriority has been through them.
+static void MR_StartPriority(void)
+{
+	gPriorityLookbackCountdown = PRIORITY_LOOKBACK_INTERVAL;
+
+	// With the squelch open every channel looks busy.
+	if (gEeprom.SQUELCH_LEVEL == 0) {
+		return;
+	}
+
+	gPriorityLookbackInterruptMask = BK4819_ReadRegister(BK4819_REG_3F);
+	gPriorityLookbackAF = BK4819_ReadRegister(BK4819_REG_47);
+	BK4819_WriteRegister(BK4819_REG_3F, 0);
+	BK4819_SetAF(BK4819_AF_MUTE);
+	gPriorityLookbackIndex = 0;
+	MR_TuneNextPriority();
+}
+
+// Runs from the 10 ms time slice, one slice after the priority channel was
+// tuned, and moves the scan over to it if it has a signal.
+static void MR_CheckPriority(void)
+{
+	const uint8_t Found = MR_GetPriorityChannel(gPriorityLookbackIndex - 1);
+
+	// A key, the end of the scan or anything else that set the receiver up
+	// again in the meantime leaves nothing to go back to.
+	if ((BK4819_ReadRegister(BK4819_REG_38) | ((uint32_t)BK4819_ReadRegister(BK4819_REG_39) << 16)) != gPriorityLookbackFrequency) {
+		gPriorityLookbackIndex = 0;
+		return;
+	}
+	if (gScanState == SCAN_OFF) {
+		MR_EndPriority();
+		return;
+	}
+
+	// The squelch rows differ above and below 174 MHz, so the threshold is
+	// the priority channel's own, not the current one's.
+	if (BK4819_GetRSSI() < RADIO_GetSquelchOpenRSSI(gPriorityLookbackFrequency)) {
+		MR_TuneNextPriority();
+		return;
+	}
+	gPriorityLookbackIndex = 0;
+
+	// The scan carries on after the interrupted channel once the priority
+	// traffic has ended. Past scan list 0 the scan is visiting a priority
+	// channel itself, and the interrupted channel is already saved.
+	if (gCurrentScanList == 0) {
+		gPreviousMrChannel = gNextMrChannel;
+	}
+	gCurrentScanList = 2;
+	gNextMrChannel = Found;
+	gEeprom.MrChannel[gEeprom.RX_VFO] = Found;
+	gEeprom.ScreenChannel[gEeprom.RX_VFO] = Found;
+	if (gCurrentFunction != FUNCTION_FOREGROUND) {
+		FUNCTION_Select(FUNCTION_FOREGROUND);
+	}
+	RADIO_ConfigureChannel(gEeprom.RX_VFO, VFO_CONFIGURE_RELOAD);
+	RADIO_SetupRegisters(true);
+	gRxReceptionMode = RX_MODE_NONE;
+	gScanPauseMode = false;
+	ScanPauseDelayIn10msec = 20;
+	gScheduleScanListen = false;
+	gUpdateDisplay = true;
+}
+
 #if defined(ENABLE_NOAA)
 static void NOAA_NextChannel(void)
 {
@@ -668,6 +794,14 @@ void APP_Update(void)
 	if (gReducedService) {
 		return;
 	}
+#if defined(ENABLE_SPECTRUM)
+	// The sweep owns the receiver; scanning, dual watch and power save
+	// would all retune it behind its back.
+	if (gScreenToDisplay == DISPLAY_SPECTRUM) {
+		SPECTRUM_Update();
+		return;
+	}
+#endif
 	if (gCurrentFunction != FUNCTION_TRANSMIT) {
 		APP_HandleFunction();
 	}
@@ -677,7 +811,11 @@ void APP_Update(void)
 	}
 #endif
 
-	if (gScreenToDisplay != DISPLAY_SCANNER && gScanState != SCAN_OFF && gScheduleScanListen && !gPttIsPressed && gVoiceWriteIndex == 0) {
+	if (gScreenToDisplay != DISPLAY_SCANNER && gScanState != SCAN_OFF && gPriorityLookbackIndex == 0 && gScheduleScanListen && gCurrentFunction == FUNCTION_FOREGROUND && SCANNER_ExtendDwell()) {
+		gScheduleScanListen = false;
+	}
+
+	if (gScreenToDisplay != DISPLAY_SCANNER && gScanState != SCAN_OFF && gPriorityLookbackIndex == 0 && gScheduleScanListen && !gPttIsPressed && gVoiceWriteIndex == 0) {
 		if (IS_FREQ_CHANNEL(gNextMrChannel)) {
 			if (gCurrentFunction == FUNCTION_INCOMING) {
 				APP_StartListening(FUNCTION_RECEIVE);
@@ -892,11 +1030,18 @@ void APP_TimeSlice10ms(void)
 	}
 
 	if (gCurrentFunction != FUNCTION_TRANSMIT) {
-		if (gUpdateStatus) {
+		// Leave the redraw for a later pass while the previous frame is
+		// still being sent out by the DMA.
+		if (gUpdateStatus && !gDisplayBusy) {
 			UI_DisplayStatus();
 			gUpdateStatus = false;
 		}
+#if defined(ENABLE_DISPLAY_DOUBLE_BUFFER)
+		// The back buffer is free to draw into while the front one is sent.
 		if (gUpdateDisplay) {
+#else
+		if (gUpdateDisplay && !gDisplayBusy) {
+#endif
 			GUI_DisplayScreen();
 			gUpdateDisplay = false;
 		}
@@ -910,6 +1055,17 @@ void APP_TimeSlice10ms(void)
 	}
 #endif
 
+	// Each priority channel is listened to for one time slice. The scan
+	// does not step while the receiver is away from its channel.
+	if (gPriorityLookbackIndex) {
+		MR_CheckPriority();
+	} else if (gScreenToDisplay != DISPLAY_SCANNER && gScanState != SCAN_OFF && gSchedulePriorityLookback && !gPttIsPressed && gVoiceWriteIndex == 0) {
+		if (IS_MR_CHANNEL(gNextMrChannel)) {
+			MR_StartPriority();
+		}
+		gSchedulePriorityLookback = false;
+	}
+
 	if (gFlashLightState == FLASHLIGHT_BLINK && (gFlashLightBlinkCounter & 15U) == 0) {
 		GPIO_FlipBit(&GPIOC->DATA, GPIOC_PIN_FLASHLIGHT);
 	}
@@ -1039,10 +1195,13 @@ void APP_TimeSlice10ms(void)
 					gScanUseCssResult = true;
 				}
 			} else if (ScanResult == BK4819_CSS_RESULT_CTCSS) {
+				DCS_Confidence_t Confidence;
 				uint8_t Code;
 
-				Code = DCS_GetCtcssCode(CtcssFreq);
-				if (Code != 0xFF) {
+				// A tone near halfway between two options says nothing
+				// about which one is in use, so it does not count as a hit.
+				Code = DCS_GetCtcssCode(CtcssFreq, &Confidence);
+				if (Confidence == DCS_CONFIDENCE_HIGH) {
 					if (Code == gScanCssResultCode && gScanCssResultType == CODE_TYPE_CONTINUOUS_TONE) {
 						gScanHitCount++;
 						if (gScanHitCount >= 2) {
@@ -1085,6 +1244,23 @@ void APP_TimeSlice10ms(void)
 
 void APP_TimeSlice500ms(void)
 {
+	UI_UpdateStatusStats();
+
+	// One page per slice keeps the stall short; more saves arriving in the
+	// meantime are merged into the lines still waiting.
+	if (gCurrentFunction != FUNCTION_TRANSMIT) {
+		EEPROM_FlushPage();
+	}
+
+#if defined(ENABLE_SPECTRUM)
+	if (gScreenToDisplay == DISPLAY_SPECTRUM) {
+		SPECTRUM_TimeSlice500ms();
+	}
+#endif
+#if defined(ENABLE_SCAN_HISTORY)
+	HISTORY_Flush();
+#endif
+
 	// Skipped authentic device check
 
 	if (gKeypadLocked) {
@@ -1106,6 +1282,7 @@ void APP_TimeSlice500ms(void)
 	if (gReducedService) {
 		BOARD_ADC_GetBatteryInfo(&gBatteryCurrentVoltage, &gBatteryCurrent);
 		if (gBatteryCurrent > 500 || gBatteryCalibration[3] < gBatteryCurrentVoltage) {
+			EEPROM_Flush();
 #if defined(ENABLE_OVERLAY)
 			overlay_FLASH_RebootToBootloader();
 #else
@@ -1148,6 +1325,9 @@ void APP_TimeSlice500ms(void)
 #endif
 #if defined(ENABLE_MODEM)
 				gScreenToDisplay != DISPLAY_MODEM &&
+#endif
+#if defined(ENABLE_SPECTRUM)
+				gScreenToDisplay != DISPLAY_SPECTRUM &&
 #endif
 				(gScreenToDisplay != DISPLAY_SCANNER || (gScanCssState >= SCAN_CSS_STATE_FOUND))) {
 				if (gEeprom.AUTO_KEYPAD_LOCK && gKeyLockCountdown && !gDTMF_InputMode) {
@@ -1219,6 +1399,7 @@ void APP_TimeSlice500ms(void)
 					AUDIO_SetVoiceID(0, VOICE_ID_LOW_VOLTAGE);
 					if (gBatteryDisplayLevel == 0) {
 						AUDIO_PlaySingleVoice(true);
+						EEPROM_Flush();
 						gReducedService = true;
 						FUNCTION_Select(FUNCTION_POWER_SAVE);
 						ST7565_HardwareReset();
@@ -1302,6 +1483,8 @@ void CHANNEL_Next(bool bBackup, int8_t Direction)
 	gNextMrChannel = gRxVfo->CHANNEL_SAVE;
 	gCurrentScanList = 0;
 	gScanState = Direction;
+	gPriorityLookbackCountdown = PRIORITY_LOOKBACK_INTERVAL;
+	gSchedulePriorityLookback = false;
 	if (IS_MR_CHANNEL(gNextMrChannel)) {
 		if (bBackup) {
 			gRestoreMrChannel = gNextMrChannel;
@@ -1412,6 +1595,14 @@ static void APP_ProcessKey(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 		return;
 	}
 
+#if defined(ENABLE_SPECTRUM)
+	// Every key, PTT and the side keys included, belongs to the sweep.
+	if (gScreenToDisplay == DISPLAY_SPECTRUM) {
+		SPECTRUM_ProcessKeys(Key, bKeyPressed, bKeyHeld);
+		goto Skip;
+	}
+#endif
+
 	bFlag = false;
 
 	if (gPttWasPressed && Key == KEY_PTT) {
@@ -1533,6 +1724,11 @@ static void APP_ProcessKey(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 #if defined(ENABLE_MODEM)
 			case DISPLAY_MODEM:
 				Modem_ProcessKeys(Key, bKeyPressed, bKeyHeld);
+#endif
+#if defined(ENABLE_SCAN_HISTORY)
+			case DISPLAY_HISTORY:
+				HISTORY_ProcessKeys(Key, bKeyPressed, bKeyHeld);
+				break;
 #endif
 			default:
 				break;
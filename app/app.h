@@ -25,6 +25,7 @@ void APP_EndTransmission(void);
 void CHANNEL_Next(bool bFlag, int8_t Direction);
 void APP_StartListening(FUNCTION_Type_t Function);
 void APP_SetFrequencyByStep(VFO_Info_t *pInfo, int8_t Step);
+void APP_CheckRadioInterrupts(void);
 
 void APP_Update(void);
 void APP_TimeSlice10ms(void);
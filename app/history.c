@@ -0,0 +1,123 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include "app/history.h"
+#include "audio.h"
+#include "driver/bk4819.h"
+#if defined(ENABLE_SCAN_HISTORY_EEPROM)
+#include "driver/eeprom.h"
+#endif
+#include "functions.h"
+#include "misc.h"
+#include "radio.h"
+#include "scanhistory.h"
+#include "ui/ui.h"
+
+// 1D00..1D7F holds the last HISTORY_SAVED hits, one page per batch.
+#define HISTORY_EEPROM 0x1D00U
+
+HISTORY_View_t gHistoryView;
+uint8_t gHistoryAge;
+
+void HISTORY_Load(void)
+{
+#if defined(ENABLE_SCAN_HISTORY_EEPROM)
+	HISTORY_Entry_t Saved[HISTORY_SAVED];
+
+	EEPROM_ReadBuffer(HISTORY_EEPROM, Saved, sizeof(Saved));
+	HISTORY_Init(HISTORY_GetNextSequence(Saved, HISTORY_SAVED));
+#else
+	HISTORY_Init(0);
+#endif
+}
+
+// Saves at most one batch per call, as each page write stalls until the
+// EEPROM has finished it.
+void HISTORY_Flush(void)
+{
+#if defined(ENABLE_SCAN_HISTORY_EEPROM)
+	HISTORY_Entry_t Batch[HISTORY_BATCH];
+	uint16_t Address;
+
+	if (gCurrentFunction == FUNCTION_RECEIVE || gCurrentFunction == FUNCTION_TRANSMIT || !HISTORY_TakeBatch(Batch)) {
+		return;
+	}
+
+	Address = HISTORY_EEPROM + ((Batch[0].Sequence % HISTORY_SAVED) * sizeof(HISTORY_Entry_t));
+	EEPROM_WritePages(Address, Batch, sizeof(Batch));
+#endif
+}
+
+void HISTORY_RecordHit(void)
+{
+	const uint16_t RSSI = BK4819_GetRSSI() >> 1;
+
+	HISTORY_Open(gGlobalSysTickCounter, gRxVfo->CHANNEL_SAVE, gRxVfo->pRX->Frequency, RSSI > 0xFF ? 0xFF : RSSI, gRxVfo->pRX->CodeType, gRxVfo->pRX->Code);
+	if (gScreenToDisplay == DISPLAY_HISTORY) {
+		gUpdateDisplay = true;
+	}
+}
+
+void HISTORY_RecordEnd(void)
+{
+	HISTORY_Close(gGlobalSysTickCounter);
+	if (gScreenToDisplay == DISPLAY_HISTORY) {
+		gUpdateDisplay = true;
+	}
+}
+
+void HISTORY_Show(void)
+{
+	gHistoryAge = 0;
+	gRequestDisplayScreen = DISPLAY_HISTORY;
+}
+
+void HISTORY_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
+{
+	if (!bKeyPressed || bKeyHeld) {
+		return;
+	}
+
+	switch (Key) {
+	case KEY_UP:
+		if (gHistoryAge) {
+			gHistoryAge--;
+		}
+		break;
+
+	case KEY_DOWN:
+		if (gHistoryAge + 1 < HISTORY_GetCount()) {
+			gHistoryAge++;
+		}
+		break;
+
+	case KEY_5:
+		gHistoryView = (gHistoryView == HISTORY_VIEW_LOG) ? HISTORY_VIEW_BUSIEST : HISTORY_VIEW_LOG;
+		break;
+
+	case KEY_EXIT:
+		gRequestDisplayScreen = DISPLAY_MAIN;
+		break;
+
+	default:
+		gBeepToPlay = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
+		return;
+	}
+
+	gBeepToPlay = BEEP_1KHZ_60MS_OPTIONAL;
+	gUpdateDisplay = true;
+}
+
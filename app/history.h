@@ -0,0 +1,42 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_HISTORY_H
+#define APP_HISTORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driver/keyboard.h"
+
+enum HISTORY_View_t {
+	HISTORY_VIEW_LOG     = 0U,
+	HISTORY_VIEW_BUSIEST = 1U,
+};
+
+typedef enum HISTORY_View_t HISTORY_View_t;
+
+extern HISTORY_View_t gHistoryView;
+extern uint8_t gHistoryAge;
+
+void HISTORY_Load(void);
+void HISTORY_Flush(void);
+void HISTORY_RecordHit(void);
+void HISTORY_RecordEnd(void);
+void HISTORY_Show(void);
+void HISTORY_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
+
+#endif
+
@@ -26,8 +26,10 @@
 #include "board.h"
 #include "bsp/dp32g030/gpio.h"
 #include "driver/backlight.h"
+#include "driver/eeprom.h"
 #include "driver/gpio.h"
 #include "driver/keyboard.h"
+#include "driver/st7565.h"
 #include "frequencies.h"
 #include "misc.h"
 #include "settings.h"
@@ -996,11 +998,13 @@ static void MENU_Key_MENU(bool bKeyPressed, bool bKeyHeld)
 					break;
 				case 1:
 					gAskForConfirmation = 2;
+					ST7565_WaitForBlit();
 					UI_DisplayMenu();
 					if (gMenuCursor == MENU_RESET) {
 						AUDIO_SetVoiceID(0, VOICE_ID_CONFIRM);
 						AUDIO_PlaySingleVoice(true);
 						MENU_AcceptSetting();
+						EEPROM_Flush();
 #if defined(ENABLE_OVERLAY)
 						overlay_FLASH_RebootToBootloader();
 #else
@@ -42,6 +42,7 @@ uint8_t gScanHitCount;
 bool gScanUseCssResult;
 int8_t gScanState;
 bool bScanKeepFrequency;
+uint8_t gScanDwellRemaining;
 
 static void SCANNER_Key_DIGITS(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 {
@@ -284,6 +285,43 @@ void SCANNER_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 	}
 }
 
+// Both indicators rise with noise. A channel is clearly empty when they
+// are at or above the levels at which the squelch would close anyway.
+bool SCANNER_IsChannelEmpty(uint8_t Noise, uint8_t Glitch, uint8_t NoiseThreshold, uint8_t GlitchThreshold)
+{
+	return Noise >= NoiseThreshold && Glitch >= GlitchThreshold;
+}
+
+void SCANNER_StartDwell(uint16_t Dwell)
+{
+	ScanPauseDelayIn10msec = SCAN_DWELL_PROBE;
+	gScanDwellRemaining = Dwell - SCAN_DWELL_PROBE;
+}
+
+// Called when the probe part of a dwell has run out without the squelch
+// opening. Returns true when the channel gets the rest of its dwell.
+bool SCANNER_ExtendDwell(void)
+{
+	uint8_t Noise;
+	uint8_t Glitch;
+
+	if (gScanDwellRemaining == 0) {
+		return false;
+	}
+
+	Noise = BK4819_ReadRegister(BK4819_REG_65) & 0x007F;
+	Glitch = BK4819_ReadRegister(BK4819_REG_63) & 0x00FF;
+	if (SCANNER_IsChannelEmpty(Noise, Glitch, gRxVfo->SquelchCloseNoise, gRxVfo->SquelchCloseGlitch)) {
+		gScanDwellRemaining = 0;
+		return false;
+	}
+
+	ScanPauseDelayIn10msec = gScanDwellRemaining;
+	gScanDwellRemaining = 0;
+
+	return true;
+}
+
 void SCANNER_Start(void)
 {
 	uint8_t BackupStep;
@@ -33,6 +33,11 @@ enum {
 	SCAN_OFF = 0U,
 };
 
+// Every scan step first listens for SCAN_DWELL_PROBE 10 ms ticks; only
+// channels whose noise and glitch readings are not clearly empty get the
+// rest of their dwell.
+#define SCAN_DWELL_PROBE 3U
+
 extern DCS_CodeType_t gScanCssResultType;
 extern uint8_t gScanCssResultCode;
 extern bool gFlagStartScan;
@@ -50,8 +55,12 @@ extern uint8_t gScanHitCount;
 extern bool gScanUseCssResult;
 extern int8_t gScanState;
 extern bool bScanKeepFrequency;
+extern uint8_t gScanDwellRemaining;
 
 void SCANNER_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
+bool SCANNER_IsChannelEmpty(uint8_t Noise, uint8_t Glitch, uint8_t NoiseThreshold, uint8_t GlitchThreshold);
+void SCANNER_StartDwell(uint16_t Dwell);
+bool SCANNER_ExtendDwell(void);
 void SCANNER_Start(void);
 void SCANNER_Stop(void);
 
@@ -0,0 +1,221 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+#include "app/spectrum.h"
+#include "audio.h"
+#include "bsp/dp32g030/gpio.h"
+#include "driver/bk4819.h"
+#include "driver/gpio.h"
+#include "driver/systick.h"
+#if defined(ENABLE_UART)
+#include "driver/uart.h"
+#include "external/printf/printf.h"
+#endif
+#include "frequencies.h"
+#include "functions.h"
+#include "misc.h"
+#include "radio.h"
+#include "ui/ui.h"
+
+#define FILTER_PATH_UNKNOWN	0xFFU
+#define SETTLE_STEP_US		100U
+#define SETTLE_MAX_US		3000U
+
+static const uint16_t StepTable[8] = { 250, 500, 625, 1000, 1250, 2500, 5000, 10000 };
+
+SPECTRUM_Mode_t gSpectrumMode;
+uint32_t gSpectrumStart;
+uint8_t gSpectrumStepIndex = 4;
+uint16_t gSpectrumSettleUs = 600;
+uint8_t gSpectrumRssi[SPECTRUM_POINTS];
+uint16_t gSpectrumPointsPerSecond;
+uint16_t gSpectrumSweepCount;
+
+static uint8_t gSweepIndex;
+static uint8_t gFilterPath;
+static uint16_t gPointCount;
+
+static void SetStart(uint32_t Start)
+{
+	const uint32_t Span = SPECTRUM_POINTS * (uint32_t)SPECTRUM_GetStep();
+	const uint32_t Lower = LowerLimitFrequencyBandTable[BAND1_50MHz];
+	const uint32_t Upper = UpperLimitFrequencyBandTable[BAND7_470MHz] - Span;
+
+	if ((int32_t)Start < (int32_t)Lower) {
+		Start = Lower;
+	} else if (Start > Upper) {
+		Start = Upper;
+	}
+	gSpectrumStart = Start;
+	gSweepIndex = 0;
+}
+
+static void Retune(uint32_t Frequency)
+{
+	const uint8_t Path = Frequency >= 28000000;
+
+	// The LNA path only needs switching when the sweep crosses 280 MHz.
+	if (Path != gFilterPath) {
+		BK4819_SelectFilter(Frequency);
+		gFilterPath = Path;
+	}
+	BK4819_TuneQuick(Frequency);
+}
+
+static void Exit(void)
+{
+	gFlagReconfigureVfos = true;
+	gRequestDisplayScreen = DISPLAY_MAIN;
+}
+
+uint16_t SPECTRUM_GetStep(void)
+{
+	return StepTable[gSpectrumStepIndex];
+}
+
+void SPECTRUM_Start(void)
+{
+	if (gCurrentFunction != FUNCTION_FOREGROUND) {
+		FUNCTION_Select(FUNCTION_FOREGROUND);
+	}
+
+	BK4819_SetAF(BK4819_AF_MUTE);
+	GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_AUDIO_PATH);
+	gEnableSpeaker = false;
+
+	// Squelch and tone interrupts would hand the radio back to the
+	// receive path half way through a sweep.
+	BK4819_WriteRegister(BK4819_REG_3F, 0);
+
+	memset(gSpectrumRssi, 0, sizeof(gSpectrumRssi));
+	gFilterPath = FILTER_PATH_UNKNOWN;
+	gPointCount = 0;
+	gSpectrumPointsPerSecond = 0;
+	SetStart(gRxVfo->pRX->Frequency - ((SPECTRUM_POINTS / 2) * SPECTRUM_GetStep()));
+
+	gRequestDisplayScreen = DISPLAY_SPECTRUM;
+}
+
+// Measures one point per call so keys and timeslices keep running while
+// the sweep is in progress.
+void SPECTRUM_Update(void)
+{
+	uint16_t RSSI;
+
+	Retune(gSpectrumStart + (gSweepIndex * SPECTRUM_GetStep()));
+	if (gSpectrumSettleUs) {
+		SYSTICK_DelayUs(gSpectrumSettleUs);
+	}
+
+	// dB units above -160 dBm are enough for the display.
+	RSSI = BK4819_GetRSSI() >> 1;
+	gSpectrumRssi[gSweepIndex] = RSSI > 0xFF ? 0xFF : RSSI;
+	gPointCount++;
+
+	gSweepIndex++;
+	if (gSweepIndex == SPECTRUM_POINTS) {
+		gSweepIndex = 0;
+		gSpectrumSweepCount++;
+		gUpdateDisplay = true;
+	}
+}
+
+void SPECTRUM_TimeSlice500ms(void)
+{
+	gSpectrumPointsPerSecond = gPointCount * 2;
+	gPointCount = 0;
+
+#if defined(ENABLE_UART)
+	{
+		char String[40];
+		int Length;
+
+		Length = sprintf(String, "SPECTRUM %u pts/s %u us\r\n", gSpectrumPointsPerSecond, gSpectrumSettleUs);
+		UART_LogSend(String, Length);
+	}
+#endif
+}
+
+void SPECTRUM_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
+{
+	const uint32_t Center = gSpectrumStart + ((SPECTRUM_POINTS / 2) * SPECTRUM_GetStep());
+
+	if (!bKeyPressed) {
+		return;
+	}
+
+	switch (Key) {
+	case KEY_UP:
+		SetStart(gSpectrumStart + ((SPECTRUM_POINTS / 4) * SPECTRUM_GetStep()));
+		break;
+
+	case KEY_DOWN:
+		SetStart(gSpectrumStart - ((SPECTRUM_POINTS / 4) * SPECTRUM_GetStep()));
+		break;
+
+	case KEY_1:
+		if (gSpectrumStepIndex < ARRAY_SIZE(StepTable) - 1) {
+			gSpectrumStepIndex++;
+		}
+		SetStart(Center - ((SPECTRUM_POINTS / 2) * SPECTRUM_GetStep()));
+		break;
+
+	case KEY_7:
+		if (gSpectrumStepIndex) {
+			gSpectrumStepIndex--;
+		}
+		SetStart(Center - ((SPECTRUM_POINTS / 2) * SPECTRUM_GetStep()));
+		break;
+
+	case KEY_2:
+		if (gSpectrumSettleUs < SETTLE_MAX_US) {
+			gSpectrumSettleUs += SETTLE_STEP_US;
+		}
+		break;
+
+	case KEY_8:
+		if (gSpectrumSettleUs) {
+			gSpectrumSettleUs -= SETTLE_STEP_US;
+		}
+		break;
+
+	case KEY_5:
+		if (bKeyHeld) {
+			return;
+		}
+		gSpectrumMode = (gSpectrumMode == SPECTRUM_MODE_BARS) ? SPECTRUM_MODE_WATERFALL : SPECTRUM_MODE_BARS;
+		break;
+
+	case KEY_EXIT:
+		if (!bKeyHeld) {
+			Exit();
+		}
+		return;
+
+	default:
+		if (!bKeyHeld) {
+			gBeepToPlay = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
+		}
+		return;
+	}
+
+	if (!bKeyHeld) {
+		gBeepToPlay = BEEP_1KHZ_60MS_OPTIONAL;
+	}
+	gUpdateDisplay = true;
+}
+
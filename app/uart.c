@@ -30,9 +30,20 @@
 #include "driver/crc.h"
 #include "driver/eeprom.h"
 #include "driver/gpio.h"
+#include "driver/st7565.h"
+#include "driver/systick.h"
 #include "driver/uart.h"
 #include "functions.h"
+#if defined(ENABLE_EEPROM_INTEGRITY)
+#include "integrity.h"
+#endif
+#if defined(ENABLE_EEPROM_JOURNAL)
+#include "journal.h"
+#endif
 #include "misc.h"
+#if defined(ENABLE_SCAN_HISTORY)
+#include "scanhistory.h"
+#endif
 #include "settings.h"
 #if defined(ENABLE_OVERLAY)
 #include "sram-overlay.h"
@@ -41,6 +52,21 @@
 
 #define DMA_INDEX(x, y) (((x) + (y)) % sizeof(UART_DMA_Buffer))
 
+#if defined(ENABLE_EEPROM_JOURNAL)
+// The radio keeps its own journal; one uploaded from an earlier read would
+// replay stale values over the ones written alongside it.
+#define IS_JOURNAL_BLOCK(x) ((x) >= JOURNAL_EEPROM && (x) < JOURNAL_EEPROM + (JOURNAL_SLOTS * JOURNAL_RECORD_SIZE))
+#else
+#define IS_JOURNAL_BLOCK(x) false
+#endif
+
+#if defined(ENABLE_EEPROM_INTEGRITY)
+// The checksums follow the radio's own writes, upload included.
+#define IS_INTEGRITY_BLOCK(x) ((x) >= INTEGRITY_EEPROM && (x) < INTEGRITY_EEPROM + INTEGRITY_SIZE)
+#else
+#define IS_INTEGRITY_BLOCK(x) false
+#endif
+
 typedef struct {
 	uint16_t ID;
 	uint16_t Size;
@@ -136,6 +162,78 @@ typedef struct {
 	uint32_t Timestamp;
 } CMD_052F_t;
 
+typedef struct {
+	Header_t Header;
+	uint8_t Page;
+	uint8_t Padding[3];
+	uint32_t Timestamp;
+} CMD_0531_t;
+
+typedef struct {
+	Header_t Header;
+	struct {
+		uint8_t Page;
+		uint8_t Padding[3];
+		uint8_t Data[128];
+	} Data;
+} REPLY_0531_t;
+
+#if defined(ENABLE_SCAN_HISTORY)
+typedef struct {
+	Header_t Header;
+	uint8_t Index;
+	uint8_t Padding[3];
+	uint32_t Timestamp;
+} CMD_0533_t;
+
+typedef struct {
+	Header_t Header;
+	struct {
+		uint8_t Index;
+		uint8_t Count;
+		uint8_t Padding[2];
+		HISTORY_Entry_t Entry;
+		uint8_t Hits[8];
+	} Data;
+} REPLY_0533_t;
+#endif
+
+typedef struct {
+	Header_t Header;
+	uint32_t Timestamp;
+} CMD_0535_t;
+
+typedef struct {
+	Header_t Header;
+	struct {
+		uint32_t Microseconds;
+		uint32_t BytesPerSecond;
+		uint16_t Size;
+		uint16_t Sum;
+	} Data;
+} REPLY_0535_t;
+
+#if defined(ENABLE_EEPROM_INTEGRITY)
+typedef struct {
+	Header_t Header;
+	uint32_t Timestamp;
+} CMD_0537_t;
+
+typedef struct {
+	Header_t Header;
+	struct {
+		uint8_t Count;
+		uint8_t Failures;
+		uint8_t Padding[2];
+		struct {
+			uint16_t Start;
+			uint16_t End;
+			uint16_t Crc;
+		} Regions[INTEGRITY_REGIONS];
+	} Data;
+} REPLY_0537_t;
+#endif
+
 static const uint8_t Obfuscation[16] = { 0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40, 0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80 };
 
 static union {
@@ -284,21 +382,37 @@ static void CMD_051D(const uint8_t *pBuffer)
 	}
 
 	if (!bIsLocked) {
+		const uint16_t Blocks = pCmd->Size / 8U;
+		uint16_t Start = 0;
 		uint16_t i;
 
-		for (i = 0; i < (pCmd->Size / 8U); i++) {
+#if defined(ENABLE_EEPROM_JOURNAL)
+		JOURNAL_Compact();
+#endif
+
+		// Runs of writable blocks go out as page writes, split only around
+		// blocks that may not be written.
+		for (i = 0; i <= Blocks; i++) {
 			uint16_t Offset = pCmd->Offset + (i * 8U);
 
-			if (Offset >= 0x0F30 && Offset < 0x0F40) {
-				if (!gIsLocked) {
-					bReloadEeprom = true;
+			if (i < Blocks) {
+				if (Offset >= 0x0F30 && Offset < 0x0F40) {
+					if (!gIsLocked) {
+						bReloadEeprom = true;
+					}
+				}
+				if (((Offset < 0x0E98 || Offset >= 0x0EA0) || !bIsInLockScreen || pCmd->bAllowPassword) && !IS_JOURNAL_BLOCK(Offset) && !IS_INTEGRITY_BLOCK(Offset)) {
+					continue;
 				}
 			}
-
-			if ((Offset < 0x0E98 || Offset >= 0x0EA0) || !bIsInLockScreen || pCmd->bAllowPassword) {
-				EEPROM_WriteBuffer(Offset, &pCmd->Data[i * 8U]);
+			if (i > Start) {
+				EEPROM_WritePages(pCmd->Offset + (Start * 8U), &pCmd->Data[Start * 8U], (i - Start) * 8U);
 			}
+			Start = i + 1;
 		}
+#if defined(ENABLE_CHANNEL_CACHE)
+		RADIO_InvalidateChannels();
+#endif
 
 		if (bReloadEeprom) {
 			BOARD_EEPROM_Init();
@@ -394,6 +508,138 @@ static void CMD_052F(const uint8_t *pBuffer)
 	SendVersion();
 }
 
+// Reads back one display page as last composed by the UI: page 0 is the
+// status line, pages 1 to 7 are gFrameBuffer. Used by tools/screen-dump.py.
+static void CMD_0531(const uint8_t *pBuffer)
+{
+	const CMD_0531_t *pCmd = (const CMD_0531_t *)pBuffer;
+	REPLY_0531_t Reply;
+
+	if (pCmd->Timestamp != Timestamp || pCmd->Page > 7) {
+		return;
+	}
+
+	memset(&Reply, 0, sizeof(Reply));
+	Reply.Header.ID = 0x0532;
+	Reply.Header.Size = sizeof(Reply.Data);
+	Reply.Data.Page = pCmd->Page;
+	if (pCmd->Page == 0) {
+		memcpy(Reply.Data.Data, gStatusLine, sizeof(Reply.Data.Data));
+	} else {
+		memcpy(Reply.Data.Data, gFrameBuffer[pCmd->Page - 1], sizeof(Reply.Data.Data));
+	}
+
+	SendReply(&Reply, sizeof(Reply));
+}
+
+#if defined(ENABLE_SCAN_HISTORY)
+// Reads back the scan history: the hit Index places from the newest (zeroed
+// past Count) and the hit counters of channels Index * 8 to Index * 8 + 7.
+// Used by tools/scan-history.py.
+static void CMD_0533(const uint8_t *pBuffer)
+{
+	const CMD_0533_t *pCmd = (const CMD_0533_t *)pBuffer;
+	const HISTORY_Entry_t *pEntry;
+	REPLY_0533_t Reply;
+	uint8_t i;
+
+	if (pCmd->Timestamp != Timestamp) {
+		return;
+	}
+
+	memset(&Reply, 0, sizeof(Reply));
+	Reply.Header.ID = 0x0534;
+	Reply.Header.Size = sizeof(Reply.Data);
+	Reply.Data.Index = pCmd->Index;
+	Reply.Data.Count = HISTORY_GetCount();
+	pEntry = HISTORY_Get(pCmd->Index);
+	if (pEntry) {
+		Reply.Data.Entry = *pEntry;
+	}
+	for (i = 0; i < 8; i++) {
+		const uint16_t Channel = (pCmd->Index * 8) + i;
+
+		if (Channel <= MR_CHANNEL_LAST) {
+			Reply.Data.Hits[i] = HISTORY_GetHits(Channel);
+		}
+	}
+
+	SendReply(&Reply, sizeof(Reply));
+}
+#endif
+
+// Times a 1 KB read from the start of the EEPROM to measure the I2C
+// throughput. The byte sum lets a fast I2C build be checked against a
+// standard one. Used by tools/eeprom-speed.py.
+static void CMD_0535(const uint8_t *pBuffer)
+{
+	const CMD_0535_t *pCmd = (const CMD_0535_t *)pBuffer;
+	REPLY_0535_t Reply;
+	uint8_t Data[128];
+	uint32_t Start;
+	uint16_t Address;
+	uint16_t Sum;
+	uint8_t i;
+
+	if (pCmd->Timestamp != Timestamp) {
+		return;
+	}
+
+	Sum = 0;
+	Start = SYSTICK_GetMicroseconds();
+	for (Address = 0; Address < 1024; Address += sizeof(Data)) {
+		EEPROM_ReadBuffer(Address, Data, sizeof(Data));
+		for (i = 0; i < sizeof(Data); i++) {
+			Sum += Data[i];
+		}
+	}
+
+	memset(&Reply, 0, sizeof(Reply));
+	Reply.Header.ID = 0x0536;
+	Reply.Header.Size = sizeof(Reply.Data);
+	Reply.Data.Microseconds = SYSTICK_GetMicroseconds() - Start;
+	Reply.Data.Size = 1024;
+	Reply.Data.Sum = Sum;
+	if (Reply.Data.Microseconds) {
+		Reply.Data.BytesPerSecond = (1024U * 1000000U) / Reply.Data.Microseconds;
+	}
+
+	SendReply(&Reply, sizeof(Reply));
+}
+
+#if defined(ENABLE_EEPROM_INTEGRITY)
+// Returns the CRC-16/XMODEM of every EEPROM region and the regions that
+// failed the check at boot, so a programming tool only needs to read the
+// regions that differ from its image. Used by tools/eeprom-regions.py.
+static void CMD_0537(const uint8_t *pBuffer)
+{
+	const CMD_0537_t *pCmd = (const CMD_0537_t *)pBuffer;
+	REPLY_0537_t Reply;
+	uint8_t i;
+
+	if (pCmd->Timestamp != Timestamp) {
+		return;
+	}
+
+	if (!INTEGRITY_IsValid()) {
+		INTEGRITY_Verify();
+	}
+
+	memset(&Reply, 0, sizeof(Reply));
+	Reply.Header.ID = 0x0538;
+	Reply.Header.Size = sizeof(Reply.Data);
+	Reply.Data.Count = INTEGRITY_REGIONS;
+	Reply.Data.Failures = gIntegrityFailures;
+	for (i = 0; i < INTEGRITY_REGIONS; i++) {
+		Reply.Data.Regions[i].Start = gIntegrityRegions[i].Start;
+		Reply.Data.Regions[i].End = gIntegrityRegions[i].End;
+		Reply.Data.Regions[i].Crc = INTEGRITY_GetCrc(i);
+	}
+
+	SendReply(&Reply, sizeof(Reply));
+}
+#endif
+
 bool UART_IsCommandAvailable(void)
 {
 	uint16_t DmaLength;
@@ -526,7 +772,28 @@ void UART_HandleCommand(void)
 		CMD_052F(UART_Command.Buffer);
 		break;
 
+	case 0x0531:
+		CMD_0531(UART_Command.Buffer);
+		break;
+
+#if defined(ENABLE_SCAN_HISTORY)
+	case 0x0533:
+		CMD_0533(UART_Command.Buffer);
+		break;
+#endif
+
+	case 0x0535:
+		CMD_0535(UART_Command.Buffer);
+		break;
+
+#if defined(ENABLE_EEPROM_INTEGRITY)
+	case 0x0537:
+		CMD_0537(UART_Command.Buffer);
+		break;
+#endif
+
 	case 0x05DD:
+		EEPROM_Flush();
 #if defined(ENABLE_OVERLAY)
 		overlay_FLASH_RebootToBootloader();
 #else
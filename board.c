@@ -34,16 +34,31 @@
 #include "driver/eeprom.h"
 #include "driver/flash.h"
 #include "driver/gpio.h"
+#if defined(ENABLE_I2C_FAST)
+#include "driver/i2c.h"
+#endif
 #include "driver/system.h"
 #include "driver/st7565.h"
 #include "frequencies.h"
 #include "helper/battery.h"
+#if defined(ENABLE_EEPROM_INTEGRITY)
+#include "integrity.h"
+#endif
+#if defined(ENABLE_EEPROM_JOURNAL)
+#include "journal.h"
+#endif
 #include "misc.h"
 #include "settings.h"
 #if defined(ENABLE_OVERLAY)
 #include "sram-overlay.h"
 #endif
 
+// BOARD_EEPROM_Init parses the settings from copies of 0E70..0EAF,
+// 0ED0..0F1F and 0F30..0F47 in turn, each read at Base into a buffer that
+// fits the largest of them.
+#define SETTINGS_SIZE	(0x0F20U - 0x0ED0U)
+#define SETTING(x)	(Settings + ((x) - Base))
+
 #if defined(ENABLE_OVERLAY)
 void BOARD_FLASH_Init(void)
 {
@@ -496,25 +511,34 @@ void BOARD_Init(void)
 {
 	BOARD_PORTCON_Init();
 	BOARD_GPIO_Init();
+#if defined(ENABLE_I2C_FAST)
+	I2C_Calibrate();
+#endif
 	BOARD_ADC_Init();
 	ST7565_Init();
 #if defined(ENABLE_FMRADIO)
 	BK1080_Init(0, false);
 #endif
-#if defined(ENABLE_AIRCOPY) || defined(ENABLE_UART)
+#if defined(ENABLE_AIRCOPY) || defined(ENABLE_UART) || defined(ENABLE_EEPROM_INTEGRITY)
 	CRC_Init();
 #endif
 }
 
 void BOARD_EEPROM_Init(void)
 {
-	uint8_t Data[16];
+	uint8_t Settings[SETTINGS_SIZE];
+	const uint8_t *Data;
+	uint16_t Base;
 	uint8_t i;
 
-	memset(Data, 0, sizeof(Data));
+	// Three reads cover every setting parsed below. The welcome strings and
+	// the unused bytes after the scan lists are the only gaps that take
+	// longer to clock in than addressing the EEPROM again.
+	Base = 0x0E70;
+	EEPROM_ReadBuffer(Base, Settings, 0x0EB0 - Base);
 
 	// 0E70..0E77
-	EEPROM_ReadBuffer(0x0E70, Data, 8);
+	Data = SETTING(0x0E70);
 	gEeprom.CHAN_1_CALL      = IS_MR_CHANNEL(Data[0]) ? Data[0] : MR_CHANNEL_FIRST;
 	gEeprom.SQUELCH_LEVEL    = (Data[1] < 10) ? Data[1] : 4;
 	gEeprom.TX_TIMEOUT_TIMER = (Data[2] < 11) ? Data[2] : 2;
@@ -525,7 +549,7 @@ void BOARD_EEPROM_Init(void)
 	gEeprom.MIC_SENSITIVITY  = (Data[7] <  5) ? Data[7] : 2;
 
 	// 0E78..0E7F
-	EEPROM_ReadBuffer(0x0E78, Data, 8);
+	Data = SETTING(0x0E78);
 	gEeprom.CHANNEL_DISPLAY_MODE  = (Data[1] < 3) ? Data[1] : MDF_FREQUENCY;
 	gEeprom.CROSS_BAND_RX_TX      = (Data[2] < 3) ? Data[2] : CROSS_BAND_OFF;
 	gEeprom.BATTERY_SAVE          = (Data[3] < 5) ? Data[3] : 4;
@@ -535,7 +559,7 @@ void BOARD_EEPROM_Init(void)
 	gEeprom.VFO_OPEN              = (Data[7] < 2) ? Data[7] : true;
 
 	// 0E80..0E87
-	EEPROM_ReadBuffer(0x0E80, Data, 8);
+	Data = SETTING(0x0E80);
 	gEeprom.ScreenChannel[0] = IS_VALID_CHANNEL(Data[0]) ? Data[0] : (FREQ_CHANNEL_FIRST + BAND6_400MHz);
 	gEeprom.ScreenChannel[1] = IS_VALID_CHANNEL(Data[3]) ? Data[3] : (FREQ_CHANNEL_FIRST + BAND6_400MHz);
 	gEeprom.MrChannel[0]     = IS_MR_CHANNEL(Data[1])    ? Data[1] : MR_CHANNEL_FIRST;
@@ -556,7 +580,7 @@ void BOARD_EEPROM_Init(void)
 		uint8_t Padding[8];
 	} FM;
 
-	EEPROM_ReadBuffer(0x0E88, &FM, 8);
+	memcpy(&FM, SETTING(0x0E88), 8);
 	gEeprom.FM_LowerLimit = 760;
 	gEeprom.FM_UpperLimit = 1080;
 	if (FM.SelectedFrequency < gEeprom.FM_LowerLimit || FM.SelectedFrequency > gEeprom.FM_UpperLimit) {
@@ -574,26 +598,26 @@ void BOARD_EEPROM_Init(void)
 #endif
 
 	// 0E90..0E97
-	EEPROM_ReadBuffer(0x0E90, Data, 8);
+	Data = SETTING(0x0E90);
 	gEeprom.BEEP_CONTROL             = (Data[0] < 2) ? Data[0] : true;
-	gEeprom.KEY_1_SHORT_PRESS_ACTION = (Data[1] < 10) ? Data[1] : 3;
-	gEeprom.KEY_1_LONG_PRESS_ACTION  = (Data[2] < 10) ? Data[2] : 8;
-	gEeprom.KEY_2_SHORT_PRESS_ACTION = (Data[3] < 10) ? Data[3] : 1;
-	gEeprom.KEY_2_LONG_PRESS_ACTION  = (Data[4] < 10) ? Data[4] : 6;
+	gEeprom.KEY_1_SHORT_PRESS_ACTION = (Data[1] < 12) ? Data[1] : 3;
+	gEeprom.KEY_1_LONG_PRESS_ACTION  = (Data[2] < 12) ? Data[2] : 8;
+	gEeprom.KEY_2_SHORT_PRESS_ACTION = (Data[3] < 12) ? Data[3] : 1;
+	gEeprom.KEY_2_LONG_PRESS_ACTION  = (Data[4] < 12) ? Data[4] : 6;
 	gEeprom.SCAN_RESUME_MODE         = (Data[5] < 3) ? Data[5] : SCAN_RESUME_CO;
 	gEeprom.AUTO_KEYPAD_LOCK         = (Data[6] < 2) ? Data[6] : true;
 	gEeprom.POWER_ON_DISPLAY_MODE    = (Data[7] < 3) ? Data[7] : POWER_ON_DISPLAY_MODE_MESSAGE;
 
 	// 0E98..0E9F
-	EEPROM_ReadBuffer(0x0E98, Data, 8);
+	Data = SETTING(0x0E98);
 	memcpy(&gEeprom.POWER_ON_PASSWORD, Data, 4);
 
 	// 0EA0..0EA7
-	EEPROM_ReadBuffer(0x0EA0, Data, 8);
+	Data = SETTING(0x0EA0);
 	gEeprom.VOICE_PROMPT = (Data[0] < 3) ? Data[0] : VOICE_PROMPT_CHINESE;
 
 	// 0EA8..0EAF
-	EEPROM_ReadBuffer(0x0EA8, Data, 8);
+	Data = SETTING(0x0EA8);
 #if defined(ENABLE_ALARM)
 	gEeprom.ALARM_MODE                     = (Data[0] <  2) ? Data[0] : true;
 #endif
@@ -601,8 +625,11 @@ void BOARD_EEPROM_Init(void)
 	gEeprom.REPEATER_TAIL_TONE_ELIMINATION = (Data[2] < 11) ? Data[2] : 0;
 	gEeprom.TX_VFO                         = (Data[3] <  2) ? Data[3] : 0;
 
+	Base = 0x0ED0;
+	EEPROM_ReadBuffer(Base, Settings, 0x0F20 - Base);
+
 	// 0ED0..0ED7
-	EEPROM_ReadBuffer(0x0ED0, Data, 8);
+	Data = SETTING(0x0ED0);
 	gEeprom.DTMF_SIDE_TONE               = (Data[0] <   2) ? Data[0] : true;
 	gEeprom.DTMF_SEPARATE_CODE           = DTMF_ValidateCodes((char *)(Data + 1), 1) ? Data[1] : '*';
 	gEeprom.DTMF_GROUP_CALL_CODE         = DTMF_ValidateCodes((char *)(Data + 2), 1) ? Data[2] : '#';
@@ -613,13 +640,13 @@ void BOARD_EEPROM_Init(void)
 	gEeprom.DTMF_HASH_CODE_PERSIST_TIME  = (Data[7] < 101) ? Data[7] * 10 : 100;
 
 	// 0ED8..0EDF
-	EEPROM_ReadBuffer(0x0ED8, Data, 8);
+	Data = SETTING(0x0ED8);
 	gEeprom.DTMF_CODE_PERSIST_TIME  = (Data[0] < 101) ? Data[0] * 10 : 100;
 	gEeprom.DTMF_CODE_INTERVAL_TIME = (Data[1] < 101) ? Data[1] * 10 : 100;
 	gEeprom.PERMIT_REMOTE_KILL      = (Data[2] <   2) ? Data[2] : true;
 
 	// 0EE0..0EE7
-	EEPROM_ReadBuffer(0x0EE0, Data, 8);
+	Data = SETTING(0x0EE0);
 	if (DTMF_ValidateCodes((char *)Data, 8)) {
 		memcpy(gEeprom.ANI_DTMF_ID, Data, 8);
 	} else {
@@ -628,7 +655,7 @@ void BOARD_EEPROM_Init(void)
 	}
 
 	// 0EE8..0EEF
-	EEPROM_ReadBuffer(0x0EE8, Data, 8);
+	Data = SETTING(0x0EE8);
 	if (DTMF_ValidateCodes((char *)Data, 8)) {
 		memcpy(gEeprom.KILL_CODE, Data, 8);
 	} else {
@@ -636,7 +663,7 @@ void BOARD_EEPROM_Init(void)
 	}
 
 	// 0EF0..0EF7
-	EEPROM_ReadBuffer(0x0EF0, Data, 8);
+	Data = SETTING(0x0EF0);
 	if (DTMF_ValidateCodes((char *)Data, 8)) {
 		memcpy(gEeprom.REVIVE_CODE, Data, 8);
 	} else {
@@ -644,7 +671,7 @@ void BOARD_EEPROM_Init(void)
 	}
 
 	// 0EF8..0F07
-	EEPROM_ReadBuffer(0x0EF8, Data, 16);
+	Data = SETTING(0x0EF8);
 	if (DTMF_ValidateCodes((char *)Data, 16)) {
 		memcpy(gEeprom.DTMF_UP_CODE, Data, 16);
 	} else {
@@ -652,7 +679,7 @@ void BOARD_EEPROM_Init(void)
 	}
 
 	// 0F08..0F17
-	EEPROM_ReadBuffer(0x0F08, Data, 16);
+	Data = SETTING(0x0F08);
 	if (DTMF_ValidateCodes((char *)Data, 16)) {
 		memcpy(gEeprom.DTMF_DOWN_CODE, Data, 16);
 	} else {
@@ -660,7 +687,7 @@ void BOARD_EEPROM_Init(void)
 	}
 
 	// 0F18..0F1F
-	EEPROM_ReadBuffer(0x0F18, Data, 8);
+	Data = SETTING(0x0F18);
 
 	gEeprom.SCAN_LIST_DEFAULT = (Data[0] < 2) ? Data[0] : false;
 
@@ -671,8 +698,11 @@ void BOARD_EEPROM_Init(void)
 		gEeprom.SCANLIST_PRIORITY_CH2[i] = Data[j + 2];
 	}
 
+	Base = 0x0F30;
+	EEPROM_ReadBuffer(Base, Settings, 0x0F48 - Base);
+
 	// 0F40..0F47
-	EEPROM_ReadBuffer(0x0F40, Data, 8);
+	Data = SETTING(0x0F40);
 	gSetting_F_LOCK         = (Data[0] < 6) ? Data[0] : F_LOCK_OFF;
 
 	gUpperLimitFrequencyBandTable = UpperLimitFrequencyBandTable;
@@ -692,9 +722,10 @@ void BOARD_EEPROM_Init(void)
 
 	// 0D60..0E27
 	EEPROM_ReadBuffer(0x0D60, gMR_ChannelAttributes, sizeof(gMR_ChannelAttributes));
+	RADIO_InitChannelMaps();
 
 	// 0F30..0F3F
-	EEPROM_ReadBuffer(0x0F30, gCustomAesKey, sizeof(gCustomAesKey));
+	memcpy(gCustomAesKey, SETTING(0x0F30), sizeof(gCustomAesKey));
 
 	for (i = 0; i < 4; i++) {
 		if (gCustomAesKey[i] != 0xFFFFFFFFU) {
@@ -708,14 +739,18 @@ void BOARD_EEPROM_Init(void)
 
 void BOARD_EEPROM_LoadCalibration(void)
 {
+	uint8_t Rssi[16];
 	uint8_t Mic;
 
-	EEPROM_ReadBuffer(0x1EC0, gEEPROM_RSSI_CALIB[3], 8);
+	// The rest of the calibration is read field by field, as the unused
+	// bytes between the fields take longer to clock in than a new address.
+	EEPROM_ReadBuffer(0x1EC0, Rssi, sizeof(Rssi));
+	memcpy(gEEPROM_RSSI_CALIB[3], Rssi, 8);
 	memcpy(gEEPROM_RSSI_CALIB[4], gEEPROM_RSSI_CALIB[3], 8);
 	memcpy(gEEPROM_RSSI_CALIB[5], gEEPROM_RSSI_CALIB[3], 8);
 	memcpy(gEEPROM_RSSI_CALIB[6], gEEPROM_RSSI_CALIB[3], 8);
 
-	EEPROM_ReadBuffer(0x1EC8, gEEPROM_RSSI_CALIB[0], 8);
+	memcpy(gEEPROM_RSSI_CALIB[0], Rssi + 8, 8);
 	memcpy(gEEPROM_RSSI_CALIB[1], gEEPROM_RSSI_CALIB[0], 8);
 	memcpy(gEEPROM_RSSI_CALIB[2], gEEPROM_RSSI_CALIB[0], 8);
 
@@ -757,6 +792,10 @@ void BOARD_FactoryReset(bool bIsAll)
 	uint8_t Template[8];
 	uint16_t i;
 
+#if defined(ENABLE_EEPROM_JOURNAL)
+	JOURNAL_Compact();
+#endif
+
 	memset(Template, 0xFF, sizeof(Template));
 	for (i = 0x0C80; i < 0x1E00; i += 8) {
 		if (
@@ -765,6 +804,9 @@ void BOARD_FactoryReset(bool bIsAll)
 			!(i >= 0x1C00 && i < 0x1E00) && // DTMF contacts
 			!(i >= 0x0EB0 && i < 0x0ED0) && // Welcome strings
 			!(i >= 0x0EA0 && i < 0x0EA8) && // Voice Prompt
+#if defined(ENABLE_EEPROM_INTEGRITY)
+			!(i >= INTEGRITY_EEPROM && i < INTEGRITY_EEPROM + INTEGRITY_SIZE) && // Region checksums
+#endif
 			(bIsAll || (
 				!(i >= 0x0D60 && i < 0x0E28) && // MR Channel Attributes
 				!(i >= 0x0F18 && i < 0x0F30) && // Scan List
@@ -775,5 +817,8 @@ void BOARD_FactoryReset(bool bIsAll)
 			EEPROM_WriteBuffer(i, Template);
 		}
 	}
+#if defined(ENABLE_CHANNEL_CACHE)
+	RADIO_InvalidateChannels();
+#endif
 }
 
@@ -0,0 +1,49 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// Generated by tools/dcs-table.py from dcs.c, do not edit.
+
+#include "dcs.h"
+
+const uint16_t DCS_Parity[104] = {
+	0x763, 0x6B7, 0x65D, 0x51F,
+	0x5F5, 0x0BE, 0x5B6, 0x0FD,
+	0x7CA, 0x355, 0x6F4, 0x5D1,
+	0x679, 0x693, 0x2E6, 0x747,
+	0x35E, 0x72B, 0x7C1, 0x5DA,
+	0x07B, 0x3D3, 0x339, 0x2ED,
+	0x37A, 0x2AE, 0x1EC, 0x44D,
+	0x4A7, 0x6BC, 0x31D, 0x05F,
+	0x18B, 0x6E9, 0x5AB, 0x68E,
+	0x75A, 0x7B0, 0x45B, 0x1FA,
+	0x58F, 0x565, 0x627, 0x6CD,
+	0x36C, 0x177, 0x5E8, 0x43C,
+	0x4D6, 0x794, 0x6AA, 0x0CF,
+	0x38D, 0x6C6, 0x196, 0x23E,
+	0x2D4, 0x297, 0x3A9, 0x0EB,
+	0x54A, 0x685, 0x2F0, 0x158,
+	0x776, 0x79C, 0x3E9, 0x4B9,
+	0x6C5, 0x62F, 0x7B8, 0x752,
+	0x4FA, 0x52E, 0x15B, 0x3AA,
+	0x27E, 0x60B, 0x6E1, 0x3C6,
+	0x2F8, 0x41B, 0x275, 0x34B,
+	0x0E3, 0x19E, 0x0C7, 0x5D9,
+	0x671, 0x0F5, 0x01F, 0x728,
+	0x7C2, 0x4C3, 0x247, 0x393,
+	0x22B, 0x0BD, 0x398, 0x1E4,
+	0x10E, 0x0DA, 0x14D, 0x20F,
+};
+
@@ -63,26 +63,11 @@ const uint16_t DCS_Options[104] = {
 	0x01DA, 0x01DC, 0x01E3, 0x01EC,
 };
 
-static uint32_t DCS_CalculateGolay(uint32_t CodeWord)
-{
-	uint32_t Word;
-	uint8_t i;
-
-	Word = CodeWord;
-	for (i = 0; i < 12; i++) {
-		Word <<= 1;
-		if (Word & 0x1000) {
-			Word ^= 0x08EA;
-		}
-	}
-	return CodeWord | ((Word & 0x0FFE) << 11);
-}
-
 uint32_t DCS_GetGolayCodeWord(DCS_CodeType_t CodeType, uint8_t Option)
 {
 	uint32_t Code;
 
-	Code = DCS_CalculateGolay(DCS_Options[Option] + 0x800U);
+	Code = (DCS_Options[Option] + 0x800U) | ((uint32_t)DCS_Parity[Option] << 12);
 	if (CodeType == CODE_TYPE_REVERSE_DIGITAL) {
 		Code ^= 0x7FFFFF;
 	}
@@ -90,6 +75,29 @@ uint32_t DCS_GetGolayCodeWord(DCS_CodeType_t CodeType, uint8_t Option)
 	return Code;
 }
 
+// DCS_Options is sorted, so the 9 data bits of a rotation are looked up by
+// binary search and only the one candidate's parity is compared.
+static uint8_t FindOption(uint16_t Data)
+{
+	uint8_t Low = 0;
+	uint8_t High = ARRAY_SIZE(DCS_Options);
+
+	while (Low < High) {
+		const uint8_t Middle = (Low + High) / 2;
+
+		if (DCS_Options[Middle] < Data) {
+			Low = Middle + 1;
+		} else {
+			High = Middle;
+		}
+	}
+	if (Low < ARRAY_SIZE(DCS_Options) && DCS_Options[Low] == Data) {
+		return Low;
+	}
+
+	return 0xFF;
+}
+
 uint8_t DCS_GetCdcssCode(uint32_t Code)
 {
 	uint8_t i;
@@ -98,14 +106,10 @@ uint8_t DCS_GetCdcssCode(uint32_t Code)
 		uint32_t Shift;
 
 		if (((Code >> 9) & 0x7U) == 4) {
-			uint8_t j;
-
-			for (j = 0; j < ARRAY_SIZE(DCS_Options); j++) {
-				if (DCS_Options[j] == (Code & 0x1FF)) {
-					if (DCS_GetGolayCodeWord(2, j) == Code) {
-						return j;
-					}
-				}
+			const uint8_t j = FindOption(Code & 0x1FF);
+
+			if (j != 0xFF && DCS_Parity[j] == (Code >> 12)) {
+				return j;
 			}
 		}
 		Shift = Code >> 1;
@@ -118,26 +122,55 @@ uint8_t DCS_GetCdcssCode(uint32_t Code)
 	return 0xFF;
 }
 
-uint8_t DCS_GetCtcssCode(uint16_t Code)
+// Finds the tone nearest to Frequency, in 0.1 Hz, by binary search over the
+// sorted CTCSS_Options. The match is rejected beyond CTCSS_TOLERANCE. It is
+// confident up to CTCSS_AMBIGUITY short of halfway to the next tone on the
+// same side, or up to CTCSS_TOLERANCE past either end of the table.
+uint8_t DCS_GetCtcssCode(uint16_t Frequency, DCS_Confidence_t *pConfidence)
 {
-	uint8_t i;
-	int Smallest;
-	uint8_t Result = 0xFF;
+	uint8_t Low = 0;
+	uint8_t High = ARRAY_SIZE(CTCSS_Options);
+	uint8_t Index;
+	uint16_t Delta;
+	uint16_t Window;
+
+	while (Low < High) {
+		const uint8_t Middle = (Low + High) / 2;
+
+		if (CTCSS_Options[Middle] < Frequency) {
+			Low = Middle + 1;
+		} else {
+			High = Middle;
+		}
+	}
 
-	Smallest = ARRAY_SIZE(CTCSS_Options);
-	for (i = 0; i < ARRAY_SIZE(CTCSS_Options); i++) {
-		int Delta;
+	// Halfway between two tones the lower one wins.
+	if (Low == ARRAY_SIZE(CTCSS_Options) || (Low > 0 && Frequency - CTCSS_Options[Low - 1] <= CTCSS_Options[Low] - Frequency)) {
+		Index = Low - 1;
+	} else {
+		Index = Low;
+	}
 
-		Delta = Code - CTCSS_Options[i];
-		if (Delta < 0) {
-			Delta = -(Code - CTCSS_Options[i]);
+	Window = CTCSS_TOLERANCE;
+	if (Frequency >= CTCSS_Options[Index]) {
+		Delta = Frequency - CTCSS_Options[Index];
+		if (Index + 1 < ARRAY_SIZE(CTCSS_Options)) {
+			Window = (CTCSS_Options[Index + 1] - CTCSS_Options[Index]) / 2 - CTCSS_AMBIGUITY;
 		}
-		if (Delta < Smallest) {
-			Smallest = Delta;
-			Result = i;
+	} else {
+		Delta = CTCSS_Options[Index] - Frequency;
+		if (Index > 0) {
+			Window = (CTCSS_Options[Index] - CTCSS_Options[Index - 1]) / 2 - CTCSS_AMBIGUITY;
 		}
 	}
 
-	return Result;
+	if (Delta > CTCSS_TOLERANCE) {
+		*pConfidence = DCS_CONFIDENCE_NONE;
+		return 0xFF;
+	}
+
+	*pConfidence = (Delta <= Window) ? DCS_CONFIDENCE_HIGH : DCS_CONFIDENCE_LOW;
+
+	return Index;
 }
 
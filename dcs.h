@@ -28,6 +28,21 @@ enum DCS_CodeType_t {
 
 typedef enum DCS_CodeType_t DCS_CodeType_t;
 
+enum DCS_Confidence_t {
+	DCS_CONFIDENCE_NONE = 0x00U,
+	DCS_CONFIDENCE_LOW  = 0x01U,
+	DCS_CONFIDENCE_HIGH = 0x02U,
+};
+
+typedef enum DCS_Confidence_t DCS_Confidence_t;
+
+// How far, in 0.1 Hz, a measured tone may be from the nominal one.
+#define CTCSS_TOLERANCE 49U
+// Half the width, in 0.1 Hz, of the band around each midpoint between two
+// tones where a reading is only a LOW confidence match. The closest tones,
+// 67.0 and 69.3 Hz, still keep +-0.8 Hz each and stay 0.6 Hz apart.
+#define CTCSS_AMBIGUITY 3U
+
 enum {
 	CDCSS_POSITIVE_CODE = 1U,
 	CDCSS_NEGATIVE_CODE = 2U,
@@ -35,10 +50,11 @@ enum {
 
 extern const uint16_t CTCSS_Options[50];
 extern const uint16_t DCS_Options[104];
+extern const uint16_t DCS_Parity[104];
 
 uint32_t DCS_GetGolayCodeWord(DCS_CodeType_t CodeType, uint8_t Option);
 uint8_t DCS_GetCdcssCode(uint32_t Code);
-uint8_t DCS_GetCtcssCode(uint16_t Code);
+uint8_t DCS_GetCtcssCode(uint16_t Frequency, DCS_Confidence_t *pConfidence);
 
 #endif
 
@@ -324,6 +324,15 @@ void BK4819_SetFrequency(uint32_t Frequency)
 	BK4819_WriteRegister(BK4819_REG_39, (Frequency >> 16) & 0xFFFF);
 }
 
+// Retunes an already running receiver. Only the frequency registers are
+// written; cycling REG_30 restarts VCO calibration and PLL lock.
+void BK4819_TuneQuick(uint32_t Frequency)
+{
+	BK4819_SetFrequency(Frequency);
+	BK4819_WriteRegister(BK4819_REG_30, 0);
+	BK4819_WriteRegister(BK4819_REG_30, 0xBFF1);
+}
+
 void BK4819_SetupSquelch(uint8_t SquelchOpenRSSIThresh, uint8_t SquelchCloseRSSIThresh, uint8_t SquelchOpenNoiseThresh, uint8_t SquelchCloseNoiseThresh, uint8_t SquelchCloseGlitchThresh, uint8_t SquelchOpenGlitchThresh)
 {
 	BK4819_WriteRegister(BK4819_REG_70, 0);
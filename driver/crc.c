@@ -31,20 +31,45 @@ void CRC_Init(void)
 	CRC_IV = 0;
 }
 
-uint16_t CRC_Calculate(const void *pBuffer, uint16_t Size)
+// Starts a CRC that CRC_Update and CRC_UpdateZeros feed in pieces, for data
+// that is not in RAM all at once. Nothing else may use the CRC unit until
+// CRC_Finish.
+void CRC_Start(void)
 {
-	const uint8_t *pData = (const uint8_t *)pBuffer;
-	uint16_t i, Crc;
-
 	CRC_CR = (CRC_CR & ~CRC_CR_CRC_EN_MASK) | CRC_CR_CRC_EN_BITS_ENABLE;
+}
+
+void CRC_Update(const void *pBuffer, uint16_t Size)
+{
+	const uint8_t *pData = (const uint8_t *)pBuffer;
+	uint16_t i;
 
 	for (i = 0; i < Size; i++) {
 		CRC_DATAIN = pData[i];
 	}
-	Crc = (uint16_t)CRC_DATAOUT;
+}
+
+void CRC_UpdateZeros(uint16_t Size)
+{
+	while (Size--) {
+		CRC_DATAIN = 0;
+	}
+}
+
+uint16_t CRC_Finish(void)
+{
+	const uint16_t Crc = (uint16_t)CRC_DATAOUT;
 
 	CRC_CR = (CRC_CR & ~CRC_CR_CRC_EN_MASK) | CRC_CR_CRC_EN_BITS_DISABLE;
 
 	return Crc;
 }
 
+uint16_t CRC_Calculate(const void *pBuffer, uint16_t Size)
+{
+	CRC_Start();
+	CRC_Update(pBuffer, Size);
+
+	return CRC_Finish();
+}
+
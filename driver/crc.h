@@ -21,6 +21,10 @@
 
 void CRC_Init(void);
 uint16_t CRC_Calculate(const void *pBuffer, uint16_t Size);
+void CRC_Start(void);
+void CRC_Update(const void *pBuffer, uint16_t Size);
+void CRC_UpdateZeros(uint16_t Size);
+uint16_t CRC_Finish(void);
 
 #endif
 
@@ -14,9 +14,63 @@
  *     limitations under the License.
  */
 
+#include <string.h>
 #include "driver/eeprom.h"
 #include "driver/i2c.h"
-#include "driver/system.h"
+#include "driver/systick.h"
+#if defined(ENABLE_EEPROM_INTEGRITY)
+#include "integrity.h"
+#endif
+#if defined(ENABLE_EEPROM_JOURNAL)
+#include "journal.h"
+#endif
+
+#if defined(ENABLE_EEPROM_CACHE)
+#define CACHE_LINES 8U
+#define LINE_SIZE 8U
+
+typedef struct {
+	uint16_t Address;
+	// When the line became dirty. Writes coalescing into it keep this, so
+	// the line that has waited longest is always written first.
+	uint16_t Sequence;
+	uint8_t Data[LINE_SIZE];
+} CacheLine_t;
+
+static CacheLine_t gCache[CACHE_LINES];
+static uint8_t gDirtyLines;
+static uint16_t gSequence;
+
+uint16_t gEepromCoalescedWrites;
+uint16_t gEepromPageWrites;
+
+// Copies the bytes that the dirty lines and the buffer have in common, from
+// the lines into the buffer or, with bToCache, the other way round.
+static void Overlay(uint16_t Address, uint8_t *pData, uint16_t Size, bool bToCache)
+{
+	uint8_t i;
+
+	for (i = 0; i < CACHE_LINES; i++) {
+		CacheLine_t *pLine = &gCache[i];
+		uint16_t Start;
+		uint16_t End;
+
+		if ((gDirtyLines & (1U << i)) == 0) {
+			continue;
+		}
+		Start = (pLine->Address > Address) ? pLine->Address : Address;
+		End = (pLine->Address + LINE_SIZE < Address + Size) ? pLine->Address + LINE_SIZE : Address + Size;
+		if (Start >= End) {
+			continue;
+		}
+		if (bToCache) {
+			memcpy(pLine->Data + (Start - pLine->Address), pData + (Start - Address), End - Start);
+		} else {
+			memcpy(pData + (Start - Address), pLine->Data + (Start - pLine->Address), End - Start);
+		}
+	}
+}
+#endif
 
 void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size)
 {
@@ -34,10 +88,36 @@ void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size)
 	I2C_ReadBuffer(pBuffer, Size);
 
 	I2C_Stop();
+
+#if defined(ENABLE_EEPROM_CACHE)
+	Overlay(Address, pBuffer, Size, false);
+#endif
+#if defined(ENABLE_EEPROM_JOURNAL)
+	JOURNAL_Overlay(Address, pBuffer, Size);
+#endif
 }
 
-void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer)
+// The EEPROM does not acknowledge its address until the internal write
+// cycle has finished, which usually takes well under the 10 ms it is rated
+// for. Polling gives up after about 15 ms.
+static void WaitForWrite(void)
+{
+	uint8_t i;
 
+	for (i = 0; i < 100; i++) {
+		int Ack;
+
+		SYSTICK_DelayUs(100);
+		I2C_Start();
+		Ack = I2C_Write(0xA0);
+		I2C_Stop();
+		if (Ack == 0) {
+			break;
+		}
+	}
+}
+
+static void WritePage(uint16_t Address, const uint8_t *pData, uint8_t Size)
 {
 	I2C_Start();
 
@@ -46,10 +126,191 @@ void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer)
 	I2C_Write((Address >> 8) & 0xFF);
 	I2C_Write((Address >> 0) & 0xFF);
 
-	I2C_WriteBuffer(pBuffer, 8);
+	I2C_WriteBuffer(pData, Size);
 
 	I2C_Stop();
 
-	SYSTEM_DelayMs(10);
+	WaitForWrite();
+
+#if defined(ENABLE_EEPROM_CACHE)
+	gEepromPageWrites++;
+#endif
+}
+
+// Splits the write at page boundaries, as a page write wraps around within
+// its page instead of carrying on into the next one.
+static void WritePages(uint16_t Address, const uint8_t *pData, uint16_t Size)
+{
+	while (Size) {
+		uint16_t Chunk;
+
+		Chunk = EEPROM_PAGE_SIZE - (Address % EEPROM_PAGE_SIZE);
+		if (Chunk > Size) {
+			Chunk = Size;
+		}
+		WritePage(Address, pData, Chunk);
+		Address += Chunk;
+		pData += Chunk;
+		Size -= Chunk;
+	}
+}
+
+#if defined(ENABLE_EEPROM_CACHE)
+// Writes every dirty line in the same page as Line, in as few page writes
+// as the gaps between them allow.
+static void FlushPage(uint8_t Line)
+{
+	const uint16_t Page = gCache[Line].Address & ~(EEPROM_PAGE_SIZE - 1);
+	uint8_t Buffer[EEPROM_PAGE_SIZE];
+	uint8_t Slots = 0;
+	uint8_t Start;
+	uint8_t i;
+
+	for (i = 0; i < CACHE_LINES; i++) {
+		const CacheLine_t *pLine = &gCache[i];
+		uint8_t Slot;
+
+		if ((gDirtyLines & (1U << i)) == 0 || (pLine->Address & ~(EEPROM_PAGE_SIZE - 1)) != Page) {
+			continue;
+		}
+		Slot = (pLine->Address - Page) / LINE_SIZE;
+		memcpy(Buffer + (Slot * LINE_SIZE), pLine->Data, LINE_SIZE);
+		Slots |= 1U << Slot;
+		gDirtyLines &= ~(1U << i);
+	}
+
+	Start = 0;
+	for (i = 0; i <= EEPROM_PAGE_SIZE / LINE_SIZE; i++) {
+		if (i < EEPROM_PAGE_SIZE / LINE_SIZE && (Slots & (1U << i))) {
+			continue;
+		}
+		if (i > Start) {
+			WritePages(Page + (Start * LINE_SIZE), Buffer + (Start * LINE_SIZE), (i - Start) * LINE_SIZE);
+		}
+		Start = i + 1;
+	}
+}
+
+static uint8_t FindOldest(void)
+{
+	uint8_t Oldest = CACHE_LINES;
+	uint8_t i;
+
+	for (i = 0; i < CACHE_LINES; i++) {
+		if ((gDirtyLines & (1U << i)) == 0) {
+			continue;
+		}
+		if (Oldest == CACHE_LINES || (int16_t)(gCache[i].Sequence - gCache[Oldest].Sequence) < 0) {
+			Oldest = i;
+		}
+	}
+
+	return Oldest;
+}
+
+static void Store(uint16_t Address, const uint8_t *pData)
+{
+	uint8_t i;
+
+	for (i = 0; i < CACHE_LINES; i++) {
+		if ((gDirtyLines & (1U << i)) && gCache[i].Address == Address) {
+			memcpy(gCache[i].Data, pData, LINE_SIZE);
+			gEepromCoalescedWrites++;
+			return;
+		}
+	}
+
+	if (gDirtyLines == (1U << CACHE_LINES) - 1) {
+		FlushPage(FindOldest());
+	}
+	i = 0;
+	while (gDirtyLines & (1U << i)) {
+		i++;
+	}
+	gCache[i].Address = Address;
+	gCache[i].Sequence = gSequence++;
+	memcpy(gCache[i].Data, pData, LINE_SIZE);
+	gDirtyLines |= 1U << i;
+}
+
+// Keeps the write in RAM until EEPROM_FlushPage or EEPROM_Flush, replacing
+// any earlier write to the same line. Unaligned writes go straight out.
+void EEPROM_WriteCached(uint16_t Address, const void *pBuffer, uint16_t Size)
+{
+	const uint8_t *pData = (const uint8_t *)pBuffer;
+
+	if ((Address | Size) & (LINE_SIZE - 1)) {
+		EEPROM_WritePages(Address, pBuffer, Size);
+		return;
+	}
+#if defined(ENABLE_EEPROM_INTEGRITY)
+	INTEGRITY_Update(Address, pBuffer, Size);
+#endif
+	for (; Size; Size -= LINE_SIZE) {
+		Store(Address, pData);
+		Address += LINE_SIZE;
+		pData += LINE_SIZE;
+	}
+}
+
+// Writes out the page of the line that has been dirty longest, so pages
+// reach the EEPROM in the order they were first written.
+bool EEPROM_FlushPage(void)
+{
+	if (gDirtyLines) {
+		FlushPage(FindOldest());
+	}
+#if defined(ENABLE_EEPROM_INTEGRITY)
+	// The checksums follow once everything they cover is out.
+	if (gDirtyLines == 0) {
+		INTEGRITY_Flush();
+	}
+#endif
+
+	return gDirtyLines != 0;
+}
+
+void EEPROM_Flush(void)
+{
+	while (EEPROM_FlushPage()) {
+	}
+}
+#else
+void EEPROM_WriteCached(uint16_t Address, const void *pBuffer, uint16_t Size)
+{
+	EEPROM_WritePages(Address, pBuffer, Size);
+}
+
+bool EEPROM_FlushPage(void)
+{
+#if defined(ENABLE_EEPROM_INTEGRITY)
+	INTEGRITY_Flush();
+#endif
+
+	return false;
+}
+
+void EEPROM_Flush(void)
+{
+	EEPROM_FlushPage();
+}
+#endif
+
+// Goes out immediately; cached lines it overlaps take its data so that they
+// do not put older bytes back later.
+void EEPROM_WritePages(uint16_t Address, const void *pBuffer, uint16_t Size)
+{
+#if defined(ENABLE_EEPROM_INTEGRITY)
+	INTEGRITY_Update(Address, pBuffer, Size);
+#endif
+#if defined(ENABLE_EEPROM_CACHE)
+	Overlay(Address, (uint8_t *)pBuffer, Size, true);
+#endif
+	WritePages(Address, pBuffer, Size);
+}
+
+void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer)
+{
+	EEPROM_WriteCached(Address, pBuffer, 8);
 }
 
@@ -17,10 +17,25 @@
 #ifndef DRIVER_EEPROM_H
 #define DRIVER_EEPROM_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
+// Page size of the 24C64 and larger parts.
+#if !defined(EEPROM_PAGE_SIZE)
+#define EEPROM_PAGE_SIZE 32U
+#endif
+
 void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size);
 void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer);
+void EEPROM_WritePages(uint16_t Address, const void *pBuffer, uint16_t Size);
+void EEPROM_WriteCached(uint16_t Address, const void *pBuffer, uint16_t Size);
+bool EEPROM_FlushPage(void);
+void EEPROM_Flush(void);
+
+#if defined(ENABLE_EEPROM_CACHE)
+extern uint16_t gEepromCoalescedWrites;
+extern uint16_t gEepromPageWrites;
+#endif
 
 #endif
 
@@ -14,12 +14,187 @@
  *     limitations under the License.
  */
 
+#if defined(ENABLE_I2C_FAST)
+#include "ARMCM0.h"
+#endif
 #include "bsp/dp32g030/gpio.h"
 #include "bsp/dp32g030/portcon.h"
 #include "driver/gpio.h"
 #include "driver/i2c.h"
+#if defined(ENABLE_I2C_FAST)
+#include "driver/i2c-pins.h"
+#endif
 #include "driver/systick.h"
 
+#if defined(ENABLE_I2C_FAST)
+// Fast mode asks for SCL low at least 1.3 us and high at least 0.6 us, at
+// no more than 400 kHz. Both phases get some margin on top.
+#define LOW_NS			1500U
+#define HIGH_NS			1000U
+#define CYCLES_PER_US		48U
+#define CALIBRATION_LOOPS	1024U
+#define CALIBRATION_RUNS	4U
+
+// Until I2C_Calibrate runs, assume the loop takes a single cycle.
+static uint32_t gLowLoops = (LOW_NS * CYCLES_PER_US) / 1000U;
+static uint32_t gHighLoops = (HIGH_NS * CYCLES_PER_US) / 1000U;
+
+static void Spin(uint32_t Loops)
+{
+	while (Loops--) {
+		__NOP();
+	}
+}
+
+static uint32_t LoopsFor(uint32_t Nanoseconds, uint32_t Ticks)
+{
+	const uint32_t Loops = ((Nanoseconds * CYCLES_PER_US * CALIBRATION_LOOPS) + (1000U * Ticks) - 1U) / (1000U * Ticks);
+
+	return Loops ? Loops : 1U;
+}
+
+static void SetSdaInput(void)
+{
+	PORTCON_PORTA_IE |= PORTCON_PORTA_IE_A11_BITS_ENABLE;
+	PORTCON_PORTA_OD &= ~PORTCON_PORTA_OD_A11_MASK;
+	GPIOA->DIR &= ~GPIO_DIR_11_MASK;
+}
+
+static void SetSdaOutput(void)
+{
+	PORTCON_PORTA_IE &= ~PORTCON_PORTA_IE_A11_MASK;
+	PORTCON_PORTA_OD |= PORTCON_PORTA_OD_A11_BITS_ENABLE;
+	GPIOA->DIR |= GPIO_DIR_11_BITS_OUTPUT;
+}
+
+// Times the delay loop against SysTick, which runs at the core clock, so
+// that the SCL phases hold whatever the compiler and the flash wait states
+// make of the loop. Interrupts can only make a run look slower, so the
+// fastest run is the one kept. If SysTick never moved, the slower single
+// cycle guess stays.
+void I2C_Calibrate(void)
+{
+	uint32_t Best = 0xFFFFFFFFU;
+	uint8_t i;
+
+	for (i = 0; i < CALIBRATION_RUNS; i++) {
+		uint32_t Start;
+		uint32_t End;
+		uint32_t Ticks;
+
+		Start = SysTick->VAL;
+		Spin(CALIBRATION_LOOPS);
+		End = SysTick->VAL;
+		if (End <= Start) {
+			Ticks = Start - End;
+		} else {
+			Ticks = Start + SysTick->LOAD + 1U - End;
+		}
+		if (Ticks && Ticks < Best) {
+			Best = Ticks;
+		}
+	}
+
+	if (Best == 0xFFFFFFFFU) {
+		return;
+	}
+
+	gLowLoops = LoopsFor(LOW_NS, Best);
+	gHighLoops = LoopsFor(HIGH_NS, Best);
+}
+
+void I2C_Start(void)
+{
+	I2C_SdaHigh();
+	Spin(gHighLoops);
+	I2C_SclHigh();
+	Spin(gHighLoops);
+	I2C_SdaLow();
+	Spin(gHighLoops);
+	I2C_SclLow();
+	Spin(gLowLoops);
+}
+
+void I2C_Stop(void)
+{
+	I2C_SdaLow();
+	I2C_SclLow();
+	Spin(gLowLoops);
+	I2C_SclHigh();
+	Spin(gHighLoops);
+	I2C_SdaHigh();
+	Spin(gLowLoops);
+}
+
+uint8_t I2C_Read(bool bFinal)
+{
+	uint8_t i, Data;
+
+	SetSdaInput();
+
+	Data = 0;
+	for (i = 0; i < 8; i++) {
+		I2C_SclLow();
+		Spin(gLowLoops);
+		I2C_SclHigh();
+		Spin(gHighLoops);
+		Data = (Data << 1) | I2C_SdaRead();
+	}
+
+	I2C_SclLow();
+	SetSdaOutput();
+	if (bFinal) {
+		I2C_SdaHigh();
+	} else {
+		I2C_SdaLow();
+	}
+	Spin(gLowLoops);
+	I2C_SclHigh();
+	Spin(gHighLoops);
+	I2C_SclLow();
+
+	return Data;
+}
+
+int I2C_Write(uint8_t Data)
+{
+	uint8_t i;
+	int ret = -1;
+
+	I2C_SclLow();
+	for (i = 0; i < 8; i++) {
+		if ((Data & 0x80) == 0) {
+			I2C_SdaLow();
+		} else {
+			I2C_SdaHigh();
+		}
+		Data <<= 1;
+		Spin(gLowLoops);
+		I2C_SclHigh();
+		Spin(gHighLoops);
+		I2C_SclLow();
+	}
+
+	SetSdaInput();
+	I2C_SdaHigh();
+	Spin(gLowLoops);
+	I2C_SclHigh();
+	Spin(gHighLoops);
+
+	for (i = 0; i < 255; i++) {
+		if (I2C_SdaRead() == 0) {
+			ret = 0;
+			break;
+		}
+	}
+
+	I2C_SclLow();
+	SetSdaOutput();
+	I2C_SdaHigh();
+
+	return ret;
+}
+#else
 void I2C_Start(void)
 {
 	GPIO_SetBit(&GPIOA->DATA, GPIOA_PIN_I2C_SDA);
@@ -131,6 +306,7 @@ int I2C_Write(uint8_t Data)
 
 	return ret;
 }
+#endif
 
 int I2C_ReadBuffer(void *pBuffer, uint8_t Size)
 {
@@ -143,11 +319,15 @@ int I2C_ReadBuffer(void *pBuffer, uint8_t Size)
 	}
 
 	for (i = 0; i < Size - 1; i++) {
+#if !defined(ENABLE_I2C_FAST)
 		SYSTICK_DelayUs(1);
+#endif
 		pData[i] = I2C_Read(false);
 	}
 
+#if !defined(ENABLE_I2C_FAST)
 	SYSTICK_DelayUs(1);
+#endif
 	pData[i++] = I2C_Read(true);
 
 	return Size;
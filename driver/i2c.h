@@ -25,6 +25,9 @@ enum {
 	I2C_READ = 1U,
 };
 
+#if defined(ENABLE_I2C_FAST)
+void I2C_Calibrate(void);
+#endif
 void I2C_Start(void);
 void I2C_Stop(void);
 
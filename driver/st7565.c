@@ -15,7 +15,15 @@
  */
 
 #include <stdint.h>
+#include <string.h>
+#if defined(ENABLE_DISPLAY_DMA)
+#include "ARMCM0.h"
+#include "bsp/dp32g030/dma.h"
+#endif
 #include "bsp/dp32g030/gpio.h"
+#if defined(ENABLE_DISPLAY_DMA)
+#include "bsp/dp32g030/irq.h"
+#endif
 #include "bsp/dp32g030/spi.h"
 #include "driver/gpio.h"
 #include "driver/spi.h"
@@ -25,11 +33,66 @@
 
 uint8_t gStatusLine[128];
 uint8_t gFrameBuffer[7][128];
+uint16_t gDisplayBytesSent;
+volatile bool gDisplayBusy;
+
+// Columns written into gFrameBuffer since the last blit, and columns that
+// currently hold content on the glass. An empty span has End == 0.
+static ST7565_Span_t gDrawnSpans[7];
+static ST7565_Span_t gShownSpans[7];
+static ST7565_Span_t gPendingSpans[7];
+
+#if defined(ENABLE_DISPLAY_DOUBLE_BUFFER)
+// Copy of what is on the glass. The UI keeps drawing into gFrameBuffer
+// while this one is being sent out.
+static uint8_t gFrontBuffer[7][128];
+#define BLIT_BUFFER gFrontBuffer
+#else
+#define BLIT_BUFFER gFrameBuffer
+#endif
+
+#if defined(ENABLE_DISPLAY_DMA)
+// SPI0 TX handshake line for the DMA destination, CH0 is taken by UART1 RX.
+// This is a guess that has not been checked on hardware.
+#define ST7565_DMA_HSREQ DMA_CH_MOD_MD_SEL_BITS_HSREQ_MS0
+
+static uint8_t gDmaLine;
+static volatile bool gDmaLineDone;
+
+void HandlerDMA(void);
+#endif
+
+static void ExtendSpan(ST7565_Span_t *pSpan, uint8_t Start, uint8_t End)
+{
+	if (pSpan->End == 0) {
+		pSpan->Start = Start;
+		pSpan->End = End;
+		return;
+	}
+	if (Start < pSpan->Start) {
+		pSpan->Start = Start;
+	}
+	if (End > pSpan->End) {
+		pSpan->End = End;
+	}
+}
+
+static void MarkAllShown(void)
+{
+	uint8_t Line;
+
+	for (Line = 0; Line < ARRAY_SIZE(gShownSpans); Line++) {
+		gDrawnSpans[Line].End = 0;
+		gShownSpans[Line].Start = 0;
+		gShownSpans[Line].End = ARRAY_SIZE(gFrameBuffer[0]);
+	}
+}
 
 void ST7565_DrawLine(uint8_t Column, uint8_t Line, uint16_t Size, const uint8_t *pBitmap, bool bIsClearMode)
 {
 	uint16_t i;
 
+	ST7565_WaitForBlit();
 	SPI_ToggleMasterMode(&SPI0->CR, false);
 	ST7565_SelectColumnAndLine(Column + 4U, Line);
 	GPIO_SetBit(&GPIOB->DATA, GPIOB_PIN_ST7565_A0);
@@ -50,35 +113,242 @@ void ST7565_DrawLine(uint8_t Column, uint8_t Line, uint16_t Size, const uint8_t
 
 	SPI_WaitForUndocumentedTxFifoStatusBit();
 	SPI_ToggleMasterMode(&SPI0->CR, true);
+
+	if (Line && !bIsClearMode) {
+		ExtendSpan(&gShownSpans[Line - 1], Column, Column + Size);
+	}
+#if defined(ENABLE_DISPLAY_DOUBLE_BUFFER)
+	if (Line && Column + Size <= ARRAY_SIZE(gFrontBuffer[0])) {
+		if (bIsClearMode) {
+			memset(&gFrontBuffer[Line - 1][Column], 0, Size);
+		} else {
+			memcpy(&gFrontBuffer[Line - 1][Column], pBitmap, Size);
+		}
+	}
+#endif
 }
 
-void ST7565_BlitFullScreen(void)
+#if defined(ENABLE_DISPLAY_DMA)
+static bool StartNextLineDma(void)
+{
+	while (gDmaLine < ARRAY_SIZE(gPendingSpans)) {
+		const uint8_t Line = gDmaLine++;
+		const ST7565_Span_t Span = gPendingSpans[Line];
+
+		if (Span.End == 0) {
+			continue;
+		}
+
+		// Page and column commands go out by hand with A0 low, the page
+		// data itself is fed to the FIFO by the DMA.
+		SPI0->CR = (SPI0->CR & ~SPI_CR_TXDMAEN_MASK);
+		ST7565_SelectColumnAndLine(Span.Start + 4U, Line + 1U);
+		GPIO_SetBit(&GPIOB->DATA, GPIOB_PIN_ST7565_A0);
+
+		DMA_CH1->MSADDR = (uint32_t)(uintptr_t)&BLIT_BUFFER[Line][Span.Start];
+		DMA_CH1->MDADDR = (uint32_t)(uintptr_t)&SPI0->WDR;
+		DMA_CH1->MOD = 0
+			// Source
+			| DMA_CH_MOD_MS_ADDMOD_BITS_INCREMENT
+			| DMA_CH_MOD_MS_SIZE_BITS_8BIT
+			| DMA_CH_MOD_MS_SEL_BITS_SRAM
+			// Destination
+			| DMA_CH_MOD_MD_ADDMOD_BITS_NONE
+			| DMA_CH_MOD_MD_SIZE_BITS_8BIT
+			| ST7565_DMA_HSREQ
+			;
+		DMA_CH1->CTR = 0
+			| DMA_CH_CTR_CH_EN_BITS_ENABLE
+			| (((Span.End - Span.Start - 1U) << DMA_CH_CTR_LENGTH_SHIFT) & DMA_CH_CTR_LENGTH_MASK)
+			| DMA_CH_CTR_LOOP_BITS_DISABLE
+			| DMA_CH_CTR_PRI_BITS_LOW
+			;
+		SPI0->CR |= SPI_CR_TXDMAEN_MASK;
+
+		return true;
+	}
+
+	return false;
+}
+
+void HandlerDMA(void)
+{
+	if ((DMA_INTST & DMA_INTST_CH1_TC_INTST_MASK) == DMA_INTST_CH1_TC_INTST_BITS_NOT_SET) {
+		return;
+	}
+	DMA_INTST = DMA_INTST_CH1_TC_INTST_BITS_SET;
+
+	// The DMA is done once the last byte is in the FIFO, not on the wire.
+	// Waiting for the FIFO to drain and the next line's commands are left
+	// to ST7565_ServiceBlit so the interrupt never spins on the SPI.
+	gDmaLineDone = true;
+}
+
+void ST7565_ServiceBlit(void)
+{
+	if (!gDmaLineDone) {
+		return;
+	}
+	gDmaLineDone = false;
+
+	SPI_WaitForUndocumentedTxFifoStatusBit();
+	if (!StartNextLineDma()) {
+		SPI0->CR = (SPI0->CR & ~SPI_CR_TXDMAEN_MASK);
+		DMA_CH1->CTR = DMA_CH_CTR_CH_EN_BITS_DISABLE;
+		DMA_INTEN = (DMA_INTEN & ~DMA_INTEN_CH1_TC_INTEN_MASK) | DMA_INTEN_CH1_TC_INTEN_BITS_DISABLE;
+		SPI_ToggleMasterMode(&SPI0->CR, true);
+		gDisplayBusy = false;
+	}
+}
+#else
+static void SendLineSync(uint8_t Line, ST7565_Span_t Span)
 {
-	uint8_t Line;
 	uint8_t Column;
 
+	ST7565_SelectColumnAndLine(Span.Start + 4U, Line + 1U);
+	GPIO_SetBit(&GPIOB->DATA, GPIOB_PIN_ST7565_A0);
+	for (Column = Span.Start; Column < Span.End; Column++) {
+		while ((SPI0->FIFOST & SPI_FIFOST_TFF_MASK) != SPI_FIFOST_TFF_BITS_NOT_FULL) {
+		}
+		SPI0->WDR = BLIT_BUFFER[Line][Column];
+	}
+	SPI_WaitForUndocumentedTxFifoStatusBit();
+}
+#endif
+
+#if defined(ENABLE_DISPLAY_DOUBLE_BUFFER)
+static void CommitChanges(uint8_t Line, ST7565_Span_t *pSpan)
+{
+	uint8_t Start = pSpan->Start;
+	uint8_t End = pSpan->End;
+
+	while (Start < End && gFrameBuffer[Line][Start] == gFrontBuffer[Line][Start]) {
+		Start++;
+	}
+	while (End > Start && gFrameBuffer[Line][End - 1] == gFrontBuffer[Line][End - 1]) {
+		End--;
+	}
+	if (Start == End) {
+		pSpan->End = 0;
+		return;
+	}
+	pSpan->Start = Start;
+	pSpan->End = End;
+	memcpy(&gFrontBuffer[Line][Start], &gFrameBuffer[Line][Start], End - Start);
+}
+#endif
+
+static void SendPending(void)
+{
+	uint16_t BytesSent;
+	uint8_t Line;
+
+	BytesSent = 0;
+	for (Line = 0; Line < ARRAY_SIZE(gPendingSpans); Line++) {
+		if (gPendingSpans[Line].End) {
+			BytesSent += gPendingSpans[Line].End - gPendingSpans[Line].Start;
+		}
+	}
+	gDisplayBytesSent = BytesSent;
+	if (BytesSent == 0) {
+		return;
+	}
+
 	SPI_ToggleMasterMode(&SPI0->CR, false);
 	ST7565_WriteByte(0x40);
 
+#if defined(ENABLE_DISPLAY_DMA)
+	gDisplayBusy = true;
+	gDmaLine = 0;
+	gDmaLineDone = false;
+	DMA_INTST = DMA_INTST_CH1_TC_INTST_BITS_SET;
+	DMA_INTEN = (DMA_INTEN & ~DMA_INTEN_CH1_TC_INTEN_MASK) | DMA_INTEN_CH1_TC_INTEN_BITS_ENABLE;
+	DMA_CTR = (DMA_CTR & ~DMA_CTR_DMAEN_MASK) | DMA_CTR_DMAEN_BITS_ENABLE;
+	NVIC_EnableIRQ(DP32_DMA_IRQn);
+	StartNextLineDma();
+#else
+	for (Line = 0; Line < ARRAY_SIZE(gPendingSpans); Line++) {
+		if (gPendingSpans[Line].End) {
+			SendLineSync(Line, gPendingSpans[Line]);
+		}
+	}
+	SPI_ToggleMasterMode(&SPI0->CR, true);
+#endif
+}
+
+void ST7565_WaitForBlit(void)
+{
+	while (gDisplayBusy) {
+#if defined(ENABLE_DISPLAY_DMA)
+		ST7565_ServiceBlit();
+#endif
+	}
+}
+
+void ST7565_BlitFullScreen(void)
+{
+	uint8_t Line;
+
+	ST7565_WaitForBlit();
+	for (Line = 0; Line < ARRAY_SIZE(gPendingSpans); Line++) {
+		gPendingSpans[Line].Start = 0;
+		gPendingSpans[Line].End = ARRAY_SIZE(gFrameBuffer[0]);
+	}
+#if defined(ENABLE_DISPLAY_DOUBLE_BUFFER)
+	memcpy(gFrontBuffer, gFrameBuffer, sizeof(gFrontBuffer));
+#endif
+	MarkAllShown();
+	SendPending();
+}
+
+static void BlitSpans(bool bRetained)
+{
+	uint8_t Line;
+
+	ST7565_WaitForBlit();
 	for (Line = 0; Line < ARRAY_SIZE(gFrameBuffer); Line++) {
-		ST7565_SelectColumnAndLine(4U, Line + 1U);
-		GPIO_SetBit(&GPIOB->DATA, GPIOB_PIN_ST7565_A0);
-		for (Column = 0; Column < ARRAY_SIZE(gFrameBuffer[0]); Column++) {
-			while ((SPI0->FIFOST & SPI_FIFOST_TFF_MASK) != SPI_FIFOST_TFF_BITS_NOT_FULL) {
+		if (bRetained) {
+			// Nothing was cleared behind our back, only the drawn columns
+			// changed and everything else on the glass is still there.
+			gPendingSpans[Line] = gDrawnSpans[Line];
+			if (gDrawnSpans[Line].End) {
+				ExtendSpan(&gShownSpans[Line], gDrawnSpans[Line].Start, gDrawnSpans[Line].End);
+			}
+		} else {
+			// Whatever was shown last frame may have been cleared by the
+			// screen's memset, so it has to go out again along with what
+			// was just drawn.
+			gPendingSpans[Line] = gShownSpans[Line];
+			if (gDrawnSpans[Line].End) {
+				ExtendSpan(&gPendingSpans[Line], gDrawnSpans[Line].Start, gDrawnSpans[Line].End);
 			}
-			SPI0->WDR = gFrameBuffer[Line][Column];
+			gShownSpans[Line] = gDrawnSpans[Line];
 		}
-		SPI_WaitForUndocumentedTxFifoStatusBit();
+		gDrawnSpans[Line].End = 0;
+#if defined(ENABLE_DISPLAY_DOUBLE_BUFFER)
+		if (gPendingSpans[Line].End) {
+			CommitChanges(Line, &gPendingSpans[Line]);
+		}
+#endif
 	}
+	SendPending();
+}
 
-	SYSTEM_DelayMs(20);
-	SPI_ToggleMasterMode(&SPI0->CR, true);
+void ST7565_BlitDirty(void)
+{
+	BlitSpans(false);
+}
+
+void ST7565_BlitRetained(void)
+{
+	BlitSpans(true);
 }
 
 void ST7565_BlitStatusLine(void)
 {
 	uint8_t i;
 
+	ST7565_WaitForBlit();
 	SPI_ToggleMasterMode(&SPI0->CR, false);
 	ST7565_WriteByte(0x40);
 	ST7565_SelectColumnAndLine(4, 0);
@@ -97,6 +367,10 @@ void ST7565_FillScreen(uint8_t Value)
 {
 	uint8_t i, j;
 
+	ST7565_WaitForBlit();
+#if defined(ENABLE_DISPLAY_DOUBLE_BUFFER)
+	memset(gFrontBuffer, Value, sizeof(gFrontBuffer));
+#endif
 	SPI_ToggleMasterMode(&SPI0->CR, false);
 	for (i = 0; i < 8; i++) {
 		ST7565_SelectColumnAndLine(0, i);
@@ -109,6 +383,8 @@ void ST7565_FillScreen(uint8_t Value)
 		SPI_WaitForUndocumentedTxFifoStatusBit();
 	}
 	SPI_ToggleMasterMode(&SPI0->CR, true);
+
+	MarkAllShown();
 }
 
 void ST7565_Init(void)
@@ -152,6 +428,51 @@ void ST7565_HardwareReset(void)
 	SYSTEM_DelayMs(120);
 }
 
+void ST7565_ClearFrameBuffer(void)
+{
+	uint8_t Line;
+
+	memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
+	for (Line = 0; Line < ARRAY_SIZE(gFrameBuffer); Line++) {
+		if (gShownSpans[Line].End) {
+			ExtendSpan(&gDrawnSpans[Line], gShownSpans[Line].Start, gShownSpans[Line].End);
+		}
+	}
+}
+
+void ST7565_MarkDirty(uint8_t Line, int16_t Column, uint16_t Size)
+{
+	uint16_t Offset;
+	uint16_t End;
+
+	// Anything left of the first column is off the glass.
+	if (Column < 0) {
+		if (Size <= (uint16_t)-Column) {
+			return;
+		}
+		Size -= (uint16_t)-Column;
+		Column = 0;
+	}
+
+	// Callers may run past the end of a line into the next one, as
+	// memcpy into gFrameBuffer would.
+	Offset = (Line * ARRAY_SIZE(gFrameBuffer[0])) + (uint16_t)Column;
+	End = Offset + Size;
+	if (End > sizeof(gFrameBuffer)) {
+		End = sizeof(gFrameBuffer);
+	}
+	while (Offset < End) {
+		const uint8_t Start = Offset % ARRAY_SIZE(gFrameBuffer[0]);
+		uint16_t Count = ARRAY_SIZE(gFrameBuffer[0]) - Start;
+
+		if (Count > End - Offset) {
+			Count = End - Offset;
+		}
+		ExtendSpan(&gDrawnSpans[Offset / ARRAY_SIZE(gFrameBuffer[0])], Start, Start + Count);
+		Offset += Count;
+	}
+}
+
 void ST7565_SelectColumnAndLine(uint8_t Column, uint8_t Line)
 {
 	GPIO_ClearBit(&GPIOB->DATA, GPIOB_PIN_ST7565_A0);
@@ -20,17 +20,32 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+typedef struct {
+	uint8_t Start;
+	uint8_t End;
+} ST7565_Span_t;
+
 extern uint8_t gStatusLine[128];
 extern uint8_t gFrameBuffer[7][128];
+extern uint16_t gDisplayBytesSent;
+extern volatile bool gDisplayBusy;
 
 void ST7565_DrawLine(uint8_t Column, uint8_t Line, uint16_t Size, const uint8_t *pBitmap, bool bIsClearMode);
 void ST7565_BlitFullScreen(void);
+void ST7565_BlitDirty(void);
+void ST7565_BlitRetained(void);
 void ST7565_BlitStatusLine(void);
+void ST7565_ClearFrameBuffer(void);
 void ST7565_FillScreen(uint8_t Value);
 void ST7565_Init(void);
 void ST7565_HardwareReset(void);
+void ST7565_MarkDirty(uint8_t Line, int16_t Column, uint16_t Size);
 void ST7565_SelectColumnAndLine(uint8_t Column, uint8_t Line);
 void ST7565_WriteByte(uint8_t Value);
+void ST7565_WaitForBlit(void);
+#if defined(ENABLE_DISPLAY_DMA)
+void ST7565_ServiceBlit(void);
+#endif
 
 #endif
 
@@ -52,3 +52,17 @@ void SYSTICK_DelayUs(uint32_t Delay)
 	} while (i < Delay * gTickMultiplier);
 }
 
+// Time since SYSTICK_Init, for measurements. Wraps after about 71 minutes.
+uint32_t SYSTICK_GetMicroseconds(void)
+{
+	uint32_t Ticks;
+	uint32_t Current;
+
+	do {
+		Ticks = gGlobalSysTickCounter;
+		Current = SysTick->VAL;
+	} while (Ticks != gGlobalSysTickCounter);
+
+	return (Ticks * 10000U) + ((SysTick->LOAD - Current) / gTickMultiplier);
+}
+
@@ -21,6 +21,7 @@
 
 void SYSTICK_Init(void);
 void SYSTICK_DelayUs(uint32_t Delay);
+uint32_t SYSTICK_GetMicroseconds(void);
 
 #endif
 
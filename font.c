@@ -16,6 +16,10 @@
 
 #include "font.h"
 
+// gFontBig and gFontBigDigits are the source for font-packed.c, which
+// replaces them when ENABLE_PACKED_FONT is set. Run "make fonts" after
+// editing them.
+#if !defined(ENABLE_PACKED_FONT)
 const uint8_t gFontBig[95][16] = {
 	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
 	{ 0x00, 0x00, 0x70, 0xF8, 0xF8, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1B, 0x1B, 0x00, 0x00, 0x00 },
@@ -127,6 +131,7 @@ const uint8_t gFontBigDigits[11][26] = {
 	{ 0x00, 0xF0, 0xF8, 0xB8, 0x1C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1C, 0xB8, 0xF0, 0xE0, 0x00, 0x11, 0x33, 0x77, 0x67, 0x66, 0x66, 0x66, 0x76, 0x33, 0x3F, 0x1F, 0x07 },
 	{ 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00 },
 };
+#endif
 
 const uint8_t gFontSmallDigits[11][7] = {
 	{ 0x00, 0x3E, 0x41, 0x41, 0x41, 0x41, 0x3E },
@@ -19,8 +19,14 @@
 
 #include <stdint.h>
 
+#if defined(ENABLE_PACKED_FONT)
+extern const uint8_t gFontColumns[][2];
+extern const uint8_t gFontBigColumns[95][8];
+extern const uint8_t gFontBigDigitsColumns[11][13];
+#else
 extern const uint8_t gFontBig[95][16];
 extern const uint8_t gFontBigDigits[11][26];
+#endif
 extern const uint8_t gFontSmallDigits[11][7];
 
 #endif
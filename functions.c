@@ -28,6 +28,7 @@
 #include "driver/bk1080.h"
 #endif
 #include "driver/bk4819.h"
+#include "driver/eeprom.h"
 #include "driver/gpio.h"
 #include "driver/system.h"
 #include "functions.h"
@@ -127,6 +128,10 @@ void FUNCTION_Select(FUNCTION_Type_t Function)
 		return;
 
 	case FUNCTION_TRANSMIT:
+		// A transmission can last minutes and is when a weak battery is
+		// most likely to drop out, so no save is left waiting through it.
+		EEPROM_Flush();
+
 #if defined(ENABLE_FMRADIO)
 		if (gFmRadioMode) {
 			BK1080_Init(0, false);
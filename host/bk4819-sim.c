@@ -0,0 +1,435 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "driver/bk4819-regs.h"
+#include "host/bk4819-sim.h"
+#include "host/host.h"
+
+// Register level model of the BK4819 behind its 3-wire bus. The firmware's
+// BK4819_ReadRegister and BK4819_WriteRegister run unchanged and the
+// model decodes their pin changes. Time is the simulated clock, so FSK
+// airtime and scripted carriers line up with the delays the firmware makes.
+//
+// Only what the firmware looks at is modelled: the interrupt latch in
+// REG_0C/REG_02, squelch from RSSI, noise and glitch against REG_78,
+// REG_4F, REG_4D and REG_4E, the FSK FIFOs with their airtime, and a
+// frequency scan that finds the strongest carrier. Everything else reads
+// back what was written.
+
+static struct {
+	bool bScn;
+	bool bScl;
+	bool bRead;
+	uint8_t Bit;
+	uint8_t Register;
+	uint16_t Value;
+} gSpi;
+
+BKSIM_t gBksim;
+
+void BKSIM_Reset(void)
+{
+	memset(&gBksim, 0, sizeof(gBksim));
+	memset(&gSpi, 0, sizeof(gSpi));
+	gSpi.bScn = true;
+}
+
+uint32_t BKSIM_GetFrequency(void)
+{
+	return gBksim.Registers[BK4819_REG_38] | ((uint32_t)gBksim.Registers[BK4819_REG_39] << 16);
+}
+
+// REG_72 holds the baud rate times 10.32444, as BK4819_ConfigureFSK writes it.
+uint32_t BKSIM_GetBaudRate(void)
+{
+	const uint32_t Value = gBksim.Registers[BK4819_REG_72];
+
+	if (Value == 0) {
+		return 1200;
+	}
+
+	return ((Value * 10000U) + 51622U) / 103244U;
+}
+
+static uint64_t GetAirtime(uint32_t Bits)
+{
+	return ((uint64_t)Bits * 1000000U) / BKSIM_GetBaudRate();
+}
+
+// Preamble and sync word, in bits.
+static uint32_t GetHeaderBits(void)
+{
+	const uint16_t Value = gBksim.Registers[BK4819_REG_59];
+	const uint32_t Preamble = ((Value >> BK4819_REG_59_SHIFT_FSK_PREAMBLE_LENGTH) & 0xFU) + 1U;
+	const uint32_t Sync = (Value & BK4819_REG_59_MASK_FSK_SYNC_LENGTH) ? 4U : 2U;
+
+	return (Preamble + Sync) * 8U;
+}
+
+// REG_5D holds the packet length less one, split over bits 15:8 and 2:0.
+static uint16_t GetTxLength(void)
+{
+	const uint16_t Value = gBksim.Registers[BK4819_REG_5D];
+
+	return (((Value >> 8) & 0xFFU) | ((Value << 3) & 0x700U)) + 1U;
+}
+
+static bool IsReceiving(void)
+{
+	return (gBksim.Registers[BK4819_REG_30] & BK4819_REG_30_MASK_ENABLE_RX_DSP) != 0;
+}
+
+// Sources that are not enabled in REG_3F never raise the request line.
+static void Raise(uint16_t Mask)
+{
+	gBksim.Pending |= Mask & gBksim.Registers[BK4819_REG_3F];
+}
+
+static void GetLevels(uint16_t *pRssi, uint8_t *pNoise, uint8_t *pGlitch)
+{
+	const uint32_t Frequency = BKSIM_GetFrequency();
+	uint8_t i;
+
+	*pRssi = BKSIM_FLOOR_RSSI;
+	*pNoise = BKSIM_FLOOR_NOISE;
+	*pGlitch = BKSIM_FLOOR_GLITCH;
+	if (!IsReceiving() || gHostMicroseconds < gBksim.Tuned + BKSIM_SETTLE_US) {
+		return;
+	}
+
+	for (i = 0; i < gBksim.SignalCount; i++) {
+		const BKSIM_Signal_t *pSignal = &gBksim.Signals[i];
+
+		if (pSignal->Frequency != Frequency || gHostMicroseconds < pSignal->Start || gHostMicroseconds >= pSignal->End) {
+			continue;
+		}
+		if (pSignal->Rssi > *pRssi) {
+			*pRssi = pSignal->Rssi;
+			*pNoise = pSignal->Noise;
+			*pGlitch = pSignal->Glitch;
+		}
+	}
+}
+
+// The firmware takes REG_02's SQUELCH_LOST bit for a carrier coming up and
+// SQUELCH_FOUND for it going away, as the green LED it drives shows on the
+// radio, so the model raises them that way round.
+static void UpdateSquelch(void)
+{
+	const uint16_t *pRegisters = gBksim.Registers;
+	uint16_t Rssi;
+	uint8_t Noise;
+	uint8_t Glitch;
+
+	if (IsReceiving() && gHostMicroseconds < gBksim.Tuned + BKSIM_SQUELCH_SETTLE_US) {
+		return;
+	}
+	GetLevels(&Rssi, &Noise, &Glitch);
+	if (!gBksim.bSquelchOpen) {
+		if (IsReceiving()
+			&& Rssi >= (pRegisters[BK4819_REG_78] >> 8)
+			&& Noise <= (pRegisters[BK4819_REG_4F] & 0x7FU)
+			&& Glitch <= (pRegisters[BK4819_REG_4E] & 0xFFU)) {
+			gBksim.bSquelchOpen = true;
+			Raise(BK4819_REG_02_SQUELCH_LOST);
+		}
+	} else {
+		if (!IsReceiving()
+			|| Rssi < (pRegisters[BK4819_REG_78] & 0xFFU)
+			|| Noise > ((pRegisters[BK4819_REG_4F] >> 8) & 0x7FU)
+			|| Glitch > (pRegisters[BK4819_REG_4D] & 0xFFU)) {
+			gBksim.bSquelchOpen = false;
+			Raise(BK4819_REG_02_SQUELCH_FOUND);
+		}
+	}
+}
+
+static void UpdateTx(void)
+{
+	uint16_t Words;
+
+	if (gBksim.TxEnd == 0 || gHostMicroseconds < gBksim.TxEnd) {
+		return;
+	}
+
+	Words = (GetTxLength() + 1U) / 2U;
+	if (Words > gBksim.TxCount) {
+		Words = gBksim.TxCount;
+	}
+	memcpy(gBksim.Sent, gBksim.TxFifo, Words * sizeof(gBksim.TxFifo[0]));
+	gBksim.SentCount = Words;
+	gBksim.TxCount = 0;
+	gBksim.TxEnd = 0;
+	gBksim.TxPackets++;
+	Raise(BK4819_REG_02_FSK_TX_FINISHED);
+}
+
+// Words that have come off the air go into the RX FIFO while FSK RX is
+// enabled and are lost otherwise.
+static void UpdateRx(void)
+{
+	const bool bEnabled = (gBksim.Registers[BK4819_REG_59] & BK4819_REG_59_MASK_FSK_ENABLE_RX) != 0;
+	uint8_t i;
+
+	for (i = 0; i < gBksim.PacketCount; i++) {
+		BKSIM_Packet_t *pPacket = &gBksim.Packets[i];
+		const uint64_t SyncAt = pPacket->Start + GetAirtime(GetHeaderBits());
+
+		if (pPacket->Received == pPacket->Count || gHostMicroseconds < SyncAt) {
+			continue;
+		}
+		if (!pPacket->bSynced) {
+			pPacket->bSynced = true;
+			if (bEnabled) {
+				Raise(BK4819_REG_02_FSK_RX_SYNC);
+			}
+		}
+		while (pPacket->Received < pPacket->Count && gHostMicroseconds >= SyncAt + GetAirtime((pPacket->Received + 1U) * 16U)) {
+			const uint16_t Word = pPacket->Words[pPacket->Received++];
+
+			if (!bEnabled) {
+				continue;
+			}
+			if (gBksim.RxCount == BKSIM_FIFO_WORDS) {
+				gBksim.RxOverflows++;
+				continue;
+			}
+			gBksim.RxFifo[(gBksim.RxHead + gBksim.RxCount) % BKSIM_FIFO_WORDS] = Word;
+			gBksim.RxCount++;
+			if (gBksim.RxCount == BKSIM_RX_ALMOST_FULL) {
+				Raise(BK4819_REG_02_FSK_FIFO_ALMOST_FULL);
+			}
+		}
+		if (pPacket->Received == pPacket->Count && bEnabled) {
+			Raise(BK4819_REG_02_FSK_RX_FINISHED);
+		}
+	}
+}
+
+static void Update(void)
+{
+	UpdateTx();
+	UpdateRx();
+	UpdateSquelch();
+}
+
+static uint16_t ReadRegister(uint8_t Register)
+{
+	uint16_t Rssi;
+	uint8_t Noise;
+	uint8_t Glitch;
+	uint16_t Value;
+	uint8_t i;
+
+	Update();
+	GetLevels(&Rssi, &Noise, &Glitch);
+
+	switch (Register) {
+	case BK4819_REG_02:
+		return gBksim.Latched;
+
+	case BK4819_REG_0C:
+		return gBksim.Pending ? 1U : 0U;
+
+	case BK4819_REG_0D:
+	case BK4819_REG_0E:
+		// The frequency scan locks onto the strongest carrier on the air.
+		if (gBksim.Registers[BK4819_REG_32] & 1U) {
+			const BKSIM_Signal_t *pBest = NULL;
+
+			for (i = 0; i < gBksim.SignalCount; i++) {
+				const BKSIM_Signal_t *pSignal = &gBksim.Signals[i];
+
+				if (gHostMicroseconds >= pSignal->Start && gHostMicroseconds < pSignal->End && (!pBest || pSignal->Rssi > pBest->Rssi)) {
+					pBest = pSignal;
+				}
+			}
+			if (pBest) {
+				return (Register == BK4819_REG_0D) ? ((pBest->Frequency >> 16) & 0x7FFU) : (pBest->Frequency & 0xFFFFU);
+			}
+		}
+		return (Register == BK4819_REG_0D) ? 0x8000U : 0U;
+
+	case BK4819_REG_5F:
+		if (gBksim.RxCount == 0) {
+			return 0;
+		}
+		Value = gBksim.RxFifo[gBksim.RxHead];
+		gBksim.RxHead = (gBksim.RxHead + 1U) % BKSIM_FIFO_WORDS;
+		gBksim.RxCount--;
+		return Value;
+
+	case BK4819_REG_63:
+		return Glitch;
+
+	case BK4819_REG_65:
+		return Noise;
+
+	case BK4819_REG_67:
+		return Rssi;
+
+	case BK4819_REG_68:
+	case BK4819_REG_69:
+		// No sub-audio code found.
+		return 0x8000U;
+
+	default:
+		return gBksim.Registers[Register];
+	}
+}
+
+static void WriteRegister(uint8_t Register, uint16_t Value)
+{
+	const uint16_t Previous = gBksim.Registers[Register];
+
+	Update();
+	gBksim.Registers[Register] = Value;
+
+	switch (Register) {
+	case BK4819_REG_00:
+		if (Value & 0x8000U) {
+			memset(gBksim.Registers, 0, sizeof(gBksim.Registers));
+			gBksim.Pending = 0;
+			gBksim.Latched = 0;
+			gBksim.TxCount = 0;
+			gBksim.TxEnd = 0;
+			gBksim.RxCount = 0;
+			gBksim.bSquelchOpen = false;
+		}
+		break;
+
+	case BK4819_REG_02:
+		gBksim.Latched = gBksim.Pending;
+		gBksim.Pending = 0;
+		break;
+
+	case BK4819_REG_38:
+	case BK4819_REG_39:
+		if (Value != Previous) {
+			gBksim.Tuned = gHostMicroseconds;
+		}
+		break;
+
+	case BK4819_REG_59:
+		if (Value & BK4819_REG_59_MASK_FSK_CLEAR_TX_FIFO) {
+			gBksim.TxCount = 0;
+		}
+		if (Value & BK4819_REG_59_MASK_FSK_CLEAR_RX_FIFO) {
+			gBksim.RxHead = 0;
+			gBksim.RxCount = 0;
+		}
+		if ((Value & BK4819_REG_59_MASK_FSK_ENABLE_TX) && !(Previous & BK4819_REG_59_MASK_FSK_ENABLE_TX)) {
+			gBksim.TxEnd = gHostMicroseconds + GetAirtime(GetHeaderBits() + (GetTxLength() * 8U));
+		} else if (!(Value & BK4819_REG_59_MASK_FSK_ENABLE_TX)) {
+			gBksim.TxEnd = 0;
+		}
+		break;
+
+	case BK4819_REG_5F:
+		if (gBksim.TxCount < BKSIM_FIFO_WORDS) {
+			gBksim.TxFifo[gBksim.TxCount++] = Value;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	Update();
+}
+
+// Bits are sampled on rising SCL while SCN is low: 8 of address, with bit 7
+// set for a read, then 16 of data. On a read the chip drives each data bit
+// after the previous rising edge, which is where BK4819_ReadU16 samples it.
+void BKSIM_Bus(bool bScn, bool bScl, bool bSda)
+{
+	if (bScn != gSpi.bScn) {
+		gSpi.bScn = bScn;
+		gSpi.bRead = false;
+		gSpi.Bit = 0;
+		gSpi.Register = 0;
+		gSpi.Value = 0;
+	}
+
+	if (!bScn && bScl && !gSpi.bScl && gSpi.Bit < 24) {
+		if (gSpi.Bit < 8) {
+			gSpi.Register = (gSpi.Register << 1) | bSda;
+		} else if (!gSpi.bRead) {
+			gSpi.Value = (gSpi.Value << 1) | bSda;
+		}
+		gSpi.Bit++;
+		if (gSpi.Bit == 8) {
+			gSpi.bRead = (gSpi.Register & 0x80U) != 0;
+			gSpi.Register &= 0x7FU;
+			if (gSpi.bRead) {
+				gSpi.Value = ReadRegister(gSpi.Register);
+				gBksim.Reads++;
+			}
+		} else if (gSpi.Bit == 24 && !gSpi.bRead) {
+			WriteRegister(gSpi.Register, gSpi.Value);
+			gBksim.Writes++;
+		}
+	}
+	gSpi.bScl = bScl;
+}
+
+bool BKSIM_GetSda(void)
+{
+	if (!gSpi.bScn && gSpi.bRead && gSpi.Bit >= 8 && gSpi.Bit < 24) {
+		return (gSpi.Value >> (23U - gSpi.Bit)) & 1U;
+	}
+
+	return true;
+}
+
+void BKSIM_AddSignal(uint32_t Frequency, uint64_t Start, uint64_t End, uint16_t Rssi)
+{
+	BKSIM_Signal_t *pSignal;
+
+	if (gBksim.SignalCount == BKSIM_MAX_SIGNALS) {
+		return;
+	}
+	pSignal = &gBksim.Signals[gBksim.SignalCount++];
+	pSignal->Frequency = Frequency;
+	pSignal->Start = Start;
+	pSignal->End = End;
+	pSignal->Rssi = Rssi;
+	pSignal->Noise = 10;
+	pSignal->Glitch = 5;
+}
+
+void BKSIM_AddPacket(uint64_t Start, const uint16_t *pWords, uint16_t Count)
+{
+	BKSIM_Packet_t *pPacket;
+
+	if (gBksim.PacketCount == BKSIM_MAX_PACKETS || Count > BKSIM_FIFO_WORDS) {
+		return;
+	}
+	pPacket = &gBksim.Packets[gBksim.PacketCount++];
+	memset(pPacket, 0, sizeof(*pPacket));
+	pPacket->Start = Start;
+	memcpy(pPacket->Words, pWords, Count * sizeof(pWords[0]));
+	pPacket->Count = Count;
+}
+
+// For sources the model does not generate itself, such as DTMF or CTCSS.
+void BKSIM_Interrupt(uint16_t Mask)
+{
+	Raise(Mask);
+}
+
@@ -0,0 +1,107 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef HOST_BK4819_SIM_H
+#define HOST_BK4819_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BKSIM_REGISTERS		0x80U
+#define BKSIM_FIFO_WORDS	128U
+#define BKSIM_MAX_SIGNALS	64U
+#define BKSIM_MAX_PACKETS	4U
+
+// RX FIFO fill, in words, at which FSK_FIFO_ALMOST_FULL fires. AIRCOPY
+// reads four words per interrupt, which matches the power-on threshold.
+#define BKSIM_RX_ALMOST_FULL	4U
+
+// REG_67 reading with nothing on the channel, about -130 dBm, and the
+// noise and glitch indicators that go with an empty channel.
+#define BKSIM_FLOOR_RSSI	60U
+#define BKSIM_FLOOR_NOISE	70U
+#define BKSIM_FLOOR_GLITCH	150U
+
+// How long after a retune the RSSI takes to follow the new frequency, and
+// the squelch, with the open and close delays REG_4E sets. Until then the
+// RSSI reads as an empty channel and the squelch stays as it was.
+#define BKSIM_SETTLE_US		500U
+#define BKSIM_SQUELCH_SETTLE_US	5000U
+
+// A carrier on one frequency, in the 10 Hz units of REG_38/REG_39, between
+// two points on the simulated clock.
+typedef struct {
+	uint32_t Frequency;
+	uint64_t Start;
+	uint64_t End;
+	uint16_t Rssi;
+	uint8_t Noise;
+	uint8_t Glitch;
+} BKSIM_Signal_t;
+
+// An FSK packet that starts arriving, preamble first, at Start.
+typedef struct {
+	uint64_t Start;
+	uint16_t Words[BKSIM_FIFO_WORDS];
+	uint16_t Count;
+	uint16_t Received;
+	bool bSynced;
+} BKSIM_Packet_t;
+
+typedef struct {
+	uint16_t Registers[BKSIM_REGISTERS];
+	// Interrupt sources raised since the last write to REG_02, and the ones
+	// that write latched for reading back.
+	uint16_t Pending;
+	uint16_t Latched;
+	bool bSquelchOpen;
+	// When REG_38/REG_39 last changed.
+	uint64_t Tuned;
+
+	uint16_t TxFifo[BKSIM_FIFO_WORDS];
+	uint16_t TxCount;
+	uint64_t TxEnd;
+	uint16_t Sent[BKSIM_FIFO_WORDS];
+	uint16_t SentCount;
+	uint32_t TxPackets;
+
+	uint16_t RxFifo[BKSIM_FIFO_WORDS];
+	uint16_t RxHead;
+	uint16_t RxCount;
+	uint32_t RxOverflows;
+
+	BKSIM_Signal_t Signals[BKSIM_MAX_SIGNALS];
+	uint8_t SignalCount;
+	BKSIM_Packet_t Packets[BKSIM_MAX_PACKETS];
+	uint8_t PacketCount;
+
+	uint32_t Reads;
+	uint32_t Writes;
+} BKSIM_t;
+
+extern BKSIM_t gBksim;
+
+void BKSIM_Reset(void);
+void BKSIM_Bus(bool bScn, bool bScl, bool bSda);
+bool BKSIM_GetSda(void);
+void BKSIM_AddSignal(uint32_t Frequency, uint64_t Start, uint64_t End, uint16_t Rssi);
+void BKSIM_AddPacket(uint64_t Start, const uint16_t *pWords, uint16_t Count);
+void BKSIM_Interrupt(uint16_t Mask);
+uint32_t BKSIM_GetFrequency(void);
+uint32_t BKSIM_GetBaudRate(void);
+
+#endif
+
@@ -0,0 +1,117 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "ARMCM0.h"
+#include "bsp/dp32g030/dma.h"
+#include "bsp/dp32g030/irq.h"
+#include "bsp/dp32g030/spi.h"
+#include "driver/st7565.h"
+#include "host/dma-sim.h"
+
+// The DMA engine as the display uses it: channel 1 moving bytes from RAM
+// into SPI0. It runs on its own thread, as the real one runs alongside the
+// CPU, and raises the transfer complete interrupt by calling HandlerDMA.
+
+DMASIM_t gDmasim;
+
+#if defined(ENABLE_DISPLAY_DMA)
+static pid_t gThreadOwner;
+
+void HandlerDMA(void);
+
+static bool IsStarted(void)
+{
+	return (DMA_CTR & DMA_CTR_DMAEN_MASK) == DMA_CTR_DMAEN_BITS_ENABLE
+		&& (DMA_CH1->CTR & DMA_CH_CTR_CH_EN_MASK) == DMA_CH_CTR_CH_EN_BITS_ENABLE
+		&& (SPI0->CR & SPI_CR_TXDMAEN_MASK) != 0
+		&& DMA_CH1->MDADDR == (uint32_t)(uintptr_t)&SPI0->WDR;
+}
+
+static void Transfer(void)
+{
+	const uint16_t Length = ((DMA_CH1->CTR & DMA_CH_CTR_LENGTH_MASK) >> DMA_CH_CTR_LENGTH_SHIFT) + 1U;
+	const uint8_t *pSource;
+	uint16_t Size;
+
+	// The address registers only hold 32 bits. The framebuffers are in this
+	// binary's bss, so the upper half is the same as gFrameBuffer's.
+	pSource = (const uint8_t *)(((uintptr_t)gFrameBuffer & ~(uintptr_t)0xFFFFFFFFU) | DMA_CH1->MSADDR);
+	Size = Length;
+	if (Size > DMASIM_OUTPUT_SIZE - gDmasim.OutputSize) {
+		Size = DMASIM_OUTPUT_SIZE - gDmasim.OutputSize;
+	}
+	memcpy(gDmasim.Output + gDmasim.OutputSize, pSource, Size);
+	gDmasim.OutputSize += Size;
+
+	// The channel stops until it is programmed again.
+	DMA_CH1->CTR &= ~DMA_CH_CTR_CH_EN_MASK;
+	DMA_INTST |= DMA_INTST_CH1_TC_INTST_MASK;
+	gDmasim.Transfers++;
+	if ((DMA_INTEN & DMA_INTEN_CH1_TC_INTEN_MASK) && (gHostEnabledIrqs & (1U << DP32_DMA_IRQn))) {
+		gDmasim.Interrupts++;
+		HandlerDMA();
+	}
+}
+
+static void *Run(void *pContext)
+{
+	(void)pContext;
+
+	while (1) {
+		if (!gDmasim.bHeld && IsStarted()) {
+			Transfer();
+		} else {
+			sched_yield();
+		}
+	}
+
+	return NULL;
+}
+#endif
+
+// Threads do not survive a fork, so every process that blits needs its own.
+void DMASIM_Start(void)
+{
+#if defined(ENABLE_DISPLAY_DMA)
+	pthread_t Thread;
+
+	if (gThreadOwner == getpid()) {
+		return;
+	}
+	if (pthread_create(&Thread, NULL, Run, NULL)) {
+		perror("DMASIM_Start");
+		exit(1);
+	}
+	pthread_detach(Thread);
+	gThreadOwner = getpid();
+#endif
+}
+
+void DMASIM_Reset(void)
+{
+	gDmasim.bHeld = false;
+	gDmasim.OutputSize = 0;
+	gDmasim.Transfers = 0;
+	gDmasim.Interrupts = 0;
+	DMASIM_Start();
+}
+
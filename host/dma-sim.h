@@ -0,0 +1,41 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef HOST_DMA_SIM_H
+#define HOST_DMA_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define DMASIM_OUTPUT_SIZE	(7U * 128U)
+
+typedef struct {
+	// While set, started transfers wait instead of completing.
+	volatile bool bHeld;
+	// Bytes channel 1 fed to SPI0 since the last reset, in order.
+	uint8_t Output[DMASIM_OUTPUT_SIZE];
+	volatile uint16_t OutputSize;
+	volatile uint32_t Transfers;
+	volatile uint32_t Interrupts;
+} DMASIM_t;
+
+extern DMASIM_t gDmasim;
+
+void DMASIM_Start(void);
+void DMASIM_Reset(void);
+
+#endif
+
@@ -0,0 +1,146 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+#include "driver/aes.h"
+
+// AES-128 in CBC mode in software, standing in for the AES unit. Blocks,
+// keys and IVs are taken in memory byte order.
+
+static const uint8_t gSbox[256] = {
+	0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+	0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+	0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+	0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+	0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+	0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+	0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+	0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+	0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+	0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+	0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+	0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+	0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+	0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+	0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+	0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16,
+};
+
+static uint8_t Xtime(uint8_t Value)
+{
+	return (uint8_t)((Value << 1) ^ ((Value & 0x80U) ? 0x1BU : 0U));
+}
+
+static void ExpandKey(const uint8_t *pKey, uint8_t *pRoundKeys)
+{
+	uint8_t Rcon = 1;
+	uint8_t i;
+
+	memcpy(pRoundKeys, pKey, 16);
+	for (i = 16; i < 176; i += 4) {
+		uint8_t Word[4];
+		uint8_t j;
+
+		memcpy(Word, pRoundKeys + i - 4, 4);
+		if ((i % 16) == 0) {
+			const uint8_t First = Word[0];
+
+			Word[0] = gSbox[Word[1]] ^ Rcon;
+			Word[1] = gSbox[Word[2]];
+			Word[2] = gSbox[Word[3]];
+			Word[3] = gSbox[First];
+			Rcon = Xtime(Rcon);
+		}
+		for (j = 0; j < 4; j++) {
+			pRoundKeys[i + j] = pRoundKeys[i + j - 16] ^ Word[j];
+		}
+	}
+}
+
+static void EncryptBlock(const uint8_t *pRoundKeys, uint8_t *pState)
+{
+	uint8_t Round;
+	uint8_t i;
+
+	for (i = 0; i < 16; i++) {
+		pState[i] ^= pRoundKeys[i];
+	}
+	for (Round = 1; Round <= 10; Round++) {
+		uint8_t Temp;
+
+		for (i = 0; i < 16; i++) {
+			pState[i] = gSbox[pState[i]];
+		}
+
+		Temp = pState[1];
+		pState[1] = pState[5];
+		pState[5] = pState[9];
+		pState[9] = pState[13];
+		pState[13] = Temp;
+		Temp = pState[2];
+		pState[2] = pState[10];
+		pState[10] = Temp;
+		Temp = pState[6];
+		pState[6] = pState[14];
+		pState[14] = Temp;
+		Temp = pState[15];
+		pState[15] = pState[11];
+		pState[11] = pState[7];
+		pState[7] = pState[3];
+		pState[3] = Temp;
+
+		if (Round != 10) {
+			for (i = 0; i < 16; i += 4) {
+				const uint8_t A0 = pState[i + 0];
+				const uint8_t A1 = pState[i + 1];
+				const uint8_t A2 = pState[i + 2];
+				const uint8_t A3 = pState[i + 3];
+				const uint8_t All = A0 ^ A1 ^ A2 ^ A3;
+
+				pState[i + 0] = A0 ^ All ^ Xtime(A0 ^ A1);
+				pState[i + 1] = A1 ^ All ^ Xtime(A1 ^ A2);
+				pState[i + 2] = A2 ^ All ^ Xtime(A2 ^ A3);
+				pState[i + 3] = A3 ^ All ^ Xtime(A3 ^ A0);
+			}
+		}
+
+		for (i = 0; i < 16; i++) {
+			pState[i] ^= pRoundKeys[(Round * 16) + i];
+		}
+	}
+}
+
+void AES_Encrypt(const void *pKey, const void *pIv, const void *pIn, void *pOut, uint8_t NumBlocks)
+{
+	const uint8_t *pI = (const uint8_t *)pIn;
+	uint8_t *pO = (uint8_t *)pOut;
+	uint8_t RoundKeys[176];
+	uint8_t Chain[16];
+	uint8_t i;
+
+	ExpandKey((const uint8_t *)pKey, RoundKeys);
+	memcpy(Chain, pIv, sizeof(Chain));
+	for (i = 0; i < NumBlocks; i++) {
+		uint8_t j;
+
+		for (j = 0; j < 16; j++) {
+			Chain[j] ^= pI[(i * 16) + j];
+		}
+		EncryptBlock(RoundKeys, Chain);
+		memcpy(pO + (i * 16), Chain, sizeof(Chain));
+	}
+}
+
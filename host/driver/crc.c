@@ -0,0 +1,92 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "driver/crc.h"
+
+// The CRC unit as CRC_Init sets it up: CRC-16/CCITT, IV 0, no reflection or
+// inversion, restarted each time it is enabled. Unlike the hardware, using
+// it while a piecewise CRC is open is caught instead of corrupting both.
+
+static uint16_t gCrc;
+static bool gIsStarted;
+
+static void Check(bool bStarted, const char *pFunction)
+{
+	if (gIsStarted != bStarted) {
+		fprintf(stderr, "%s: CRC unit is %s\n", pFunction, gIsStarted ? "already in use" : "not started");
+		abort();
+	}
+}
+
+void CRC_Init(void)
+{
+	gIsStarted = false;
+}
+
+void CRC_Start(void)
+{
+	Check(false, __func__);
+	gIsStarted = true;
+	gCrc = 0;
+}
+
+static void Feed(uint8_t Byte)
+{
+	uint8_t i;
+
+	gCrc ^= Byte << 8;
+	for (i = 0; i < 8; i++) {
+		gCrc = (gCrc & 0x8000U) ? (uint16_t)((gCrc << 1) ^ 0x1021U) : (uint16_t)(gCrc << 1);
+	}
+}
+
+void CRC_Update(const void *pBuffer, uint16_t Size)
+{
+	const uint8_t *pData = (const uint8_t *)pBuffer;
+
+	Check(true, __func__);
+	while (Size--) {
+		Feed(*pData++);
+	}
+}
+
+void CRC_UpdateZeros(uint16_t Size)
+{
+	Check(true, __func__);
+	while (Size--) {
+		Feed(0);
+	}
+}
+
+uint16_t CRC_Finish(void)
+{
+	Check(true, __func__);
+	gIsStarted = false;
+
+	return gCrc;
+}
+
+uint16_t CRC_Calculate(const void *pBuffer, uint16_t Size)
+{
+	CRC_Start();
+	CRC_Update(pBuffer, Size);
+
+	return CRC_Finish();
+}
+
@@ -0,0 +1,152 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stddef.h>
+#include "bsp/dp32g030/gpio.h"
+#include "driver/gpio.h"
+#include "host/bk4819-sim.h"
+#include "host/eeprom-sim.h"
+#include "host/host.h"
+
+// Same register accesses as driver/gpio.c, plus the wiring on the other
+// side of the pins: the EEPROM on the I2C lines, the BK4819 on its 3-wire
+// bus, the key matrix and PTT.
+
+typedef struct {
+	KEY_Code_t Key;
+	// GPIOA pin pulled low to scan the key's row, or 0 for keys to ground.
+	uint8_t Row;
+	uint8_t Column;
+} Key_t;
+
+static const Key_t gKeys[] = {
+	{ KEY_SIDE1, 0,                      GPIOA_PIN_KEYBOARD_0 },
+	{ KEY_SIDE2, 0,                      GPIOA_PIN_KEYBOARD_1 },
+	{ KEY_MENU,  GPIOA_PIN_KEYBOARD_4,   GPIOA_PIN_KEYBOARD_0 },
+	{ KEY_1,     GPIOA_PIN_KEYBOARD_4,   GPIOA_PIN_KEYBOARD_1 },
+	{ KEY_4,     GPIOA_PIN_KEYBOARD_4,   GPIOA_PIN_KEYBOARD_2 },
+	{ KEY_7,     GPIOA_PIN_KEYBOARD_4,   GPIOA_PIN_KEYBOARD_3 },
+	{ KEY_UP,    GPIOA_PIN_KEYBOARD_5,   GPIOA_PIN_KEYBOARD_0 },
+	{ KEY_2,     GPIOA_PIN_KEYBOARD_5,   GPIOA_PIN_KEYBOARD_1 },
+	{ KEY_5,     GPIOA_PIN_KEYBOARD_5,   GPIOA_PIN_KEYBOARD_2 },
+	{ KEY_8,     GPIOA_PIN_KEYBOARD_5,   GPIOA_PIN_KEYBOARD_3 },
+	{ KEY_DOWN,  GPIOA_PIN_KEYBOARD_6,   GPIOA_PIN_KEYBOARD_0 },
+	{ KEY_3,     GPIOA_PIN_KEYBOARD_6,   GPIOA_PIN_KEYBOARD_1 },
+	{ KEY_6,     GPIOA_PIN_KEYBOARD_6,   GPIOA_PIN_KEYBOARD_2 },
+	{ KEY_9,     GPIOA_PIN_KEYBOARD_6,   GPIOA_PIN_KEYBOARD_3 },
+	{ KEY_EXIT,  GPIOA_PIN_KEYBOARD_7,   GPIOA_PIN_KEYBOARD_0 },
+	{ KEY_STAR,  GPIOA_PIN_KEYBOARD_7,   GPIOA_PIN_KEYBOARD_1 },
+	{ KEY_0,     GPIOA_PIN_KEYBOARD_7,   GPIOA_PIN_KEYBOARD_2 },
+	{ KEY_F,     GPIOA_PIN_KEYBOARD_7,   GPIOA_PIN_KEYBOARD_3 },
+};
+
+// What the firmware drives onto I2C SDA, released while the pin is an input.
+static bool MasterSda(void)
+{
+	if ((GPIOA->DIR & GPIO_DIR_11_MASK) != GPIO_DIR_11_BITS_OUTPUT) {
+		return true;
+	}
+
+	return (GPIOA->DATA >> GPIOA_PIN_I2C_SDA) & 1U;
+}
+
+// The BK4819 shares SDA with the firmware, which turns the pin round for
+// reads.
+static bool IsBk4819Reading(void)
+{
+	return (GPIOC->DIR & GPIO_DIR_2_MASK) == GPIO_DIR_2_BITS_INPUT;
+}
+
+static uint8_t ReadColumn(uint8_t Pin)
+{
+	size_t i;
+
+	for (i = 0; i < sizeof(gKeys) / sizeof(gKeys[0]); i++) {
+		const Key_t *pKey = &gKeys[i];
+
+		if (pKey->Key != gHostKey || pKey->Column != Pin) {
+			continue;
+		}
+		if (pKey->Row == 0 || ((GPIOA->DATA >> pKey->Row) & 1U) == 0) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static void PinsChanged(volatile uint32_t *pReg)
+{
+	if (pReg == &GPIOA->DATA) {
+		EESIM_Bus((GPIOA->DATA >> GPIOA_PIN_I2C_SCL) & 1U, MasterSda());
+	} else if (pReg == &GPIOC->DATA) {
+		BKSIM_Bus(
+			(GPIOC->DATA >> GPIOC_PIN_BK4819_SCN) & 1U,
+			(GPIOC->DATA >> GPIOC_PIN_BK4819_SCL) & 1U,
+			IsBk4819Reading() || ((GPIOC->DATA >> GPIOC_PIN_BK4819_SDA) & 1U));
+	}
+}
+
+void GPIO_ClearBit(volatile uint32_t *pReg, uint8_t Bit)
+{
+	*pReg &= ~(1U << Bit);
+	PinsChanged(pReg);
+}
+
+uint8_t GPIO_CheckBit(volatile uint32_t *pReg, uint8_t Bit)
+{
+	if (pReg == &GPIOA->DATA) {
+		switch (Bit) {
+		case GPIOA_PIN_I2C_SDA:
+			return MasterSda() && EESIM_GetSda();
+		case GPIOA_PIN_KEYBOARD_0:
+		case GPIOA_PIN_KEYBOARD_1:
+		case GPIOA_PIN_KEYBOARD_2:
+		case GPIOA_PIN_KEYBOARD_3:
+			return ReadColumn(Bit);
+		default:
+			break;
+		}
+	}
+	if (pReg == &GPIOC->DATA) {
+		switch (Bit) {
+		case GPIOC_PIN_BK4819_SDA:
+			if (IsBk4819Reading()) {
+				return BKSIM_GetSda();
+			}
+			break;
+		case GPIOC_PIN_PTT:
+			return !gHostPttPressed;
+		default:
+			break;
+		}
+	}
+
+	return (*pReg >> Bit) & 1U;
+}
+
+void GPIO_FlipBit(volatile uint32_t *pReg, uint8_t Bit)
+{
+	*pReg ^= 1U << Bit;
+	PinsChanged(pReg);
+}
+
+void GPIO_SetBit(volatile uint32_t *pReg, uint8_t Bit)
+{
+	*pReg |= 1U << Bit;
+	PinsChanged(pReg);
+}
+
@@ -0,0 +1,38 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include "ARMCM0.h"
+#include "driver/systick.h"
+#include "host/host.h"
+
+// Delays move the simulated clock instead of spinning on SysTick, so that
+// time measured on the host is bus and device time, not host CPU time.
+
+void SYSTICK_Init(void)
+{
+	SysTick_Config(480000);
+}
+
+void SYSTICK_DelayUs(uint32_t Delay)
+{
+	HOST_Advance(Delay);
+}
+
+uint32_t SYSTICK_GetMicroseconds(void)
+{
+	return (uint32_t)gHostMicroseconds;
+}
+
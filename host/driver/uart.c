@@ -0,0 +1,65 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+#include "bsp/dp32g030/dma.h"
+#include "driver/uart.h"
+#include "host/host.h"
+
+// UART1 TX lands in gHostUartOutput. RX goes through the same DMA ring as
+// on the radio: HOST_UartReceive plays the part of the DMA and moves the
+// CH0 status register on, which is all app/uart.c looks at.
+
+bool UART_IsLogEnabled = true;
+uint8_t UART_DMA_Buffer[256];
+
+uint8_t gHostUartOutput[4096];
+uint16_t gHostUartOutputSize;
+
+void UART_Init(void)
+{
+	memset(UART_DMA_Buffer, 0, sizeof(UART_DMA_Buffer));
+	DMA_CH0->ST = 0;
+}
+
+void UART_Send(const void *pBuffer, uint32_t Size)
+{
+	if (Size > sizeof(gHostUartOutput) - gHostUartOutputSize) {
+		Size = sizeof(gHostUartOutput) - gHostUartOutputSize;
+	}
+	memcpy(gHostUartOutput + gHostUartOutputSize, pBuffer, Size);
+	gHostUartOutputSize += Size;
+}
+
+void UART_LogSend(const void *pBuffer, uint32_t Size)
+{
+	if (UART_IsLogEnabled) {
+		UART_Send(pBuffer, Size);
+	}
+}
+
+void HOST_UartReceive(const void *pData, uint16_t Size)
+{
+	const uint8_t *pBytes = (const uint8_t *)pData;
+	uint16_t Index = DMA_CH0->ST & 0xFFFU;
+
+	while (Size--) {
+		UART_DMA_Buffer[Index] = *pBytes++;
+		Index = (Index + 1U) % sizeof(UART_DMA_Buffer);
+	}
+	DMA_CH0->ST = (DMA_CH0->ST & ~0xFFFU) | Index;
+}
+
@@ -0,0 +1,299 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "host/eeprom-sim.h"
+#include "host/host.h"
+
+// Bit level model of a 24C64 on the bit-banged I2C bus. It sees the same
+// pin changes the real part would, so the firmware's i2c.c and eeprom.c run
+// unchanged on top of it, including page wrap, write cycle NAKs and
+// sequential reads across page boundaries.
+
+typedef enum {
+	BUS_IDLE,
+	BUS_ADDRESS,
+	BUS_WORD_HIGH,
+	BUS_WORD_LOW,
+	BUS_WRITE,
+	BUS_READ,
+	BUS_IGNORE,
+} BusState_t;
+
+static struct {
+	BusState_t State;
+	BusState_t Next;
+	bool bScl;
+	bool bSda;
+	// Level the EEPROM drives SDA to, true while it lets go of the line.
+	bool bDrive;
+	bool bMasterAck;
+	// Rising SCL edges seen in the current byte, the 9th is the ACK.
+	uint8_t Bit;
+	uint8_t Shift;
+	uint16_t Address;
+	uint16_t Page;
+	uint8_t Latch[EESIM_PAGE_SIZE];
+	uint32_t Latched;
+	uint64_t BusyUntil;
+} gBus;
+
+EESIM_t *gEesim;
+
+void EESIM_Init(void)
+{
+	gEesim = mmap(NULL, sizeof(*gEesim), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (gEesim == MAP_FAILED) {
+		perror("EESIM_Init");
+		exit(1);
+	}
+}
+
+void EESIM_ResetCounters(void)
+{
+	memset(gEesim->PageWrites, 0, sizeof(gEesim->PageWrites));
+	gEesim->Programs = 0;
+	gEesim->BytesProgrammed = 0;
+	gEesim->BusyNacks = 0;
+}
+
+void EESIM_Reset(uint8_t Fill)
+{
+	memset(gEesim->Memory, Fill, sizeof(gEesim->Memory));
+	EESIM_ResetCounters();
+	gEesim->ProgramsBeforeCut = -1;
+	memset(&gBus, 0, sizeof(gBus));
+	gBus.State = BUS_IDLE;
+	gBus.bScl = true;
+	gBus.bSda = true;
+	gBus.bDrive = true;
+}
+
+// Lets Programs more page writes through and then loses power half way
+// through the next one, which leaves each of its bytes old, new or garbage.
+// The process exits there, so only call this from a HOST_Fork child.
+void EESIM_CutPower(uint32_t Programs, uint32_t Seed)
+{
+	gEesim->ProgramsBeforeCut = (int32_t)Programs;
+	gEesim->CutSeed = Seed;
+}
+
+bool EESIM_IsBusy(void)
+{
+	return gHostMicroseconds < gBus.BusyUntil;
+}
+
+static uint32_t Random(uint32_t *pState)
+{
+	*pState ^= *pState << 13;
+	*pState ^= *pState >> 17;
+	*pState ^= *pState << 5;
+
+	return *pState;
+}
+
+static void Program(void)
+{
+	const bool bTorn = gEesim->ProgramsBeforeCut == 0;
+	uint32_t Seed = gEesim->CutSeed | 1U;
+	uint8_t i;
+
+	for (i = 0; i < EESIM_PAGE_SIZE; i++) {
+		uint8_t *pByte = &gEesim->Memory[gBus.Page + i];
+
+		if ((gBus.Latched & (1U << i)) == 0) {
+			continue;
+		}
+		if (!bTorn) {
+			*pByte = gBus.Latch[i];
+		} else {
+			switch (Random(&Seed) % 3) {
+			case 0: break;
+			case 1: *pByte = gBus.Latch[i]; break;
+			default: *pByte = (uint8_t)Random(&Seed); break;
+			}
+		}
+		gEesim->BytesProgrammed++;
+	}
+	gEesim->PageWrites[gBus.Page / EESIM_PAGE_SIZE]++;
+	gEesim->Programs++;
+	gBus.BusyUntil = gHostMicroseconds + EESIM_WRITE_CYCLE_US;
+
+	if (bTorn) {
+		gEesim->ProgramsBeforeCut = -1;
+		_exit(HOST_EXIT_POWER_CUT);
+	}
+	if (gEesim->ProgramsBeforeCut > 0) {
+		gEesim->ProgramsBeforeCut--;
+	}
+}
+
+static void Start(void)
+{
+	// A write only starts on STOP, a repeated START drops the latch.
+	gBus.State = BUS_ADDRESS;
+	gBus.Bit = 0;
+	gBus.bDrive = true;
+}
+
+static void Stop(void)
+{
+	if (gBus.State == BUS_WRITE && gBus.Latched) {
+		Program();
+	}
+	gBus.State = BUS_IDLE;
+	gBus.bDrive = true;
+}
+
+static void LoadReadByte(void)
+{
+	gBus.Shift = gEesim->Memory[gBus.Address];
+	gBus.Address = (gBus.Address + 1U) % EESIM_SIZE;
+	gBus.Bit = 0;
+	gBus.bDrive = (gBus.Shift >> 7) & 1U;
+}
+
+// Decides what to do with a received byte, and whether to ACK it, on the
+// falling edge after its 8th bit.
+static bool Receive(uint8_t Byte)
+{
+	switch (gBus.State) {
+	case BUS_ADDRESS:
+		if ((Byte & 0xFEU) != EESIM_ADDRESS) {
+			gBus.Next = BUS_IGNORE;
+			return false;
+		}
+		if (EESIM_IsBusy()) {
+			gEesim->BusyNacks++;
+			gBus.Next = BUS_IGNORE;
+			return false;
+		}
+		gBus.Next = (Byte & 1U) ? BUS_READ : BUS_WORD_HIGH;
+		return true;
+
+	case BUS_WORD_HIGH:
+		gBus.Address = (uint16_t)((Byte << 8) % EESIM_SIZE);
+		gBus.Next = BUS_WORD_LOW;
+		return true;
+
+	case BUS_WORD_LOW:
+		gBus.Address |= Byte;
+		gBus.Page = gBus.Address & ~(EESIM_PAGE_SIZE - 1U);
+		gBus.Latched = 0;
+		gBus.Next = BUS_WRITE;
+		return true;
+
+	case BUS_WRITE:
+		gBus.Latch[gBus.Address % EESIM_PAGE_SIZE] = Byte;
+		gBus.Latched |= 1U << (gBus.Address % EESIM_PAGE_SIZE);
+		gBus.Address = gBus.Page | ((gBus.Address + 1U) % EESIM_PAGE_SIZE);
+		gBus.Next = BUS_WRITE;
+		return true;
+
+	default:
+		gBus.Next = BUS_IGNORE;
+		return false;
+	}
+}
+
+static void Rising(bool bSda)
+{
+	switch (gBus.State) {
+	case BUS_IDLE:
+	case BUS_IGNORE:
+		break;
+
+	case BUS_READ:
+		gBus.Bit++;
+		if (gBus.Bit == 9) {
+			gBus.bMasterAck = !bSda;
+		}
+		break;
+
+	default:
+		gBus.Bit++;
+		if (gBus.Bit <= 8) {
+			gBus.Shift = (uint8_t)((gBus.Shift << 1) | bSda);
+		}
+		break;
+	}
+}
+
+static void Falling(void)
+{
+	switch (gBus.State) {
+	case BUS_IDLE:
+	case BUS_IGNORE:
+		break;
+
+	case BUS_READ:
+		if (gBus.Bit < 8) {
+			gBus.bDrive = (gBus.Shift >> (7 - gBus.Bit)) & 1U;
+		} else if (gBus.Bit == 8) {
+			gBus.bDrive = true;
+		} else if (gBus.bMasterAck) {
+			LoadReadByte();
+		} else {
+			gBus.State = BUS_IGNORE;
+		}
+		break;
+
+	default:
+		if (gBus.Bit == 8) {
+			gBus.bDrive = !Receive(gBus.Shift);
+		} else if (gBus.Bit == 9) {
+			gBus.bDrive = true;
+			gBus.Bit = 0;
+			gBus.State = gBus.Next;
+			if (gBus.State == BUS_READ) {
+				LoadReadByte();
+			}
+		}
+		break;
+	}
+}
+
+// Called with the levels the firmware drives after every pin change. The
+// SDA the bus sees is the wired AND of both ends.
+void EESIM_Bus(bool bScl, bool bSda)
+{
+	const bool bLine = bSda && gBus.bDrive;
+
+	if (bScl && gBus.bScl && bLine != gBus.bSda) {
+		if (!bLine) {
+			Start();
+		} else {
+			Stop();
+		}
+	} else if (bScl && !gBus.bScl) {
+		Rising(bLine);
+	} else if (!bScl && gBus.bScl) {
+		Falling();
+	}
+
+	gBus.bScl = bScl;
+	gBus.bSda = bSda && gBus.bDrive;
+}
+
+bool EESIM_GetSda(void)
+{
+	return gBus.bDrive;
+}
+
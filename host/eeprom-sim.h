@@ -0,0 +1,54 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef HOST_EEPROM_SIM_H
+#define HOST_EEPROM_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define EESIM_SIZE		0x2000U
+#define EESIM_PAGE_SIZE		32U
+#define EESIM_ADDRESS		0xA0U
+
+// The 24C64 is rated for a 5 ms write cycle at worst. Real parts usually
+// finish sooner, so latencies measured against this are upper bounds.
+#define EESIM_WRITE_CYCLE_US	5000U
+
+// Lives in shared memory so that forked runs, which is how the power cut
+// tests reboot, all see the same chip.
+typedef struct {
+	uint8_t Memory[EESIM_SIZE];
+	uint16_t PageWrites[EESIM_SIZE / EESIM_PAGE_SIZE];
+	uint32_t Programs;
+	uint32_t BytesProgrammed;
+	uint32_t BusyNacks;
+	int32_t ProgramsBeforeCut;
+	uint32_t CutSeed;
+} EESIM_t;
+
+extern EESIM_t *gEesim;
+
+void EESIM_Init(void);
+void EESIM_Reset(uint8_t Fill);
+void EESIM_ResetCounters(void);
+void EESIM_CutPower(uint32_t Programs, uint32_t Seed);
+void EESIM_Bus(bool bScl, bool bSda);
+bool EESIM_GetSda(void);
+bool EESIM_IsBusy(void);
+
+#endif
+
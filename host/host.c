@@ -0,0 +1,246 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "ARMCM0.h"
+#include "app/app.h"
+#if defined(ENABLE_SCAN_HISTORY)
+#include "app/history.h"
+#endif
+#include "board.h"
+#include "driver/bk4819.h"
+#include "driver/st7565.h"
+#include "bsp/dp32g030/saradc.h"
+#if defined(ENABLE_UART)
+#include "driver/uart.h"
+#endif
+#include "host/bk4819-sim.h"
+#include "host/dma-sim.h"
+#include "host/eeprom-sim.h"
+#include "host/host.h"
+#include "host/test.h"
+#if defined(ENABLE_EEPROM_INTEGRITY)
+#include "integrity.h"
+#endif
+#if defined(ENABLE_EEPROM_JOURNAL)
+#include "journal.h"
+#endif
+#include "misc.h"
+#include "radio.h"
+#include "settings.h"
+
+// All DP32G030 peripherals sit in this window. Mapping plain memory there
+// lets the bsp headers and the drivers that only poke registers build and
+// run unchanged. Drivers that wait on the hardware have host versions.
+#define PERIPHERAL_BASE		0x40000000UL
+#define PERIPHERAL_SIZE		0x00100000UL
+
+#define SYSTICK_PERIOD_US	10000U
+
+// Simulated time one pass of the main loop takes when it has nothing to do.
+#define MAIN_LOOP_PASS_US	100U
+
+SysTick_Type gHostSysTick;
+uint32_t gHostEnabledIrqs;
+
+uint64_t gHostMicroseconds;
+bool gHostSysTickEnabled;
+bool gHostResetRequested;
+KEY_Code_t gHostKey;
+bool gHostPttPressed;
+
+void SystickHandler(void);
+
+void NVIC_SystemReset(void)
+{
+	gHostResetRequested = true;
+}
+
+void HOST_Init(void)
+{
+	void *pRegisters;
+
+	pRegisters = mmap((void *)PERIPHERAL_BASE, PERIPHERAL_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+	if (pRegisters != (void *)PERIPHERAL_BASE) {
+		perror("HOST_Init");
+		exit(1);
+	}
+	EESIM_Init();
+}
+
+// Starts a test from power on: registers at zero, a blank EEPROM and the
+// board brought up the way BOARD_Init does it on the radio.
+void HOST_Reset(void)
+{
+	volatile ADC_Channel_t *pChannels = (volatile ADC_Channel_t *)&SARADC_CH0;
+
+	memset((void *)PERIPHERAL_BASE, 0, PERIPHERAL_SIZE);
+	memset(&gHostSysTick, 0, sizeof(gHostSysTick));
+	gHostEnabledIrqs = 0;
+	gHostMicroseconds = 0;
+	gHostSysTickEnabled = false;
+	gHostResetRequested = false;
+	gHostKey = KEY_INVALID;
+	gHostPttPressed = false;
+#if defined(ENABLE_UART)
+	gHostUartOutputSize = 0;
+#endif
+	EESIM_Reset(0xFF);
+	BKSIM_Reset();
+	DMASIM_Reset();
+
+	// Conversions are always done, at a reading in the middle of the range.
+	pChannels[4].STAT = ADC_CHx_STAT_EOC_MASK;
+	pChannels[4].DATA = 2000;
+	pChannels[9].STAT = ADC_CHx_STAT_EOC_MASK;
+	pChannels[9].DATA = 0;
+
+	BOARD_Init();
+}
+
+// The part of Main that loads the settings and tunes the radio, without the
+// welcome screen and the battery checks.
+void HOST_Boot(void)
+{
+#if defined(ENABLE_UART)
+	UART_Init();
+#endif
+	memset(&gEeprom, 0, sizeof(gEeprom));
+	BK4819_Init();
+#if defined(ENABLE_EEPROM_JOURNAL)
+	JOURNAL_Replay();
+#endif
+#if defined(ENABLE_EEPROM_INTEGRITY)
+	INTEGRITY_Load();
+#endif
+	BOARD_EEPROM_Init();
+	BOARD_EEPROM_LoadCalibration();
+#if defined(ENABLE_SCAN_HISTORY)
+	HISTORY_Load();
+#endif
+	gMenuListCount = 49;
+#if defined(ENABLE_ALARM)
+	gMenuListCount++;
+#endif
+#if defined(ENABLE_NOAA)
+	gMenuListCount++;
+#endif
+	RADIO_ConfigureChannel(0, 2);
+	RADIO_ConfigureChannel(1, 2);
+	RADIO_SelectVfos();
+	RADIO_SetupRegisters(true);
+}
+
+// Moves the simulated clock on. With gHostSysTickEnabled the 10 ms SysTick
+// interrupt fires on the way, as it would in the middle of a busy wait.
+void HOST_Advance(uint32_t Microseconds)
+{
+	while (Microseconds) {
+		uint32_t Step = SYSTICK_PERIOD_US - (gHostMicroseconds % SYSTICK_PERIOD_US);
+
+		if (Step > Microseconds) {
+			Step = Microseconds;
+		}
+		gHostMicroseconds += Step;
+		Microseconds -= Step;
+		if (gHostSysTickEnabled && (gHostMicroseconds % SYSTICK_PERIOD_US) == 0) {
+			SystickHandler();
+		}
+	}
+	gHostSysTick.VAL = (SYSTICK_PERIOD_US - 1U - (gHostMicroseconds % SYSTICK_PERIOD_US)) * 48U;
+}
+
+// The main loop of Main, with SysTick running, until Microseconds have gone
+// by. Returns the longest any pass took, so that a test can tell a busy
+// wait from work spread over the time slices.
+uint32_t HOST_Run(uint32_t Microseconds)
+{
+	const uint64_t End = gHostMicroseconds + Microseconds;
+	uint32_t Longest = 0;
+
+	gHostSysTickEnabled = true;
+	while (gHostMicroseconds < End) {
+		const uint64_t Start = gHostMicroseconds;
+
+#if defined(ENABLE_DISPLAY_DMA)
+		ST7565_ServiceBlit();
+#endif
+		APP_Update();
+		if (gNextTimeslice) {
+			APP_TimeSlice10ms();
+			gNextTimeslice = false;
+		}
+		if (gNextTimeslice500ms) {
+			APP_TimeSlice500ms();
+			gNextTimeslice500ms = false;
+		}
+		if (gHostMicroseconds - Start > Longest) {
+			Longest = gHostMicroseconds - Start;
+		}
+		HOST_Advance(MAIN_LOOP_PASS_US);
+	}
+
+	return Longest;
+}
+
+// Runs pFunc in a child process, on a copy of this process' RAM but the
+// same EEPROM. Returns the child's exit status, which is non zero if any
+// check in it failed.
+int HOST_Fork(void (*pFunc)(void *), void *pContext)
+{
+	pid_t Child;
+	int Status;
+
+	fflush(stdout);
+	fflush(stderr);
+	Child = fork();
+	if (Child < 0) {
+		perror("HOST_Fork");
+		exit(1);
+	}
+	if (Child == 0) {
+		DMASIM_Start();
+		pFunc(pContext);
+		fflush(stdout);
+		fflush(stderr);
+		_exit(gTestFailures ? 1 : 0);
+	}
+	if (waitpid(Child, &Status, 0) < 0) {
+		perror("HOST_Fork");
+		exit(1);
+	}
+	if (WIFEXITED(Status)) {
+		return WEXITSTATUS(Status);
+	}
+
+	return 128 + WTERMSIG(Status);
+}
+
+uint64_t HOST_GetNanoseconds(void)
+{
+	struct timespec Now;
+
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+
+	return ((uint64_t)Now.tv_sec * 1000000000U) + (uint64_t)Now.tv_nsec;
+}
+
@@ -0,0 +1,46 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef HOST_HOST_H
+#define HOST_HOST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driver/keyboard.h"
+
+// Exit status of a forked run that lost power part way through a write.
+#define HOST_EXIT_POWER_CUT 42
+
+extern uint64_t gHostMicroseconds;
+extern bool gHostSysTickEnabled;
+extern bool gHostResetRequested;
+extern KEY_Code_t gHostKey;
+extern bool gHostPttPressed;
+
+extern uint8_t gHostUartOutput[4096];
+extern uint16_t gHostUartOutputSize;
+
+void HOST_Init(void);
+void HOST_Reset(void);
+void HOST_Boot(void);
+void HOST_Advance(uint32_t Microseconds);
+uint32_t HOST_Run(uint32_t Microseconds);
+int HOST_Fork(void (*pFunc)(void *), void *pContext);
+uint64_t HOST_GetNanoseconds(void);
+void HOST_UartReceive(const void *pData, uint16_t Size);
+
+#endif
+
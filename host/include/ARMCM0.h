@@ -0,0 +1,78 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef HOST_ARMCM0_H
+#define HOST_ARMCM0_H
+
+#include <stdint.h>
+
+// Just the parts of CMSIS the firmware uses. The host has no interrupts to
+// mask, NVIC state is only recorded, and SysTick is plain memory that the
+// simulated clock keeps up to date.
+
+typedef int IRQn_Type;
+
+typedef struct {
+	volatile uint32_t CTRL;
+	volatile uint32_t LOAD;
+	volatile uint32_t VAL;
+	volatile uint32_t CALIB;
+} SysTick_Type;
+
+extern SysTick_Type gHostSysTick;
+extern uint32_t gHostEnabledIrqs;
+
+#define SysTick (&gHostSysTick)
+
+static inline void __disable_irq(void)
+{
+}
+
+static inline void __enable_irq(void)
+{
+}
+
+static inline void __NOP(void)
+{
+}
+
+static inline void __DSB(void)
+{
+}
+
+static inline void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	gHostEnabledIrqs |= 1U << IRQn;
+}
+
+static inline void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+	gHostEnabledIrqs &= ~(1U << IRQn);
+}
+
+void NVIC_SystemReset(void);
+
+static inline uint32_t SysTick_Config(uint32_t Ticks)
+{
+	SysTick->LOAD = Ticks - 1U;
+	SysTick->VAL = 0;
+	SysTick->CTRL = 7;
+
+	return 0;
+}
+
+#endif
+
@@ -0,0 +1,54 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef HOST_I2C_PINS_H
+#define HOST_I2C_PINS_H
+
+#include <stdint.h>
+#include "bsp/dp32g030/gpio.h"
+#include "driver/gpio.h"
+
+// The fast I2C driver's pins through the GPIO driver, whose host version
+// passes every edge on to the EEPROM model. The spin loops between the
+// edges take no simulated time.
+
+static inline void I2C_SclHigh(void)
+{
+	GPIO_SetBit(&GPIOA->DATA, GPIOA_PIN_I2C_SCL);
+}
+
+static inline void I2C_SclLow(void)
+{
+	GPIO_ClearBit(&GPIOA->DATA, GPIOA_PIN_I2C_SCL);
+}
+
+static inline void I2C_SdaHigh(void)
+{
+	GPIO_SetBit(&GPIOA->DATA, GPIOA_PIN_I2C_SDA);
+}
+
+static inline void I2C_SdaLow(void)
+{
+	GPIO_ClearBit(&GPIOA->DATA, GPIOA_PIN_I2C_SDA);
+}
+
+static inline uint8_t I2C_SdaRead(void)
+{
+	return GPIO_CheckBit(&GPIOA->DATA, GPIOA_PIN_I2C_SDA);
+}
+
+#endif
+
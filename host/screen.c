@@ -0,0 +1,127 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "driver/st7565.h"
+#include "host/screen.h"
+#include "host/test.h"
+
+bool SCREEN_GetPixel(uint8_t X, uint8_t Y)
+{
+	const uint8_t *pPage;
+
+	if (Y < 8) {
+		pPage = gStatusLine;
+	} else {
+		pPage = gFrameBuffer[(Y / 8) - 1];
+	}
+
+	return (pPage[X] >> (Y % 8)) & 1U;
+}
+
+bool SCREEN_Write(const char *pPath)
+{
+	FILE *pFile;
+	uint8_t X, Y;
+
+	pFile = fopen(pPath, "w");
+	if (!pFile) {
+		perror(pPath);
+		return false;
+	}
+	fprintf(pFile, "P1\n%u %u\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+	for (Y = 0; Y < SCREEN_HEIGHT; Y++) {
+		for (X = 0; X < SCREEN_WIDTH; X++) {
+			fputc(SCREEN_GetPixel(X, Y) ? '1' : '0', pFile);
+		}
+		fputc('\n', pFile);
+	}
+
+	return fclose(pFile) == 0;
+}
+
+// Plain PBM allows any whitespace between the pixels, and comments.
+static int ReadToken(FILE *pFile)
+{
+	int c;
+
+	while (1) {
+		c = fgetc(pFile);
+		if (c == '#') {
+			while (c != '\n' && c != EOF) {
+				c = fgetc(pFile);
+			}
+		} else if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+			return c;
+		}
+	}
+}
+
+int32_t SCREEN_Compare(const char *pPath)
+{
+	unsigned int Width, Height;
+	int32_t Differences = 0;
+	FILE *pFile;
+	uint8_t X, Y;
+
+	pFile = fopen(pPath, "r");
+	if (!pFile) {
+		perror(pPath);
+		return -1;
+	}
+	if (fscanf(pFile, "P1 %u %u", &Width, &Height) != 2 || Width != SCREEN_WIDTH || Height != SCREEN_HEIGHT) {
+		fclose(pFile);
+		return -1;
+	}
+	for (Y = 0; Y < SCREEN_HEIGHT; Y++) {
+		for (X = 0; X < SCREEN_WIDTH; X++) {
+			const int c = ReadToken(pFile);
+
+			if (c != '0' && c != '1') {
+				fclose(pFile);
+				return -1;
+			}
+			if ((c == '1') != SCREEN_GetPixel(X, Y)) {
+				Differences++;
+			}
+		}
+	}
+	fclose(pFile);
+
+	return Differences;
+}
+
+void SCREEN_Check(const char *pName)
+{
+	const char *pDirectory = getenv("HOST_SCREENS");
+	char Path[256];
+	int32_t Differences;
+
+	if (pDirectory) {
+		snprintf(Path, sizeof(Path), "%s/%s.pbm", pDirectory, pName);
+		CHECK(SCREEN_Write(Path));
+		return;
+	}
+
+	snprintf(Path, sizeof(Path), "host/golden/%s.pbm", pName);
+	Differences = SCREEN_Compare(Path);
+	if (Differences) {
+		printf("  %s: %d pixels differ from %s\n", pName, (int)Differences, Path);
+	}
+	CHECK_EQUAL(0, Differences);
+}
+
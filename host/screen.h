@@ -0,0 +1,38 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef HOST_SCREEN_H
+#define HOST_SCREEN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// The 128x64 glass as gStatusLine over gFrameBuffer, in the plain PBM that
+// tools/screen-dump.py writes, so host images and radio captures compare.
+#define SCREEN_WIDTH	128U
+#define SCREEN_HEIGHT	64U
+
+bool SCREEN_GetPixel(uint8_t X, uint8_t Y);
+bool SCREEN_Write(const char *pPath);
+// Returns the number of pixels that differ from the image at pPath, or -1
+// when it cannot be read.
+int32_t SCREEN_Compare(const char *pPath);
+// Fails the test unless the screen matches host/golden/<pName>.pbm. With
+// HOST_SCREENS set, writes the screen to that directory instead.
+void SCREEN_Check(const char *pName);
+
+#endif
+
@@ -0,0 +1,132 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host/host.h"
+#include "host/test.h"
+
+#define MAX_TESTS	256U
+#define MAX_REPORTS	20U
+
+typedef struct {
+	const char *pName;
+	TEST_Function_t Function;
+	bool bIsBenchmark;
+} Test_t;
+
+static Test_t gTests[MAX_TESTS];
+static uint16_t gTestCount;
+
+uint32_t gTestFailures;
+
+void TEST_Register(const char *pName, TEST_Function_t Function, bool bIsBenchmark)
+{
+	if (gTestCount == MAX_TESTS) {
+		fprintf(stderr, "Too many tests, raise MAX_TESTS\n");
+		exit(1);
+	}
+	gTests[gTestCount].pName = pName;
+	gTests[gTestCount].Function = Function;
+	gTests[gTestCount].bIsBenchmark = bIsBenchmark;
+	gTestCount++;
+}
+
+void TEST_Fail(const char *pFile, int Line, const char *pExpression)
+{
+	if (gTestFailures++ < MAX_REPORTS) {
+		printf("  %s:%d: CHECK(%s) failed\n", pFile, Line, pExpression);
+	}
+}
+
+void TEST_FailEqual(const char *pFile, int Line, const char *pExpression, long long Expected, long long Actual)
+{
+	if (gTestFailures++ < MAX_REPORTS) {
+		printf("  %s:%d: %s is %lld, expected %lld\n", pFile, Line, pExpression, Actual, Expected);
+	}
+}
+
+static void RunTest(void *pContext)
+{
+	const Test_t *pTest = (const Test_t *)pContext;
+
+	HOST_Reset();
+	pTest->Function();
+}
+
+static bool IsSelected(const Test_t *pTest, bool bBenchmarks, int argc, char **argv)
+{
+	int i;
+
+	if (pTest->bIsBenchmark != bBenchmarks) {
+		return false;
+	}
+	if (argc == 0) {
+		return true;
+	}
+	for (i = 0; i < argc; i++) {
+		if (strstr(pTest->pName, argv[i])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Usage: tests [--bench] [name filter...]
+int main(int argc, char **argv)
+{
+	bool bBenchmarks = false;
+	uint16_t Run = 0;
+	uint16_t Failed = 0;
+	uint16_t i;
+
+	setvbuf(stdout, NULL, _IOLBF, 0);
+	argc--;
+	argv++;
+	if (argc && strcmp(argv[0], "--bench") == 0) {
+		bBenchmarks = true;
+		argc--;
+		argv++;
+	}
+
+	HOST_Init();
+
+	for (i = 0; i < gTestCount; i++) {
+		const Test_t *pTest = &gTests[i];
+		uint64_t Start;
+		int Status;
+
+		if (!IsSelected(pTest, bBenchmarks, argc, argv)) {
+			continue;
+		}
+		Start = HOST_GetNanoseconds();
+		Status = HOST_Fork(RunTest, (void *)pTest);
+		Run++;
+		if (Status) {
+			Failed++;
+			printf("FAIL %s (status %d)\n", pTest->pName, Status);
+		} else {
+			printf("ok   %s (%u ms)\n", pTest->pName, (unsigned int)((HOST_GetNanoseconds() - Start) / 1000000U));
+		}
+	}
+
+	printf("%u run, %u failed\n", Run, Failed);
+
+	return Failed != 0;
+}
+
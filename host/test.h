@@ -0,0 +1,61 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef void (*TEST_Function_t)(void);
+
+extern uint32_t gTestFailures;
+
+void TEST_Register(const char *pName, TEST_Function_t Function, bool bIsBenchmark);
+void TEST_Fail(const char *pFile, int Line, const char *pExpression);
+void TEST_FailEqual(const char *pFile, int Line, const char *pExpression, long long Expected, long long Actual);
+
+// Tests and benchmarks register themselves before main runs. Each one gets
+// a fresh process, so firmware state never leaks from one to the next.
+#define TEST_DEFINE(Name, bIsBenchmark)					\
+	static void Name(void);						\
+	static void __attribute__((constructor)) Register_##Name(void)	\
+	{								\
+		TEST_Register(#Name, Name, bIsBenchmark);		\
+	}								\
+	static void Name(void)
+
+#define TEST(Name)	TEST_DEFINE(Name, false)
+#define BENCH(Name)	TEST_DEFINE(Name, true)
+
+#define CHECK(Expression)						\
+	do {								\
+		if (!(Expression)) {					\
+			TEST_Fail(__FILE__, __LINE__, #Expression);	\
+		}							\
+	} while (0)
+
+#define CHECK_EQUAL(Expected, Actual)					\
+	do {								\
+		const long long Expected_ = (long long)(Expected);	\
+		const long long Actual_ = (long long)(Actual);		\
+		if (Expected_ != Actual_) {				\
+			TEST_FailEqual(__FILE__, __LINE__, #Actual, Expected_, Actual_); \
+		}							\
+	} while (0)
+
+#endif
+
@@ -0,0 +1,55 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+#include "driver/aes.h"
+#include "host/test.h"
+
+#if defined(ENABLE_UART)
+// The host AES stands in for the DP32G030 unit, so it is held to the
+// FIPS-197 example before the UART tests rely on it.
+
+TEST(AesMatchesFips197)
+{
+	static const uint8_t Key[16] = {
+		0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+	};
+	static const uint8_t Plain[16] = {
+		0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+		0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF,
+	};
+	static const uint8_t Cipher[16] = {
+		0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30,
+		0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A,
+	};
+	const uint8_t Iv[16] = { 0 };
+	uint8_t Out[32];
+	uint8_t In[32];
+
+	AES_Encrypt(Key, Iv, Plain, Out, 1);
+	CHECK(memcmp(Out, Cipher, sizeof(Cipher)) == 0);
+
+	// CBC: the second block is chained on the first ciphertext.
+	memcpy(In, Plain, 16);
+	memcpy(In + 16, Plain, 16);
+	AES_Encrypt(Key, Iv, In, Out, 2);
+	CHECK(memcmp(Out, Cipher, sizeof(Cipher)) == 0);
+	AES_Encrypt(Key, Cipher, Plain, In, 1);
+	CHECK(memcmp(Out + 16, In, 16) == 0);
+}
+#endif
+
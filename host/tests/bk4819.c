@@ -0,0 +1,212 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "app/app.h"
+#include "driver/bk4819.h"
+#include "driver/systick.h"
+#include "host/bk4819-sim.h"
+#include "host/host.h"
+#include "host/test.h"
+#include "misc.h"
+#include "radio.h"
+
+// The radio paths against the BK4819 model. Everything goes through the
+// bit-banged bus, so the simulated time of each step is what the same
+// register traffic costs on the radio.
+
+static uint16_t GetStrongRssi(void)
+{
+	return gRxVfo->SquelchOpenRSSI + 40U;
+}
+
+TEST(RadioSetupRegistersTunesTheReceiver)
+{
+	HOST_Boot();
+
+	CHECK_EQUAL(gRxVfo->pRX->Frequency, BKSIM_GetFrequency());
+	CHECK_EQUAL((gRxVfo->SquelchOpenRSSI << 8) | gRxVfo->SquelchCloseRSSI, gBksim.Registers[BK4819_REG_78]);
+	CHECK_EQUAL((gRxVfo->SquelchCloseNoise << 8) | gRxVfo->SquelchOpenNoise, gBksim.Registers[BK4819_REG_4F]);
+	CHECK(gBksim.Registers[BK4819_REG_30] & BK4819_REG_30_MASK_ENABLE_RX_DSP);
+	CHECK(gBksim.Registers[BK4819_REG_3F] & BK4819_REG_3F_SQUELCH_FOUND);
+	CHECK(gBksim.Registers[BK4819_REG_3F] & BK4819_REG_3F_SQUELCH_LOST);
+
+	// Stale requests from the previous channel are drained on a retune.
+	BKSIM_Interrupt(BK4819_REG_02_SQUELCH_FOUND);
+	CHECK(gBksim.Pending != 0);
+	RADIO_SetupRegisters(false);
+	CHECK_EQUAL(0, gBksim.Pending);
+}
+
+TEST(SquelchFollowsACarrier)
+{
+	uint64_t Start;
+
+	HOST_Boot();
+	Start = gHostMicroseconds;
+	BKSIM_AddSignal(gRxVfo->pRX->Frequency, Start + 20000, Start + 120000, GetStrongRssi());
+	// Another channel's carrier must not open the squelch.
+	BKSIM_AddSignal(gRxVfo->pRX->Frequency + 2500, Start, Start + 200000, GetStrongRssi());
+
+	// g_SquelchLost is set while there is something to listen to.
+	g_SquelchLost = false;
+	HOST_Advance(10000);
+	APP_CheckRadioInterrupts();
+	CHECK(!g_SquelchLost);
+
+	HOST_Advance(20000);
+	APP_CheckRadioInterrupts();
+	CHECK(g_SquelchLost);
+	CHECK_EQUAL(GetStrongRssi(), BK4819_GetRSSI());
+
+	HOST_Advance(100000);
+	APP_CheckRadioInterrupts();
+	CHECK(!g_SquelchLost);
+	CHECK_EQUAL(BKSIM_FLOOR_RSSI, BK4819_GetRSSI());
+}
+
+#if defined(ENABLE_MODEM)
+static void ConfigureModem(void)
+{
+	BK4819_ModemParams Params;
+
+	memset(&Params, 0, sizeof(Params));
+	Params.BaudRate = 1200;
+	Params.PreambleLength = BK4819_REG_59_FSK_PREAMBLE_LENGTH_7B;
+	Params.SyncLength = BK4819_REG_59_FSK_SYNC_LENGTH_2B;
+	Params.SyncBytes[0] = 0x55;
+	Params.SyncBytes[1] = 0x44;
+	BK4819_ConfigureFSK(&Params);
+}
+
+TEST(FskTransmitWaitsForTheAirtime)
+{
+	BK4819_ModemParams Params;
+	uint8_t Data[20];
+	uint64_t Airtime;
+	uint64_t Start;
+	uint8_t i;
+
+	BK4819_Init();
+	ConfigureModem();
+	memset(&Params, 0, sizeof(Params));
+	Params.BaudRate = 1200;
+	for (i = 0; i < sizeof(Data); i++) {
+		Data[i] = i * 13;
+	}
+
+	Start = gHostMicroseconds;
+	BK4819_StartTransmitFSK(&Params, Data, sizeof(Data));
+
+	// 7 bytes of preamble, 2 of sync, then the length REG_5D asks for.
+	Airtime = ((7 + 2 + sizeof(Data) + 1) * 8 * 1000000ULL) / 1200;
+	CHECK(gHostMicroseconds - Start >= Airtime);
+	CHECK(gHostMicroseconds - Start < Airtime + 5000);
+	CHECK_EQUAL(1, gBksim.TxPackets);
+	CHECK_EQUAL(sizeof(Data) / 2, gBksim.SentCount);
+	for (i = 0; i < gBksim.SentCount; i++) {
+		CHECK_EQUAL((Data[i * 2] << 8) | Data[(i * 2) + 1], gBksim.Sent[i]);
+	}
+	CHECK_EQUAL(0, gBksim.Pending);
+	CHECK_EQUAL(0, gBksim.Registers[BK4819_REG_59] & BK4819_REG_59_MASK_FSK_ENABLE_TX);
+}
+
+TEST(FskReceiveRaisesFifoInterrupts)
+{
+	uint16_t Words[16];
+	uint16_t Received[16];
+	uint8_t Count = 0;
+	uint8_t AlmostFull = 0;
+	bool bSynced = false;
+	bool bFinished = false;
+	uint16_t Timeout;
+	uint8_t i;
+
+	for (i = 0; i < 16; i++) {
+		Words[i] = 0x1000U * i + i;
+	}
+
+	BK4819_Init();
+	ConfigureModem();
+	BK4819_WriteRegister(BK4819_REG_3F, 0
+		| BK4819_REG_3F_FSK_RX_SYNC
+		| BK4819_REG_3F_FSK_FIFO_ALMOST_FULL
+		| BK4819_REG_3F_FSK_RX_FINISHED
+		);
+	BK4819_WriteRegister(BK4819_REG_59, BK4819_ReadRegister(BK4819_REG_59) | BK4819_REG_59_FSK_ENABLE_RX);
+	BKSIM_AddPacket(gHostMicroseconds + 1000, Words, 16);
+
+	// The way APP_CheckRadioInterrupts would serve it, every millisecond.
+	for (Timeout = 0; Timeout < 1000 && !bFinished; Timeout++) {
+		while (BK4819_ReadRegister(BK4819_REG_0C) & 1U) {
+			uint16_t Mask;
+
+			BK4819_WriteRegister(BK4819_REG_02, 0);
+			Mask = BK4819_ReadRegister(BK4819_REG_02);
+			if (Mask & BK4819_REG_02_FSK_RX_SYNC) {
+				bSynced = true;
+			}
+			if (Mask & BK4819_REG_02_FSK_FIFO_ALMOST_FULL) {
+				AlmostFull++;
+				for (i = 0; i < BKSIM_RX_ALMOST_FULL && Count < 16; i++) {
+					Received[Count++] = BK4819_ReadRegister(BK4819_REG_5F);
+				}
+			}
+			if (Mask & BK4819_REG_02_FSK_RX_FINISHED) {
+				bFinished = true;
+			}
+		}
+		SYSTICK_DelayUs(1000);
+	}
+
+	CHECK(bSynced);
+	CHECK(bFinished);
+	CHECK_EQUAL(16 / BKSIM_RX_ALMOST_FULL, AlmostFull);
+	CHECK_EQUAL(16, Count);
+	CHECK(memcmp(Received, Words, sizeof(Words)) == 0);
+	CHECK_EQUAL(0, gBksim.RxOverflows);
+}
+#endif
+
+// One step of a frequency scan, as FREQ_NextChannel makes it.
+BENCH(ScanStep)
+{
+	const uint32_t Steps = 100;
+	uint64_t Start;
+	uint64_t HostStart;
+	uint32_t Writes;
+	uint32_t Reads;
+	uint32_t i;
+
+	HOST_Boot();
+	Writes = gBksim.Writes;
+	Reads = gBksim.Reads;
+	Start = gHostMicroseconds;
+	HostStart = HOST_GetNanoseconds();
+	for (i = 0; i < Steps; i++) {
+		APP_SetFrequencyByStep(gRxVfo, 1);
+		RADIO_ApplyOffset(gRxVfo);
+		RADIO_ConfigureSquelchAndOutputPower(gRxVfo);
+		RADIO_SetupRegisters(true);
+	}
+	printf("  %u us simulated, %u register writes and %u reads per step, %u ns of host time\n",
+		(unsigned int)((gHostMicroseconds - Start) / Steps),
+		(unsigned int)((gBksim.Writes - Writes) / Steps),
+		(unsigned int)((gBksim.Reads - Reads) / Steps),
+		(unsigned int)((HOST_GetNanoseconds() - HostStart) / Steps));
+}
+
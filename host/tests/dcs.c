@@ -0,0 +1,253 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "dcs.h"
+#include "host/host.h"
+#include "host/test.h"
+#include "misc.h"
+
+// The decoders before the parity table, kept as they were to check the
+// table based ones against.
+
+static uint32_t ReferenceCalculateGolay(uint32_t CodeWord)
+{
+	uint32_t Word;
+	uint8_t i;
+
+	Word = CodeWord;
+	for (i = 0; i < 12; i++) {
+		Word <<= 1;
+		if (Word & 0x1000) {
+			Word ^= 0x08EA;
+		}
+	}
+	return CodeWord | ((Word & 0x0FFE) << 11);
+}
+
+static uint32_t ReferenceGetGolayCodeWord(DCS_CodeType_t CodeType, uint8_t Option)
+{
+	uint32_t Code;
+
+	Code = ReferenceCalculateGolay(DCS_Options[Option] + 0x800U);
+	if (CodeType == CODE_TYPE_REVERSE_DIGITAL) {
+		Code ^= 0x7FFFFF;
+	}
+
+	return Code;
+}
+
+static uint8_t ReferenceGetCdcssCode(uint32_t Code)
+{
+	uint8_t i;
+
+	for (i = 0; i < 23; i++) {
+		uint32_t Shift;
+
+		if (((Code >> 9) & 0x7U) == 4) {
+			uint8_t j;
+
+			for (j = 0; j < ARRAY_SIZE(DCS_Options); j++) {
+				if (DCS_Options[j] == (Code & 0x1FF)) {
+					if (ReferenceGetGolayCodeWord(2, j) == Code) {
+						return j;
+					}
+				}
+			}
+		}
+		Shift = Code >> 1;
+		if (Code & 1U) {
+			Shift |= 0x400000U;
+		}
+		Code = Shift;
+	}
+
+	return 0xFF;
+}
+
+static uint8_t ReferenceGetCtcssCode(uint16_t Code)
+{
+	uint8_t i;
+	int Smallest;
+	uint8_t Result = 0xFF;
+
+	Smallest = ARRAY_SIZE(CTCSS_Options);
+	for (i = 0; i < ARRAY_SIZE(CTCSS_Options); i++) {
+		int Delta;
+
+		Delta = Code - CTCSS_Options[i];
+		if (Delta < 0) {
+			Delta = -(Code - CTCSS_Options[i]);
+		}
+		if (Delta < Smallest) {
+			Smallest = Delta;
+			Result = i;
+		}
+	}
+
+	return Result;
+}
+
+static int GetDistance(uint16_t Frequency, uint8_t Option)
+{
+	return abs((int)Frequency - (int)CTCSS_Options[Option]);
+}
+
+TEST(GolayCodeWordsMatchTheReference)
+{
+	uint8_t i;
+
+	for (i = 0; i < ARRAY_SIZE(DCS_Options); i++) {
+		CHECK_EQUAL(ReferenceGetGolayCodeWord(CODE_TYPE_DIGITAL, i), DCS_GetGolayCodeWord(CODE_TYPE_DIGITAL, i));
+		CHECK_EQUAL(ReferenceGetGolayCodeWord(CODE_TYPE_REVERSE_DIGITAL, i), DCS_GetGolayCodeWord(CODE_TYPE_REVERSE_DIGITAL, i));
+	}
+}
+
+TEST(CdcssDecodeMatchesTheReference)
+{
+	uint32_t Mismatches = 0;
+	uint32_t Found = 0;
+	uint32_t Code;
+
+	for (Code = 0; Code < (1U << 23); Code++) {
+		const uint8_t Expected = ReferenceGetCdcssCode(Code);
+
+		if (DCS_GetCdcssCode(Code) != Expected) {
+			if (Mismatches++ == 0) {
+				printf("  %06X: %02X instead of %02X\n", (unsigned int)Code, DCS_GetCdcssCode(Code), Expected);
+			}
+		}
+		if (Expected != 0xFF) {
+			Found++;
+		}
+	}
+	CHECK_EQUAL(0, Mismatches);
+	// Every code in all 23 rotations, less the rotations two codes share.
+	CHECK(Found > 0 && Found <= ARRAY_SIZE(DCS_Options) * 23U);
+}
+
+// Decodes every 23 bit word once with each decoder. Nearly all of them are
+// noise, which is what the CSS scan mostly sees too.
+BENCH(CdcssDecode)
+{
+	uint64_t Start;
+	uint64_t Reference;
+	uint64_t Table;
+	volatile uint8_t Sink;
+	uint32_t Code;
+
+	Start = HOST_GetNanoseconds();
+	for (Code = 0; Code < (1U << 23); Code++) {
+		Sink = ReferenceGetCdcssCode(Code);
+	}
+	Reference = HOST_GetNanoseconds() - Start;
+
+	Start = HOST_GetNanoseconds();
+	for (Code = 0; Code < (1U << 23); Code++) {
+		Sink = DCS_GetCdcssCode(Code);
+	}
+	Table = HOST_GetNanoseconds() - Start;
+
+	(void)Sink;
+	printf("  %u ns per word with the scan, %u ns with the table\n",
+		(unsigned int)(Reference >> 23),
+		(unsigned int)(Table >> 23));
+}
+
+// Every reading from 0.1 Hz to 6553.5 Hz. The tone is the one the old
+// nearest tone search picked, and a match is confident exactly when no
+// other tone is within twice CTCSS_AMBIGUITY of being as close.
+TEST(CtcssDecodeCoversEveryReading)
+{
+	DCS_Confidence_t Confidence;
+	uint32_t Mismatches = 0;
+	uint32_t Frequency;
+	uint8_t i;
+
+	for (Frequency = 0; Frequency <= 0xFFFF; Frequency++) {
+		const uint8_t Expected = ReferenceGetCtcssCode(Frequency);
+		DCS_Confidence_t ExpectedConfidence;
+		uint8_t Code;
+
+		Code = DCS_GetCtcssCode(Frequency, &Confidence);
+		if (Expected == 0xFF) {
+			ExpectedConfidence = DCS_CONFIDENCE_NONE;
+		} else {
+			int Margin = 0x10000;
+
+			for (i = 0; i < ARRAY_SIZE(CTCSS_Options); i++) {
+				if (i != Expected && GetDistance(Frequency, i) - GetDistance(Frequency, Expected) < Margin) {
+					Margin = GetDistance(Frequency, i) - GetDistance(Frequency, Expected);
+				}
+			}
+			ExpectedConfidence = (Margin >= 2 * CTCSS_AMBIGUITY) ? DCS_CONFIDENCE_HIGH : DCS_CONFIDENCE_LOW;
+		}
+		if (Code != Expected || Confidence != ExpectedConfidence) {
+			if (Mismatches++ == 0) {
+				printf("  %u.%u Hz: %02X/%u instead of %02X/%u\n", (unsigned int)Frequency / 10, (unsigned int)Frequency % 10, Code, Confidence, Expected, ExpectedConfidence);
+			}
+		}
+	}
+	CHECK_EQUAL(0, Mismatches);
+
+	// The closest tones still get +-0.8 Hz, and the end ones the whole
+	// tolerance outwards.
+	for (i = 0; i < ARRAY_SIZE(CTCSS_Options); i++) {
+		CHECK_EQUAL(i, DCS_GetCtcssCode(CTCSS_Options[i] - 8, &Confidence));
+		CHECK_EQUAL(DCS_CONFIDENCE_HIGH, Confidence);
+		CHECK_EQUAL(i, DCS_GetCtcssCode(CTCSS_Options[i] + 8, &Confidence));
+		CHECK_EQUAL(DCS_CONFIDENCE_HIGH, Confidence);
+	}
+	DCS_GetCtcssCode(CTCSS_Options[0] - CTCSS_TOLERANCE, &Confidence);
+	CHECK_EQUAL(DCS_CONFIDENCE_HIGH, Confidence);
+}
+
+// Looks up every reading from 0 to 300 Hz, the range the tones are in, with
+// both searches.
+BENCH(CtcssDecode)
+{
+	const uint32_t Rounds = 100;
+	uint64_t Start;
+	uint64_t Reference;
+	uint64_t Search;
+	DCS_Confidence_t Confidence;
+	volatile uint8_t Sink;
+	uint32_t Frequency;
+	uint32_t i;
+
+	Start = HOST_GetNanoseconds();
+	for (i = 0; i < Rounds; i++) {
+		for (Frequency = 0; Frequency < 3000; Frequency++) {
+			Sink = ReferenceGetCtcssCode(Frequency);
+		}
+	}
+	Reference = HOST_GetNanoseconds() - Start;
+
+	Start = HOST_GetNanoseconds();
+	for (i = 0; i < Rounds; i++) {
+		for (Frequency = 0; Frequency < 3000; Frequency++) {
+			Sink = DCS_GetCtcssCode(Frequency, &Confidence);
+		}
+	}
+	Search = HOST_GetNanoseconds() - Start;
+
+	(void)Sink;
+	printf("  %u ns per reading with the scan, %u ns with the search\n",
+		(unsigned int)(Reference / (Rounds * 3000)),
+		(unsigned int)(Search / (Rounds * 3000)));
+}
+
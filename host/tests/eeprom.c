@@ -0,0 +1,275 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "driver/eeprom.h"
+#include "driver/i2c.h"
+#include "driver/system.h"
+#include "host/eeprom-sim.h"
+#include "host/host.h"
+#include "host/test.h"
+#include "misc.h"
+#include "radio.h"
+#include "settings.h"
+
+// The write the driver had before page writes: 8 bytes, then a fixed
+// 10 ms for the write cycle.
+static void ReferenceWriteBuffer(uint16_t Address, const void *pBuffer)
+{
+	I2C_Start();
+	I2C_Write(0xA0);
+	I2C_Write((Address >> 8) & 0xFF);
+	I2C_Write((Address >> 0) & 0xFF);
+	I2C_WriteBuffer(pBuffer, 8);
+	I2C_Stop();
+	SYSTEM_DelayMs(10);
+}
+
+TEST(EepromReadsWhatWasWritten)
+{
+	uint8_t Data[200];
+	uint8_t Back[200];
+	uint16_t i;
+
+	for (i = 0; i < sizeof(Data); i++) {
+		Data[i] = (uint8_t)(i * 37 + 11);
+	}
+	EEPROM_WritePages(0x0123, Data, sizeof(Data));
+
+	CHECK(memcmp(&gEesim->Memory[0x0123], Data, sizeof(Data)) == 0);
+	CHECK_EQUAL(7, gEesim->Programs);
+	CHECK_EQUAL(0xFF, gEesim->Memory[0x0122]);
+	CHECK_EQUAL(0xFF, gEesim->Memory[0x0123 + sizeof(Data)]);
+
+	EEPROM_ReadBuffer(0x0123, Back, sizeof(Back));
+	CHECK(memcmp(Back, Data, sizeof(Data)) == 0);
+}
+
+TEST(EepromReadsAcrossTheEnd)
+{
+	uint8_t Back[4];
+
+	gEesim->Memory[0x1FFE] = 1;
+	gEesim->Memory[0x1FFF] = 2;
+	gEesim->Memory[0x0000] = 3;
+	gEesim->Memory[0x0001] = 4;
+
+	EEPROM_ReadBuffer(0x1FFE, Back, sizeof(Back));
+	CHECK_EQUAL(1, Back[0]);
+	CHECK_EQUAL(2, Back[1]);
+	CHECK_EQUAL(3, Back[2]);
+	CHECK_EQUAL(4, Back[3]);
+}
+
+TEST(EepromWaitsOutTheWriteCycle)
+{
+	const uint8_t Data[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	uint8_t Back[8];
+	uint64_t Start;
+
+	Start = gHostMicroseconds;
+	EEPROM_WritePages(0x0400, Data, sizeof(Data));
+	CHECK(gHostMicroseconds - Start >= EESIM_WRITE_CYCLE_US);
+	CHECK(!EESIM_IsBusy());
+	CHECK(gEesim->BusyNacks > 0);
+
+	// A second write right away must not be lost to a NAK.
+	EEPROM_WritePages(0x0408, Data, sizeof(Data));
+	EEPROM_ReadBuffer(0x0408, Back, sizeof(Back));
+	CHECK(memcmp(Back, Data, sizeof(Data)) == 0);
+	CHECK_EQUAL(2, gEesim->Programs);
+}
+
+// Every start offset in a page with every length up to past four pages.
+// The model wraps a write that runs off its page like the real part does,
+// so a missed split shows up as bytes at the start of the page.
+TEST(EepromSplitsWritesAtPageBoundaries)
+{
+	const uint16_t Base = 0x0800;
+	uint8_t Data[130];
+	uint8_t Offset;
+	uint8_t Size;
+	uint8_t i;
+
+	for (i = 0; i < sizeof(Data); i++) {
+		Data[i] = (uint8_t)(i + 1);
+	}
+	for (Offset = 0; Offset < EESIM_PAGE_SIZE; Offset++) {
+		for (Size = 1; Size <= sizeof(Data); Size++) {
+			const uint16_t Start = Base + Offset;
+			const uint32_t Pages = ((Start + Size - 1U) / EESIM_PAGE_SIZE) - (Start / EESIM_PAGE_SIZE) + 1U;
+
+			memset(&gEesim->Memory[Base - EESIM_PAGE_SIZE], 0xFF, 8 * EESIM_PAGE_SIZE);
+			EESIM_ResetCounters();
+			EEPROM_WritePages(Start, Data, Size);
+			if (memcmp(&gEesim->Memory[Start], Data, Size) != 0 || gEesim->Programs != Pages) {
+				printf("  %u bytes at %04X: %u programs\n", Size, Start, (unsigned int)gEesim->Programs);
+				CHECK(false);
+				return;
+			}
+			for (i = 0; i < EESIM_PAGE_SIZE + Offset; i++) {
+				CHECK_EQUAL(0xFF, gEesim->Memory[Start - 1 - i]);
+			}
+			for (i = 0; i < EESIM_PAGE_SIZE; i++) {
+				CHECK_EQUAL(0xFF, gEesim->Memory[Start + Size + i]);
+			}
+		}
+	}
+}
+
+// What the saves cost on the simulated bus and clock, with the worst case
+// write cycle of the 24C64, against the old 8 byte writes.
+BENCH(EepromSaveLatency)
+{
+	uint8_t Block[64];
+	uint64_t Start;
+	uint32_t Call;
+	uint32_t Flush;
+	uint32_t Programs;
+	uint8_t i;
+
+	HOST_Boot();
+	memset(Block, 0x5A, sizeof(Block));
+
+	EESIM_ResetCounters();
+	Start = gHostMicroseconds;
+	SETTINGS_SaveChannel(0, 0, gTxVfo, 2);
+	Call = (uint32_t)(gHostMicroseconds - Start);
+	EEPROM_Flush();
+	Flush = (uint32_t)(gHostMicroseconds - Start);
+	printf("  channel save: %u us in the call, %u us until it is all out, %u page writes\n",
+		(unsigned int)Call, (unsigned int)Flush, (unsigned int)gEesim->Programs);
+
+	EESIM_ResetCounters();
+	Start = gHostMicroseconds;
+	EEPROM_WritePages(0x0400, Block, sizeof(Block));
+	Programs = gEesim->Programs;
+	printf("  AirCopy block: %u us, %u page writes\n", (unsigned int)(gHostMicroseconds - Start), (unsigned int)Programs);
+
+	Start = gHostMicroseconds;
+	for (i = 0; i < 2; i++) {
+		ReferenceWriteBuffer(0x0400 + (i * 8), Block);
+	}
+	printf("  16 bytes as 8 byte writes: %u us\n", (unsigned int)(gHostMicroseconds - Start));
+
+	Start = gHostMicroseconds;
+	for (i = 0; i < 8; i++) {
+		ReferenceWriteBuffer(0x0400 + (i * 8), Block);
+	}
+	printf("  64 bytes as 8 byte writes: %u us\n", (unsigned int)(gHostMicroseconds - Start));
+}
+
+#if defined(ENABLE_EEPROM_CACHE)
+// Writes one line into each of 12 pages, more than the cache holds, and
+// rewrites the first one while it is still dirty. After every write and
+// every flush, what is in the EEPROM has to be the first so many pages and
+// nothing later, as a power cut could come at any of those points.
+TEST(EepromCacheKeepsWriteOrder)
+{
+	const uint16_t Base = 0x0400;
+	const uint8_t Pages = 12;
+	uint8_t Line[8];
+	uint8_t Step;
+	uint8_t i;
+
+	for (Step = 0; Step <= Pages; Step++) {
+		if (Step < Pages) {
+			memset(Line, Step + 1, sizeof(Line));
+			EEPROM_WriteCached(Base + (Step * EESIM_PAGE_SIZE), Line, sizeof(Line));
+			if (Step == 3) {
+				memset(Line, 0x80, sizeof(Line));
+				EEPROM_WriteCached(Base, Line, sizeof(Line));
+			}
+		}
+		do {
+			bool bIsPrefix = true;
+
+			for (i = 0; i < Pages; i++) {
+				const bool bIsOut = gEesim->Memory[Base + (i * EESIM_PAGE_SIZE)] != 0xFF;
+
+				if (bIsOut && !bIsPrefix) {
+					printf("  after step %u: page %u is out before an earlier one\n", Step, i);
+					CHECK(false);
+				}
+				bIsPrefix = bIsOut;
+			}
+		} while (Step == Pages && EEPROM_FlushPage());
+	}
+	CHECK_EQUAL(0x80, gEesim->Memory[Base]);
+	for (i = 1; i < Pages; i++) {
+		CHECK_EQUAL(i + 1, gEesim->Memory[Base + (i * EESIM_PAGE_SIZE)]);
+	}
+}
+
+// Ten saves of the same settings line and one of its neighbour cost a
+// single page write once flushed, instead of eleven.
+TEST(EepromCacheCountsSavedWrites)
+{
+	uint8_t Line[8];
+	uint8_t i;
+
+	gEepromCoalescedWrites = 0;
+	gEepromPageWrites = 0;
+	for (i = 0; i < 10; i++) {
+		memset(Line, i, sizeof(Line));
+		EEPROM_WriteCached(0x0E70, Line, sizeof(Line));
+	}
+	EEPROM_WriteCached(0x0E78, Line, sizeof(Line));
+	CHECK_EQUAL(0, gEesim->Programs);
+
+	EEPROM_Flush();
+	CHECK_EQUAL(1, gEesim->Programs);
+	CHECK_EQUAL(1, gEepromPageWrites);
+	CHECK_EQUAL(9, gEepromCoalescedWrites);
+	for (i = 0; i < 16; i++) {
+		CHECK_EQUAL(9, gEesim->Memory[0x0E70 + i]);
+	}
+}
+#endif
+
+#if defined(ENABLE_I2C_FAST)
+// The fast driver's edges reach the same EEPROM model as the plain one's,
+// which follows them as the 24C64 would. SysTick does not move during the
+// calibration here, so the driver keeps its slower first guess.
+TEST(FastI2cTalksToTheEeprom)
+{
+	uint8_t Data[100];
+	uint8_t Back[100];
+	uint8_t i;
+
+	I2C_Calibrate();
+	for (i = 0; i < sizeof(Data); i++) {
+		Data[i] = (uint8_t)((i * 73) ^ 0xA5);
+	}
+	EEPROM_WritePages(0x0345, Data, sizeof(Data));
+	CHECK(memcmp(&gEesim->Memory[0x0345], Data, sizeof(Data)) == 0);
+	CHECK_EQUAL(4, gEesim->Programs);
+	CHECK(gEesim->BusyNacks > 0);
+
+	EEPROM_ReadBuffer(0x0345, Back, sizeof(Back));
+	CHECK(memcmp(Back, Data, sizeof(Data)) == 0);
+
+	// Nothing answers at another address.
+	I2C_Start();
+	CHECK_EQUAL(-1, I2C_Write(0xA4));
+	I2C_Stop();
+	I2C_Start();
+	CHECK_EQUAL(0, I2C_Write(0xA0));
+	I2C_Stop();
+}
+#endif
+
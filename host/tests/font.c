@@ -0,0 +1,114 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "driver/st7565.h"
+#include "host/host.h"
+#include "host/test.h"
+#include "ui/helper.h"
+
+// The big glyphs and digits as UI_PrintString and UI_DisplayFrequency draw
+// them, against font.c's unpacked tables built in beside whichever font
+// the firmware uses.
+
+extern const uint8_t gFontReferenceBig[95][16];
+extern const uint8_t gFontReferenceBigDigits[11][26];
+
+static bool IsBlankOutside(uint8_t Column, uint8_t Width)
+{
+	uint16_t i;
+
+	for (i = 0; i < sizeof(gFrameBuffer); i++) {
+		const uint8_t Line = i / 128;
+		const uint8_t X = i % 128;
+
+		if (Line < 2 && X >= Column && X < Column + Width) {
+			continue;
+		}
+		if (gFrameBuffer[Line][X]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+TEST(BigGlyphsDecodeToTheOriginals)
+{
+	char String[2] = { 0, 0 };
+	uint8_t i;
+
+	for (i = 0; i < 95; i++) {
+		memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
+		String[0] = ' ' + i;
+		UI_PrintString(String, 40, 127, 0, 8, false);
+		if (memcmp(gFrameBuffer[0] + 40, gFontReferenceBig[i], 8) || memcmp(gFrameBuffer[1] + 40, gFontReferenceBig[i] + 8, 8)) {
+			printf("  '%c' differs\n", String[0]);
+			CHECK(false);
+		}
+		CHECK(IsBlankOutside(40, 8));
+	}
+}
+
+TEST(BigDigitsDecodeToTheOriginals)
+{
+	char Digits[6];
+	uint8_t i, j;
+
+	for (i = 0; i < 11; i++) {
+		memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
+		memset(Digits, i, sizeof(Digits));
+		UI_DisplayFrequency(Digits, 20, 0, true, false);
+		for (j = 0; j < 6; j++) {
+			const uint8_t Column = 20 + (j * 13) + (j < 3 ? 0 : 3);
+
+			if (memcmp(gFrameBuffer[0] + Column, gFontReferenceBigDigits[i], 13) || memcmp(gFrameBuffer[1] + Column, gFontReferenceBigDigits[i] + 13, 13)) {
+				printf("  digit %u differs at position %u\n", i, j);
+				CHECK(false);
+			}
+		}
+		// Only the point is drawn between the digits.
+		gFrameBuffer[1][20 + 39] ^= 0x60;
+		gFrameBuffer[1][20 + 40] ^= 0x60;
+		gFrameBuffer[1][20 + 41] ^= 0x60;
+		CHECK(IsBlankOutside(20, 81));
+	}
+}
+
+// Host time per glyph drawn, for whichever font the firmware is built
+// with. Build with ENABLE_PACKED_FONT=0 for the unpacked one.
+BENCH(FontDecodeTime)
+{
+	const char *pString = "SQL 438.500 CH-1";
+	const uint32_t Count = 100000;
+	const char Digits[6] = { 4, 3, 8, 5, 0, 0 };
+	uint64_t Start;
+	uint32_t i;
+
+	Start = HOST_GetNanoseconds();
+	for (i = 0; i < Count; i++) {
+		UI_PrintString(pString, 0, 127, 0, 8, false);
+	}
+	printf("  %5.1f ns per glyph\n", (double)(HOST_GetNanoseconds() - Start) / (Count * strlen(pString)));
+
+	Start = HOST_GetNanoseconds();
+	for (i = 0; i < Count; i++) {
+		UI_DisplayFrequency(Digits, 0, 2, true, false);
+	}
+	printf("  %5.1f ns per digit\n", (double)(HOST_GetNanoseconds() - Start) / (Count * 6));
+}
+
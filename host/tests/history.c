@@ -0,0 +1,256 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+#include "app/history.h"
+#include "functions.h"
+#include "host/eeprom-sim.h"
+#include "host/host.h"
+#include "host/test.h"
+#include "misc.h"
+#include "scanhistory.h"
+
+#if defined(ENABLE_SCAN_HISTORY)
+// The scan hit log and per-channel counts, and with
+// ENABLE_SCAN_HISTORY_EEPROM the batches saved in 1D00..1D7F.
+
+#define HISTORY_EEPROM	0x1D00U
+
+// Hit number i: on channel i % 3, from tick 100 * i for i ticks.
+static void RecordHits(uint16_t First, uint16_t Count)
+{
+	uint16_t i;
+
+	for (i = First; i < First + Count; i++) {
+		HISTORY_Open(100U * i, i % 3U, 43300000U + (i * 2500U), 50U + i, 1U, i);
+		HISTORY_Close((100U * i) + i);
+	}
+}
+
+TEST(HistoryKeepsTheNewestHits)
+{
+	const HISTORY_Entry_t *pEntry;
+	uint8_t Age;
+
+	HISTORY_Init(0);
+	CHECK_EQUAL(0, HISTORY_GetCount());
+	CHECK(HISTORY_Get(0) == NULL);
+
+	RecordHits(0, 20);
+	CHECK_EQUAL(HISTORY_SIZE, HISTORY_GetCount());
+	CHECK(HISTORY_Get(HISTORY_SIZE) == NULL);
+	for (Age = 0; Age < HISTORY_SIZE; Age++) {
+		const uint16_t i = 19U - Age;
+
+		pEntry = HISTORY_Get(Age);
+		CHECK_EQUAL(i, pEntry->Sequence);
+		CHECK_EQUAL(100U * i, pEntry->Tick);
+		CHECK_EQUAL(i, pEntry->Duration);
+		CHECK_EQUAL(i % 3U, pEntry->Channel);
+		CHECK_EQUAL(43300000U + (i * 2500U), pEntry->Frequency);
+		CHECK_EQUAL(50U + i, pEntry->Rssi);
+		CHECK_EQUAL(i, pEntry->Code);
+	}
+
+	// A hit stays open until the squelch closes, and only the first close
+	// counts. Opening the next one closes it too.
+	HISTORY_Open(5000, 7, 43400000, 90, 0, 0);
+	CHECK_EQUAL(HISTORY_OPEN, HISTORY_Get(0)->Duration);
+	HISTORY_Close(5040);
+	HISTORY_Close(5090);
+	CHECK_EQUAL(40, HISTORY_Get(0)->Duration);
+	HISTORY_Open(6000, 8, 43400000, 90, 0, 0);
+	HISTORY_Open(6300, 9, 43400000, 90, 0, 0);
+	CHECK_EQUAL(300, HISTORY_Get(1)->Duration);
+
+	// Durations that do not fit stop short of HISTORY_OPEN.
+	HISTORY_Close(6300U + 0x20000U);
+	CHECK_EQUAL(HISTORY_OPEN - 1U, HISTORY_Get(0)->Duration);
+}
+
+TEST(HistoryCountsHitsPerChannel)
+{
+	uint8_t Channels[4];
+
+	HISTORY_Init(0);
+	RecordHits(0, 20);
+	CHECK_EQUAL(7, HISTORY_GetHits(0));
+	CHECK_EQUAL(7, HISTORY_GetHits(1));
+	CHECK_EQUAL(6, HISTORY_GetHits(2));
+	CHECK_EQUAL(0, HISTORY_GetHits(3));
+	CHECK_EQUAL(0, HISTORY_GetHits(0xFF));
+
+	// The counts outlive the log. Frequency mode hits are logged but not
+	// counted.
+	HISTORY_Open(3000, FREQ_CHANNEL_FIRST, 14500000, 90, 0, 0);
+	HISTORY_Open(3100, 40, 43400000, 90, 0, 0);
+	HISTORY_Open(3200, 40, 43400000, 90, 0, 0);
+	HISTORY_Open(3300, 40, 43400000, 90, 0, 0);
+	HISTORY_Open(3400, 40, 43400000, 90, 0, 0);
+	HISTORY_Open(3500, 40, 43400000, 90, 0, 0);
+	HISTORY_Open(3600, 40, 43400000, 90, 0, 0);
+	HISTORY_Open(3700, 40, 43400000, 90, 0, 0);
+	HISTORY_Open(3800, 40, 43400000, 90, 0, 0);
+	CHECK_EQUAL(8, HISTORY_GetHits(40));
+	CHECK_EQUAL(0, HISTORY_GetHits(FREQ_CHANNEL_FIRST));
+
+	// Busiest first, ties in channel order, and no more than asked for.
+	CHECK_EQUAL(4, HISTORY_GetBusiest(Channels, 4));
+	CHECK_EQUAL(40, Channels[0]);
+	CHECK_EQUAL(0, Channels[1]);
+	CHECK_EQUAL(1, Channels[2]);
+	CHECK_EQUAL(2, Channels[3]);
+	CHECK_EQUAL(2, HISTORY_GetBusiest(Channels, 2));
+	CHECK_EQUAL(40, Channels[0]);
+	CHECK_EQUAL(0, Channels[1]);
+}
+
+TEST(HistoryHalvesEveryCountWhenOneIsFull)
+{
+	uint16_t i;
+
+	HISTORY_Init(0);
+	for (i = 0; i < 255; i++) {
+		HISTORY_Open(i, 5, 43300000, 90, 0, 0);
+	}
+	HISTORY_Open(300, 6, 43300000, 90, 0, 0);
+	HISTORY_Open(301, 6, 43300000, 90, 0, 0);
+	HISTORY_Open(302, 6, 43300000, 90, 0, 0);
+	HISTORY_Open(303, 7, 43300000, 90, 0, 0);
+	CHECK_EQUAL(255, HISTORY_GetHits(5));
+	CHECK_EQUAL(3, HISTORY_GetHits(6));
+
+	HISTORY_Open(400, 5, 43300000, 90, 0, 0);
+	CHECK_EQUAL(128, HISTORY_GetHits(5));
+	CHECK_EQUAL(1, HISTORY_GetHits(6));
+	CHECK_EQUAL(0, HISTORY_GetHits(7));
+
+	// Decayed counts keep growing from where the halving left them.
+	HISTORY_Open(500, 6, 43300000, 90, 0, 0);
+	CHECK_EQUAL(2, HISTORY_GetHits(6));
+	CHECK_EQUAL(128, HISTORY_GetHits(5));
+}
+
+TEST(HistoryBatchesFinishedHits)
+{
+	HISTORY_Entry_t Batch[HISTORY_BATCH];
+
+	HISTORY_Init(0);
+	CHECK(!HISTORY_TakeBatch(Batch));
+	RecordHits(0, 1);
+	CHECK(!HISTORY_TakeBatch(Batch));
+
+	// The second hit of a batch has to finish first.
+	HISTORY_Open(100, 1, 43302500, 51, 1, 1);
+	CHECK(!HISTORY_TakeBatch(Batch));
+	HISTORY_Close(101);
+	CHECK(HISTORY_TakeBatch(Batch));
+	CHECK_EQUAL(0, Batch[0].Sequence);
+	CHECK_EQUAL(1, Batch[1].Sequence);
+	CHECK(!HISTORY_TakeBatch(Batch));
+
+	// Hits that fell out of the log before they were taken are skipped, up
+	// to the next whole batch.
+	RecordHits(2, HISTORY_SIZE + 3);
+	CHECK(HISTORY_TakeBatch(Batch));
+	CHECK_EQUAL(6, Batch[0].Sequence);
+	CHECK_EQUAL(7, Batch[1].Sequence);
+}
+
+TEST(HistoryContinuesAfterTheNewestSavedHit)
+{
+	HISTORY_Entry_t Saved[HISTORY_SAVED];
+	uint8_t i;
+
+	memset(Saved, 0xFF, sizeof(Saved));
+	CHECK_EQUAL(0, HISTORY_GetNextSequence(Saved, HISTORY_SAVED));
+
+	for (i = 0; i < HISTORY_SAVED; i++) {
+		Saved[i].Tick = i;
+		Saved[i].Sequence = 0xFFF8U + i;
+	}
+	CHECK_EQUAL(0, HISTORY_GetNextSequence(Saved, HISTORY_SAVED));
+
+	// The sequence wraps, and batches that were never written are skipped.
+	Saved[0].Sequence = 0;
+	Saved[1].Sequence = 1;
+	memset(&Saved[4], 0xFF, 2 * sizeof(Saved[0]));
+	CHECK_EQUAL(2, HISTORY_GetNextSequence(Saved, HISTORY_SAVED));
+}
+
+#if defined(ENABLE_SCAN_HISTORY_EEPROM)
+static uint16_t GetSavedSequence(uint8_t Slot)
+{
+	HISTORY_Entry_t Entry;
+
+	memcpy(&Entry, &gEesim->Memory[HISTORY_EEPROM + (Slot * sizeof(Entry))], sizeof(Entry));
+
+	return Entry.Sequence;
+}
+
+static void FlushAll(void)
+{
+	uint8_t i;
+
+	for (i = 0; i < HISTORY_SIZE; i++) {
+		HISTORY_Flush();
+	}
+}
+
+TEST(HistorySurvivesAReboot)
+{
+	HISTORY_Entry_t Entry;
+	uint8_t i;
+
+	HOST_Boot();
+	RecordHits(0, 10);
+
+	// Nothing is written while the radio is receiving or transmitting.
+	gCurrentFunction = FUNCTION_RECEIVE;
+	HISTORY_Flush();
+	gCurrentFunction = FUNCTION_TRANSMIT;
+	HISTORY_Flush();
+	CHECK_EQUAL(0xFFFF, GetSavedSequence(0));
+
+	// One batch per call, each a page of its own, the newest over the
+	// oldest.
+	gCurrentFunction = FUNCTION_FOREGROUND;
+	gEesim->Programs = 0;
+	FlushAll();
+	CHECK_EQUAL(5, gEesim->Programs);
+	for (i = 0; i < HISTORY_SAVED; i++) {
+		CHECK_EQUAL((i < 2) ? i + 8U : i, GetSavedSequence(i));
+	}
+	memcpy(&Entry, &gEesim->Memory[HISTORY_EEPROM + (5 * sizeof(Entry))], sizeof(Entry));
+	CHECK_EQUAL(500, Entry.Tick);
+	CHECK_EQUAL(5, Entry.Duration);
+	CHECK_EQUAL(2, Entry.Channel);
+	CHECK_EQUAL(43312500, Entry.Frequency);
+
+	// After a reboot the log starts empty, and the next hits go over the
+	// oldest saved ones rather than the first page.
+	HOST_Boot();
+	CHECK_EQUAL(0, HISTORY_GetCount());
+	RecordHits(10, 2);
+	CHECK_EQUAL(10, HISTORY_Get(1)->Sequence);
+	FlushAll();
+	for (i = 0; i < HISTORY_SAVED; i++) {
+		CHECK_EQUAL((i < 4) ? i + 8U : i, GetSavedSequence(i));
+	}
+}
+#endif
+#endif
+
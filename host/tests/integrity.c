@@ -0,0 +1,315 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "driver/eeprom.h"
+#include "host/eeprom-sim.h"
+#include "host/host.h"
+#include "host/test.h"
+#include "integrity.h"
+#if defined(ENABLE_EEPROM_JOURNAL)
+#include "journal.h"
+#endif
+
+#if defined(ENABLE_EEPROM_INTEGRITY)
+// Model check for the incremental checksums: after any mix of direct,
+// cached and journalled writes, each checksum has to match a CRC computed
+// from scratch over what EEPROM_ReadBuffer returns for the region.
+
+#define OPERATIONS	4000U
+#define CUT_OPERATIONS	60U
+#define JOURNAL_START	0x1D80U
+#define JOURNAL_END	0x1E00U
+
+static uint16_t Crc16(uint16_t Crc, uint8_t Data)
+{
+	uint8_t i;
+
+	Crc ^= Data << 8;
+	for (i = 0; i < 8; i++) {
+		Crc = (Crc & 0x8000U) ? (Crc << 1) ^ 0x1021U : Crc << 1;
+	}
+
+	return Crc;
+}
+
+static uint16_t GetRegionCrc(uint8_t Region)
+{
+	uint16_t Crc = 0;
+	uint16_t Address;
+
+	for (Address = gIntegrityRegions[Region].Start; Address < gIntegrityRegions[Region].End; Address++) {
+		uint8_t Data;
+
+		EEPROM_ReadBuffer(Address, &Data, 1);
+		Crc = Crc16(Crc, Data);
+	}
+
+	return Crc;
+}
+
+// Boots and then runs long enough for the flush slice to catch up.
+static void Boot(void)
+{
+#if defined(ENABLE_EEPROM_JOURNAL)
+	JOURNAL_Replay();
+#endif
+	INTEGRITY_Load();
+	INTEGRITY_Verify();
+	EEPROM_Flush();
+}
+
+static bool Overlaps(uint16_t Address, uint16_t Size, uint16_t Start, uint16_t End)
+{
+	return Address < End && Address + Size > Start;
+}
+
+// The table and the journal are only ever written by their own modules.
+static uint16_t GetAddress(uint16_t Size)
+{
+	for (;;) {
+		const uint16_t Address = rand() % (EESIM_SIZE - Size);
+
+		if (!Overlaps(Address, Size, INTEGRITY_EEPROM, INTEGRITY_EEPROM + INTEGRITY_SIZE) && !Overlaps(Address, Size, JOURNAL_START, JOURNAL_END)) {
+			return Address;
+		}
+	}
+}
+
+// Direct writes to journalled words have to compact first, as the
+// firmware does.
+static void PrepareDirect(uint16_t Address, uint16_t Size)
+{
+#if defined(ENABLE_EEPROM_JOURNAL)
+	if (Overlaps(Address, Size, 0x0C80, 0x0D60) || Overlaps(Address, Size, 0x0E80, 0x0E88)) {
+		JOURNAL_Compact();
+	}
+#else
+	(void)Address;
+	(void)Size;
+#endif
+}
+
+static void RandomWrite(void)
+{
+	uint8_t Data[64];
+	uint16_t Address;
+	uint16_t Size;
+	uint16_t i;
+
+	switch (rand() % 6) {
+	case 0:
+		Address = GetAddress(8) & ~7U;
+		for (i = 0; i < 8; i++) {
+			Data[i] = (uint8_t)rand();
+		}
+		PrepareDirect(Address, 8);
+		EEPROM_WriteBuffer(Address, Data);
+		break;
+
+	case 1:
+		Size = 1 + (rand() % sizeof(Data));
+		Address = GetAddress(Size);
+		EEPROM_ReadBuffer(Address, Data, Size);
+		for (i = 0; i < Size; i++) {
+			if (rand() % 4 == 0) {
+				Data[i] = (uint8_t)rand();
+			}
+		}
+		PrepareDirect(Address, Size);
+		EEPROM_WritePages(Address, Data, Size);
+		break;
+
+	case 2:
+		Address = GetAddress(16) & ~15U;
+		EEPROM_ReadBuffer(Address, Data, 16);
+		Data[rand() % 16] ^= 1 + (rand() % 255);
+		PrepareDirect(Address, 16);
+		EEPROM_WriteCached(Address, Data, 16);
+		break;
+
+#if defined(ENABLE_EEPROM_JOURNAL)
+	case 3:
+		if (rand() % 2) {
+			Address = 0x0E80;
+			Size = 8;
+		} else {
+			Address = 0x0C80 + ((rand() % 14) * 16);
+			Size = 16;
+		}
+		EEPROM_ReadBuffer(Address, Data, Size);
+		Data[rand() % Size] = (uint8_t)rand();
+		JOURNAL_Write(Address, Data, Size);
+		break;
+
+	case 4:
+		if (rand() % 8 == 0) {
+			JOURNAL_Compact();
+		}
+		break;
+#endif
+
+	default:
+		if (rand() % 2) {
+			EEPROM_FlushPage();
+		} else if (rand() % 20 == 0) {
+			EEPROM_Flush();
+		}
+		break;
+	}
+}
+
+TEST(IntegrityTracksEveryWrite)
+{
+	uint32_t Operation;
+	uint16_t i;
+	uint8_t Region;
+
+	srand(1);
+	for (i = 0; i < EESIM_SIZE; i++) {
+		gEesim->Memory[i] = (uint8_t)rand();
+	}
+
+	Boot();
+	CHECK(INTEGRITY_IsValid());
+	CHECK_EQUAL(0, gIntegrityFailures);
+	Boot();
+	CHECK_EQUAL(0, gIntegrityFailures);
+
+	for (Operation = 1; Operation <= OPERATIONS; Operation++) {
+		RandomWrite();
+		if (Operation % 200 == 0) {
+			for (Region = 0; Region < INTEGRITY_REGIONS; Region++) {
+				CHECK_EQUAL(GetRegionCrc(Region), INTEGRITY_GetCrc(Region));
+			}
+		}
+		if (Operation % 1000 == 0) {
+			EEPROM_Flush();
+			Boot();
+			CHECK_EQUAL(0, gIntegrityFailures);
+		}
+	}
+}
+
+TEST(IntegrityFlagsOnlyTheCorruptRegion)
+{
+	Boot();
+	CHECK_EQUAL(0, gIntegrityFailures);
+
+	gEesim->Memory[0x1000] ^= 0x10;
+	Boot();
+	CHECK_EQUAL(1U << 2, gIntegrityFailures);
+
+	// The table is rebuilt, so the same damage is reported only once.
+	Boot();
+	CHECK_EQUAL(0, gIntegrityFailures);
+
+	gEesim->Memory[0x1E05] ^= 0x01;
+	gEesim->Memory[0x0010] ^= 0x01;
+	Boot();
+	CHECK_EQUAL((1U << 4) | (1U << 0), gIntegrityFailures);
+}
+
+typedef struct {
+	uint8_t Base[EESIM_SIZE];
+	uint32_t Programs;
+	uint32_t CutAt;
+} Shared_t;
+
+static Shared_t *gShared;
+
+static void RunWrites(void)
+{
+	uint32_t Operation;
+
+	srand(7);
+	for (Operation = 0; Operation < CUT_OPERATIONS; Operation++) {
+		RandomWrite();
+	}
+	EEPROM_Flush();
+}
+
+static void CountPrograms(void *pContext)
+{
+	(void)pContext;
+	Boot();
+	EESIM_ResetCounters();
+	RunWrites();
+	gShared->Programs = gEesim->Programs;
+}
+
+static void RunUntilCut(void *pContext)
+{
+	(void)pContext;
+	Boot();
+	EESIM_CutPower(gShared->CutAt, gShared->CutAt);
+	RunWrites();
+}
+
+static void BootAndCheck(void *pContext)
+{
+	(void)pContext;
+	Boot();
+	if (gIntegrityFailures) {
+		printf("  cut at program %u: regions %02X flagged\n", gShared->CutAt, gIntegrityFailures);
+	}
+	CHECK_EQUAL(0, gIntegrityFailures);
+}
+
+// Losing power part way through a run of saves leaves the contents and the
+// table out of step for a while. That must never read as corruption.
+TEST(IntegrityIgnoresPowerCuts)
+{
+	uint16_t i;
+
+	gShared = mmap(NULL, sizeof(*gShared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	CHECK(gShared != MAP_FAILED);
+	srand(3);
+	for (i = 0; i < EESIM_SIZE; i++) {
+		gEesim->Memory[i] = (uint8_t)rand();
+	}
+	Boot();
+	memcpy(gShared->Base, gEesim->Memory, EESIM_SIZE);
+
+	CHECK_EQUAL(0, HOST_Fork(CountPrograms, NULL));
+	CHECK(gShared->Programs > CUT_OPERATIONS / 2);
+
+	for (gShared->CutAt = 0; gShared->CutAt < gShared->Programs && !gTestFailures; gShared->CutAt++) {
+		memcpy(gEesim->Memory, gShared->Base, EESIM_SIZE);
+		CHECK_EQUAL(HOST_EXIT_POWER_CUT, HOST_Fork(RunUntilCut, NULL));
+		CHECK_EQUAL(0, HOST_Fork(BootAndCheck, NULL));
+	}
+}
+
+TEST(IntegrityRebuildsATornTable)
+{
+	Boot();
+#if defined(ENABLE_EEPROM_JOURNAL)
+	JOURNAL_Compact();
+#endif
+	EEPROM_Flush();
+	gEesim->Memory[INTEGRITY_EEPROM + 4] ^= 0xFF;
+	INTEGRITY_Load();
+	CHECK(!INTEGRITY_IsValid());
+	INTEGRITY_Verify();
+	CHECK_EQUAL(0, gIntegrityFailures);
+	CHECK(INTEGRITY_IsValid());
+}
+#endif
+
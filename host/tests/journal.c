@@ -0,0 +1,169 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "driver/eeprom.h"
+#include "host/eeprom-sim.h"
+#include "host/host.h"
+#include "host/test.h"
+#include "journal.h"
+
+#if defined(ENABLE_EEPROM_JOURNAL)
+// Power cut test for the journalled VFO saves. A run of saves is cut at
+// every page program in turn, and the next boot must find the state after
+// some whole number of saves, never less than what the last EEPROM_Flush
+// made durable. `make host` runs it with and without ENABLE_EEPROM_CACHE.
+
+#define SAVES		150U
+#define VFO_START	0x0C80U
+#define VFO_SIZE	0xE0U
+#define INDEX_START	0x0E80U
+#define INDEX_SIZE	8U
+#define STATE_SIZE	(VFO_SIZE + INDEX_SIZE)
+
+typedef struct {
+	uint8_t Base[EESIM_SIZE];
+	uint8_t States[SAVES + 1][STATE_SIZE];
+	uint32_t Programs;
+	uint32_t Flushed;
+	uint32_t CutAt;
+} Shared_t;
+
+static Shared_t *gShared;
+
+static void Snapshot(uint8_t *pState)
+{
+	EEPROM_ReadBuffer(VFO_START, pState, VFO_SIZE);
+	EEPROM_ReadBuffer(INDEX_START, pState + VFO_SIZE, INDEX_SIZE);
+}
+
+// Save number Save changes one or two bytes of a VFO record or of the
+// screen channel indices, the way the menus do.
+static void Save(uint32_t Save)
+{
+	uint8_t Data[16];
+
+	srand(1000 + Save);
+	if (rand() % 2) {
+		EEPROM_ReadBuffer(INDEX_START, Data, INDEX_SIZE);
+		Data[rand() % INDEX_SIZE] = (uint8_t)rand();
+		JOURNAL_Write(INDEX_START, Data, INDEX_SIZE);
+	} else {
+		const uint16_t Address = VFO_START + ((rand() % 14) * 16);
+
+		EEPROM_ReadBuffer(Address, Data, sizeof(Data));
+		Data[rand() % 4] = (uint8_t)rand();
+		if (rand() % 8 == 0) {
+			Data[8 + (rand() % 8)] = (uint8_t)rand();
+		}
+		JOURNAL_Write(Address, Data, sizeof(Data));
+	}
+
+	srand(5000 + Save);
+	if (rand() % 3 == 0) {
+		EEPROM_FlushPage();
+	}
+	if (rand() % 10 == 0) {
+		EEPROM_Flush();
+		gShared->Flushed = Save + 1;
+	}
+}
+
+static void RecordStates(void *pContext)
+{
+	uint32_t i;
+
+	(void)pContext;
+	JOURNAL_Replay();
+	Snapshot(gShared->States[0]);
+	for (i = 0; i < SAVES; i++) {
+		Save(i);
+		Snapshot(gShared->States[i + 1]);
+	}
+	EEPROM_Flush();
+	gShared->Programs = gEesim->Programs;
+}
+
+static void RunUntilCut(void *pContext)
+{
+	uint32_t i;
+
+	(void)pContext;
+	EESIM_CutPower(gShared->CutAt, gShared->CutAt);
+	JOURNAL_Replay();
+	for (i = 0; i < SAVES; i++) {
+		Save(i);
+	}
+}
+
+static void BootAndCheck(void *pContext)
+{
+	static const uint8_t Pattern[16] = { 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A, 0x5A };
+	uint8_t State[STATE_SIZE];
+	uint8_t After[STATE_SIZE];
+	int Match;
+
+	(void)pContext;
+	JOURNAL_Replay();
+	Snapshot(State);
+	for (Match = SAVES; Match >= 0; Match--) {
+		if (memcmp(State, gShared->States[Match], STATE_SIZE) == 0) {
+			break;
+		}
+	}
+	if (Match < 0) {
+		printf("  cut at program %u: state is not after any whole save\n", gShared->CutAt);
+	} else if ((uint32_t)Match < gShared->Flushed) {
+		printf("  cut at program %u: lost flushed save %d\n", gShared->CutAt, Match);
+	}
+	CHECK(Match >= 0 && (uint32_t)Match >= gShared->Flushed);
+
+	// The recovered journal has to keep working across another boot.
+	JOURNAL_Write(VFO_START, Pattern, sizeof(Pattern));
+	JOURNAL_Write(INDEX_START, Pattern, INDEX_SIZE);
+	EEPROM_Flush();
+	Snapshot(State);
+	JOURNAL_Replay();
+	Snapshot(After);
+	CHECK(memcmp(State, After, sizeof(State)) == 0);
+}
+
+TEST(JournalSurvivesPowerCuts)
+{
+	uint16_t i;
+
+	gShared = mmap(NULL, sizeof(*gShared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	CHECK(gShared != MAP_FAILED);
+	for (i = VFO_START; i < INDEX_START + INDEX_SIZE; i++) {
+		gEesim->Memory[i] = (uint8_t)(i * 7);
+	}
+	memcpy(gShared->Base, gEesim->Memory, EESIM_SIZE);
+
+	CHECK_EQUAL(0, HOST_Fork(RecordStates, NULL));
+	CHECK(gShared->Programs > SAVES / 4);
+
+	for (gShared->CutAt = 0; gShared->CutAt < gShared->Programs && !gTestFailures; gShared->CutAt++) {
+		memcpy(gEesim->Memory, gShared->Base, EESIM_SIZE);
+		gShared->Flushed = 0;
+		CHECK_EQUAL(HOST_EXIT_POWER_CUT, HOST_Fork(RunUntilCut, NULL));
+		CHECK_EQUAL(0, HOST_Fork(BootAndCheck, NULL));
+	}
+}
+#endif
+
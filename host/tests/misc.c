@@ -0,0 +1,83 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "frequencies.h"
+#include "host/test.h"
+#include "misc.h"
+
+// NUMBER_FormatFixed against the float sprintf calls it replaced, over
+// every value each caller can pass. The scale factors are the ones those
+// calls multiplied by, and the reference is the C library's %.Nf since the
+// printf submodule is not part of the host build.
+
+static uint32_t gMismatches;
+
+static void Compare(uint32_t Value, uint8_t Decimals, double Scale)
+{
+	char Expected[32];
+	char String[32];
+	uint8_t Length;
+
+	snprintf(Expected, sizeof(Expected), "%.*f", Decimals, Value * Scale);
+	Length = NUMBER_FormatFixed(String, Value, Decimals);
+	if (strcmp(String, Expected) || Length != strlen(Expected)) {
+		if (gMismatches++ == 0) {
+			printf("  %u at %u decimals: \"%s\" instead of \"%s\"\n", (unsigned int)Value, Decimals, String, Expected);
+		}
+	}
+}
+
+static void CompareRange(uint32_t First, uint32_t Last, uint32_t Stride, uint8_t Decimals, double Scale)
+{
+	uint32_t Value;
+
+	for (Value = First; Value <= Last; Value += Stride) {
+		Compare(Value, Decimals, Scale);
+	}
+	Compare(Last, Decimals, Scale);
+}
+
+// CTCSS tones, 0.1 Hz units.
+TEST(FormatFixedMatchesTones)
+{
+	CompareRange(0, 0xFFFF, 1, 1, 0.1);
+	CHECK_EQUAL(0, gMismatches);
+}
+
+// Step sizes and battery voltages, 0.01 units.
+TEST(FormatFixedMatchesStepsAndVoltages)
+{
+	CompareRange(0, 0xFFFF, 1, 2, 0.01);
+	CHECK_EQUAL(0, gMismatches);
+}
+
+// Frequencies and offsets, 10 Hz units. Every offset the menu can enter,
+// every 1.25 kHz across the bands and every value around the band edges.
+TEST(FormatFixedMatchesFrequencies)
+{
+	uint8_t i;
+
+	CompareRange(0, 1000074, 1, 5, 1e-05);
+	CompareRange(LowerLimitFrequencyBandTable[0], UpperLimitFrequencyBandTable[ARRAY_SIZE(UpperLimitFrequencyBandTable) - 1], 125, 5, 1e-05);
+	for (i = 0; i < ARRAY_SIZE(LowerLimitFrequencyBandTable); i++) {
+		CompareRange(LowerLimitFrequencyBandTable[i] - 5000, LowerLimitFrequencyBandTable[i] + 5000, 1, 5, 1e-05);
+		CompareRange(UpperLimitFrequencyBandTable[i] - 5000, UpperLimitFrequencyBandTable[i] + 5000, 1, 5, 1e-05);
+	}
+	CHECK_EQUAL(0, gMismatches);
+}
+
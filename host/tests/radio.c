@@ -0,0 +1,387 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "driver/eeprom.h"
+#include "frequencies.h"
+#include "host/eeprom-sim.h"
+#include "host/host.h"
+#include "host/test.h"
+#include "misc.h"
+#include "radio.h"
+#include "settings.h"
+
+#if defined(ENABLE_CHANNEL_CACHE)
+// The channel cache against every way a channel record can change under
+// it: a channel save, a save of the other VFO's band and a raw write such
+// as a UART or AirCopy block.
+
+#define CHANNELS	20U
+
+static uint32_t GetFrequency(uint8_t Channel)
+{
+	return 14500000U + (Channel * 1250U);
+}
+
+static void PutRecord(uint16_t Base, uint32_t Frequency)
+{
+	memset(&gEesim->Memory[Base], 0, 16);
+	memcpy(&gEesim->Memory[Base], &Frequency, sizeof(Frequency));
+}
+
+// Memory channels 0 to CHANNELS - 1 on 2 m, each with its own frequency and
+// name, and the 2 m band of both VFOs, before the radio boots.
+static void Boot(void)
+{
+	uint8_t i;
+
+	for (i = 0; i < CHANNELS; i++) {
+		PutRecord(i * 16, GetFrequency(i));
+		memset(&gEesim->Memory[0x0F50 + (i * 16)], 'A' + i, 10);
+		gEesim->Memory[0x0D60 + i] = MR_CH_SCANLIST1 | BAND3_136MHz;
+	}
+	PutRecord(0x0C80 + (BAND3_136MHz * 32), 14400000);
+	PutRecord(0x0C90 + (BAND3_136MHz * 32), 14410000);
+	gEesim->Memory[0x0D60 + FREQ_CHANNEL_FIRST + BAND3_136MHz] = BAND3_136MHz;
+	HOST_Boot();
+}
+
+static const VFO_Info_t *Load(uint8_t VFO, uint8_t Channel)
+{
+	gEeprom.ScreenChannel[VFO] = Channel;
+	RADIO_ConfigureChannel(VFO, VFO_CONFIGURE_RELOAD);
+
+	return &gEeprom.VfoInfo[VFO];
+}
+
+TEST(ChannelCacheServesReloads)
+{
+	uint16_t Misses;
+	uint8_t i;
+
+	Boot();
+	Load(0, 3);
+	Misses = gChannelCacheMisses;
+	CHECK_EQUAL(GetFrequency(3), Load(0, 3)->ConfigRX.Frequency);
+	CHECK_EQUAL('D', Load(0, 3)->Name[0]);
+	CHECK_EQUAL(Misses, gChannelCacheMisses);
+
+	// Going through more channels than the cache holds drops the one used
+	// longest ago, and only that one.
+	for (i = 0; i < CHANNEL_CACHE_SIZE; i++) {
+		Load(0, 4 + i);
+	}
+	Misses = gChannelCacheMisses;
+	Load(0, 4 + CHANNEL_CACHE_SIZE - 1);
+	CHECK_EQUAL(Misses, gChannelCacheMisses);
+	CHECK_EQUAL(GetFrequency(3), Load(0, 3)->ConfigRX.Frequency);
+	CHECK_EQUAL(Misses + 1, gChannelCacheMisses);
+}
+
+TEST(ChannelCacheSeesSavedChannels)
+{
+	VFO_Info_t Info;
+
+	Boot();
+	Info = *Load(0, 5);
+	Load(0, 6);
+	Info.ConfigRX.Frequency = 14600000;
+	SETTINGS_SaveChannel(5, 0, &Info, 2);
+
+	// Straight from the cache, before the write has reached the EEPROM.
+	CHECK_EQUAL(14600000, Load(0, 5)->ConfigRX.Frequency);
+	// A save clears the name.
+	CHECK_EQUAL(0xFF, (uint8_t)Load(0, 5)->Name[0]);
+	// Its neighbours are not touched.
+	CHECK_EQUAL(GetFrequency(6), Load(0, 6)->ConfigRX.Frequency);
+	CHECK_EQUAL('E', Load(0, 4)->Name[0]);
+
+	EEPROM_Flush();
+	CHECK_EQUAL(14600000, Load(0, 5)->ConfigRX.Frequency);
+}
+
+TEST(ChannelCacheSeesSavedBands)
+{
+	const uint8_t Channel = FREQ_CHANNEL_FIRST + BAND3_136MHz;
+	VFO_Info_t Info;
+
+	uint16_t Misses;
+
+	Boot();
+	CHECK_EQUAL(14400000, Load(0, Channel)->ConfigRX.Frequency);
+	Info = *Load(1, Channel);
+	CHECK_EQUAL(14410000, Info.ConfigRX.Frequency);
+	Misses = gChannelCacheMisses;
+	Info.ConfigRX.Frequency = 14700000;
+	SETTINGS_SaveChannel(Channel, 1, &Info, 2);
+
+	// Each VFO has its own record for a band. The save drops both, and only
+	// VFO B's changed.
+	CHECK_EQUAL(14700000, Load(1, Channel)->ConfigRX.Frequency);
+	CHECK_EQUAL(14400000, Load(0, Channel)->ConfigRX.Frequency);
+	CHECK_EQUAL(Misses + 2, gChannelCacheMisses);
+}
+
+TEST(ChannelCacheDropsEverythingOnRawWrites)
+{
+	const uint32_t Frequency = 14800000;
+	uint16_t Misses;
+
+	Boot();
+	Load(0, 7);
+	Load(0, 8);
+
+	// A UART or AirCopy block goes straight to the EEPROM.
+	EEPROM_WritePages(7 * 16, &Frequency, sizeof(Frequency));
+	CHECK_EQUAL(GetFrequency(7), Load(0, 7)->ConfigRX.Frequency);
+	RADIO_InvalidateChannels();
+	Misses = gChannelCacheMisses;
+	CHECK_EQUAL(Frequency, Load(0, 7)->ConfigRX.Frequency);
+	CHECK_EQUAL(GetFrequency(8), Load(0, 8)->ConfigRX.Frequency);
+	CHECK_EQUAL(Misses + 2, gChannelCacheMisses);
+}
+#endif
+
+
+// Channel stepping through the channel maps against the walk it replaced,
+// which tried each channel in turn with RADIO_CheckValidChannel's rules.
+
+static bool ReferenceIsValid(uint8_t Channel, bool bCheckScanList, uint8_t VFO)
+{
+	const uint8_t Attributes = gMR_ChannelAttributes[Channel];
+
+	if ((Attributes & MR_CH_BAND_MASK) > BAND7_470MHz) {
+		return false;
+	}
+	if (!bCheckScanList || VFO > 1) {
+		return true;
+	}
+	if ((Attributes & (VFO == 0 ? MR_CH_SCANLIST1 : MR_CH_SCANLIST2)) == 0) {
+		return false;
+	}
+
+	return Channel != gEeprom.SCANLIST_PRIORITY_CH1[VFO] && Channel != gEeprom.SCANLIST_PRIORITY_CH2[VFO];
+}
+
+static uint8_t ReferenceFindNext(uint8_t Channel, int8_t Direction, bool bCheckScanList, uint8_t VFO)
+{
+	uint8_t i;
+
+	for (i = 0; i <= MR_CHANNEL_LAST; i++) {
+		if (Channel == 0xFF) {
+			Channel = MR_CHANNEL_LAST;
+		} else if (Channel > MR_CHANNEL_LAST) {
+			Channel = MR_CHANNEL_FIRST;
+		}
+		if (ReferenceIsValid(Channel, bCheckScanList, VFO)) {
+			return Channel;
+		}
+		Channel += Direction;
+	}
+
+	return 0xFF;
+}
+
+// Every memory channel gets Attributes, then the maps are built again as
+// they are at boot.
+static void SetLayout(uint8_t Attributes)
+{
+	memset(gMR_ChannelAttributes, Attributes, MR_CHANNEL_LAST + 1);
+	gEeprom.SCANLIST_PRIORITY_CH1[0] = 0xFF;
+	gEeprom.SCANLIST_PRIORITY_CH2[0] = 0xFF;
+	gEeprom.SCANLIST_PRIORITY_CH1[1] = 0xFF;
+	gEeprom.SCANLIST_PRIORITY_CH2[1] = 0xFF;
+	RADIO_InitChannelMaps();
+}
+
+static void SetChannel(uint8_t Channel, uint8_t Attributes)
+{
+	gMR_ChannelAttributes[Channel] = Attributes;
+	RADIO_UpdateChannelMaps(Channel);
+}
+
+static uint32_t gRandom = 1;
+
+static uint32_t Random(void)
+{
+	gRandom = (gRandom * 1103515245U) + 12345U;
+
+	return gRandom >> 16;
+}
+
+static uint32_t CompareWithReference(void)
+{
+	uint32_t Mismatches = 0;
+	uint16_t Start;
+	uint8_t VFO;
+	uint8_t i;
+
+	for (i = 0; i < 4; i++) {
+		const bool bCheckScanList = i & 1U;
+		const int8_t Direction = (i & 2U) ? RADIO_CHANNEL_DOWN : RADIO_CHANNEL_UP;
+
+		for (VFO = 0; VFO < 3; VFO++) {
+			for (Start = 0; Start <= 0xFF; Start++) {
+				const uint8_t Expected = ReferenceFindNext(Start, Direction, bCheckScanList, VFO);
+				const uint8_t Next = RADIO_FindNextChannel(Start, Direction, bCheckScanList, VFO);
+
+				if (Next != Expected && Mismatches++ == 0) {
+					printf("  from %u by %d, list %u of VFO %u: %u instead of %u\n", Start, Direction, bCheckScanList, VFO, Next, Expected);
+				}
+			}
+		}
+	}
+
+	return Mismatches;
+}
+
+TEST(ChannelStepsMatchTheLinearWalk)
+{
+	uint16_t Layout;
+	uint8_t Channel;
+
+	HOST_Boot();
+	for (Layout = 0; Layout < 64; Layout++) {
+		// From nearly empty to nearly full, with the priority channels
+		// sometimes on scan list members.
+		const uint32_t Density = (Layout * 1024U) / 64U;
+
+		for (Channel = 0; Channel <= MR_CHANNEL_LAST; Channel++) {
+			uint8_t Attributes = 0xFF;
+
+			if ((Random() % 1024U) < Density) {
+				Attributes = (Random() % (BAND7_470MHz + 1)) | (Random() & (MR_CH_SCANLIST1 | MR_CH_SCANLIST2));
+			}
+			gMR_ChannelAttributes[Channel] = Attributes;
+		}
+		gEeprom.SCANLIST_PRIORITY_CH1[0] = Random() % (MR_CHANNEL_LAST + 2);
+		gEeprom.SCANLIST_PRIORITY_CH2[0] = Random() % (MR_CHANNEL_LAST + 2);
+		gEeprom.SCANLIST_PRIORITY_CH1[1] = Random() % (MR_CHANNEL_LAST + 2);
+		gEeprom.SCANLIST_PRIORITY_CH2[1] = 0xFF;
+		RADIO_InitChannelMaps();
+		CHECK_EQUAL(0, CompareWithReference());
+	}
+}
+
+TEST(ChannelStepsWrapAround)
+{
+	HOST_Boot();
+	SetLayout(0xFF);
+	SetChannel(5, BAND6_400MHz);
+	SetChannel(100, BAND6_400MHz);
+	SetChannel(MR_CHANNEL_LAST, BAND6_400MHz);
+
+	CHECK_EQUAL(100, RADIO_FindNextChannel(6, RADIO_CHANNEL_UP, false, 0));
+	CHECK_EQUAL(5, RADIO_FindNextChannel(MR_CHANNEL_LAST + 1, RADIO_CHANNEL_UP, false, 0));
+	CHECK_EQUAL(MR_CHANNEL_LAST, RADIO_FindNextChannel(4, RADIO_CHANNEL_DOWN, false, 0));
+	CHECK_EQUAL(MR_CHANNEL_LAST, RADIO_FindNextChannel(0xFF, RADIO_CHANNEL_DOWN, false, 0));
+
+	// The channels at either end, across a map word and on their own.
+	SetChannel(MR_CHANNEL_LAST, 0xFF);
+	SetChannel(MR_CHANNEL_FIRST, BAND6_400MHz);
+	CHECK_EQUAL(MR_CHANNEL_FIRST, RADIO_FindNextChannel(101, RADIO_CHANNEL_UP, false, 0));
+	CHECK_EQUAL(100, RADIO_FindNextChannel(MR_CHANNEL_FIRST - 1, RADIO_CHANNEL_DOWN, false, 0));
+	SetChannel(5, 0xFF);
+	SetChannel(100, 0xFF);
+	CHECK_EQUAL(MR_CHANNEL_FIRST, RADIO_FindNextChannel(MR_CHANNEL_FIRST, RADIO_CHANNEL_UP, false, 0));
+	CHECK_EQUAL(MR_CHANNEL_FIRST, RADIO_FindNextChannel(MR_CHANNEL_FIRST + 1, RADIO_CHANNEL_UP, false, 0));
+	CHECK_EQUAL(MR_CHANNEL_FIRST, RADIO_FindNextChannel(MR_CHANNEL_FIRST - 1, RADIO_CHANNEL_DOWN, false, 0));
+	CHECK_EQUAL(0, CompareWithReference());
+}
+
+TEST(ChannelStepsFindNothingInEmptyBands)
+{
+	uint16_t Start;
+
+	HOST_Boot();
+	SetLayout(0xFF);
+	for (Start = 0; Start <= 0xFF; Start++) {
+		CHECK_EQUAL(0xFF, RADIO_FindNextChannel(Start, RADIO_CHANNEL_UP, false, 0));
+		CHECK_EQUAL(0xFF, RADIO_FindNextChannel(Start, RADIO_CHANNEL_DOWN, true, 1));
+	}
+
+	// Valid channels, none of them on scan list 2.
+	SetLayout(MR_CH_SCANLIST1 | BAND3_136MHz);
+	CHECK_EQUAL(0xFF, RADIO_FindNextChannel(50, RADIO_CHANNEL_UP, true, 1));
+	CHECK_EQUAL(51, RADIO_FindNextChannel(51, RADIO_CHANNEL_UP, true, 0));
+
+	// A scan list of nothing but its priority channels.
+	SetLayout(BAND3_136MHz);
+	SetChannel(20, MR_CH_SCANLIST2 | BAND3_136MHz);
+	SetChannel(40, MR_CH_SCANLIST2 | BAND3_136MHz);
+	gEeprom.SCANLIST_PRIORITY_CH1[1] = 20;
+	gEeprom.SCANLIST_PRIORITY_CH2[1] = 40;
+	RADIO_InitChannelMaps();
+	CHECK_EQUAL(0xFF, RADIO_FindNextChannel(0, RADIO_CHANNEL_UP, true, 1));
+	CHECK_EQUAL(20, RADIO_FindNextChannel(20, RADIO_CHANNEL_UP, false, 1));
+	CHECK_EQUAL(0, CompareWithReference());
+}
+
+// A channel saved or deleted from the menu moves in and out of the maps.
+TEST(ChannelStepsFollowSavedChannels)
+{
+	VFO_Info_t Info;
+
+	HOST_Boot();
+	SetLayout(0xFF);
+	memset(&Info, 0, sizeof(Info));
+	Info.Band = BAND6_400MHz;
+	Info.SCANLIST1_PARTICIPATION = true;
+	SETTINGS_UpdateChannel(77, &Info, true);
+	CHECK_EQUAL(77, RADIO_FindNextChannel(0, RADIO_CHANNEL_UP, true, 0));
+	CHECK_EQUAL(0xFF, RADIO_FindNextChannel(0, RADIO_CHANNEL_UP, true, 1));
+	SETTINGS_UpdateChannel(77, &Info, false);
+	CHECK_EQUAL(0xFF, RADIO_FindNextChannel(0, RADIO_CHANNEL_UP, false, 0));
+}
+
+static void BenchStepping(const char *pLayout)
+{
+	const uint32_t Count = 200000;
+	uint64_t Start;
+	uint8_t Channel;
+	uint32_t i;
+
+	Channel = 0;
+	Start = HOST_GetNanoseconds();
+	for (i = 0; i < Count; i++) {
+		Channel = RADIO_FindNextChannel(Channel + 1, RADIO_CHANNEL_UP, true, 0);
+	}
+	printf("  %-6s %6.1f ns per step", pLayout, (double)(HOST_GetNanoseconds() - Start) / Count);
+
+	Channel = 0;
+	Start = HOST_GetNanoseconds();
+	for (i = 0; i < Count; i++) {
+		Channel = ReferenceFindNext(Channel + 1, RADIO_CHANNEL_UP, true, 0);
+	}
+	printf(", %6.1f ns walking\n", (double)(HOST_GetNanoseconds() - Start) / Count);
+}
+
+// Stepping through scan list 1 as the scanner does, with every channel on
+// it and with a few spread over the memory.
+BENCH(ChannelStepping)
+{
+	HOST_Boot();
+	SetLayout(MR_CH_SCANLIST1 | BAND6_400MHz);
+	BenchStepping("dense");
+
+	SetLayout(0xFF);
+	SetChannel(3, MR_CH_SCANLIST1 | BAND6_400MHz);
+	SetChannel(71, MR_CH_SCANLIST1 | BAND6_400MHz);
+	SetChannel(150, MR_CH_SCANLIST1 | BAND6_400MHz);
+	BenchStepping("sparse");
+}
+
@@ -0,0 +1,328 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "app/app.h"
+#if defined(ENABLE_SCAN_HISTORY)
+#include "app/history.h"
+#endif
+#include "driver/bk4819.h"
+#include "frequencies.h"
+#include "functions.h"
+#include "host/bk4819-sim.h"
+#include "host/eeprom-sim.h"
+#include "host/host.h"
+#include "host/test.h"
+#include "misc.h"
+#include "radio.h"
+#if defined(ENABLE_SCAN_HISTORY)
+#include "scanhistory.h"
+#endif
+#include "settings.h"
+
+// The memory scan run through the main loop against the BK4819 model: ten
+// channels on scan list 1 and a priority channel that is not on it.
+
+#define CHANNELS		10U
+#define PRIORITY_CHANNEL	20U
+#define SIGNAL_RSSI		120U
+
+static uint32_t GetFrequency(uint8_t Channel)
+{
+	if (Channel == PRIORITY_CHANNEL) {
+		return 44600625U;
+	}
+
+	return 43300000U + (Channel * 2500U);
+}
+
+static void PutChannel(uint8_t Channel, uint8_t Attributes)
+{
+	const uint32_t Frequency = GetFrequency(Channel);
+
+	memset(&gEesim->Memory[Channel * 16], 0, 16);
+	memcpy(&gEesim->Memory[Channel * 16], &Frequency, sizeof(Frequency));
+	gEesim->Memory[0x0D60 + Channel] = Attributes;
+}
+
+// Squelch rows that open on SIGNAL_RSSI and stay shut on the model's empty
+// channel, whose noise and glitch are past the close levels, so a scan step
+// leaves it after the probe. With the close levels at their ceilings the
+// probe never finds a channel empty and every step gets its full dwell.
+static const uint8_t gAdaptiveSquelch[6] = { 90, 80, 40, 50, 60, 40 };
+static const uint8_t gFixedSquelch[6] = { 90, 80, 40, 0x7F, 0xFF, 40 };
+
+static void PutSquelch(const uint8_t *pRow)
+{
+	uint8_t Level;
+	uint8_t i;
+
+	for (Level = 1; Level < 10; Level++) {
+		for (i = 0; i < 6; i++) {
+			gEesim->Memory[0x1E00 + Level + (i * 0x10)] = pRow[i];
+			gEesim->Memory[0x1E60 + Level + (i * 0x10)] = pRow[i];
+		}
+	}
+}
+
+static void StartScan(const uint8_t *pSquelch, uint8_t Priority)
+{
+	uint8_t i;
+
+	for (i = 0; i < CHANNELS; i++) {
+		PutChannel(i, MR_CH_SCANLIST1 | BAND6_400MHz);
+	}
+	PutChannel(PRIORITY_CHANNEL, BAND6_400MHz);
+	PutSquelch(pSquelch);
+	HOST_Boot();
+
+	gEeprom.SQUELCH_LEVEL = 3;
+	gEeprom.DUAL_WATCH = DUAL_WATCH_OFF;
+	gEeprom.CROSS_BAND_RX_TX = CROSS_BAND_OFF;
+	gEeprom.SCAN_LIST_DEFAULT = 0;
+	gEeprom.SCAN_LIST_ENABLED[0] = true;
+	gEeprom.SCANLIST_PRIORITY_CH1[0] = Priority;
+	gEeprom.SCANLIST_PRIORITY_CH2[0] = 0xFF;
+	gEeprom.TX_VFO = 0;
+	gEeprom.ScreenChannel[0] = 0;
+	gEeprom.MrChannel[0] = 0;
+	RADIO_ConfigureChannel(0, VFO_CONFIGURE_RELOAD);
+	RADIO_SelectVfos();
+	RADIO_SetupRegisters(true);
+	HOST_Run(100000);
+	CHANNEL_Next(true, 1);
+}
+
+// Runs the main loop until the radio is receiving the priority channel and
+// returns how long that took, in microseconds.
+static uint32_t WaitForPriority(void)
+{
+	const uint64_t Start = gHostMicroseconds;
+
+	while (gHostMicroseconds - Start < 2U * PRIORITY_LOOKBACK_INTERVAL * 10000U) {
+		HOST_Run(1000);
+		if (gEeprom.MrChannel[0] == PRIORITY_CHANNEL && gCurrentFunction == FUNCTION_RECEIVE && BKSIM_GetFrequency() == GetFrequency(PRIORITY_CHANNEL)) {
+			return gHostMicroseconds - Start;
+		}
+	}
+
+	return 0xFFFFFFFFU;
+}
+
+// A look-back goes out of the interval at most once, and takes one 10 ms
+// time slice for the priority channel and one for getting back.
+static const uint32_t gLatencyLimit = (PRIORITY_LOOKBACK_INTERVAL + 2U) * 10000U;
+
+TEST(PriorityLookbackInterruptsTraffic)
+{
+	const uint32_t Busy = GetFrequency(3);
+	uint32_t Away;
+	uint32_t Latency;
+	uint32_t i;
+
+	StartScan(gAdaptiveSquelch, PRIORITY_CHANNEL);
+	BKSIM_AddSignal(Busy, 0, ~0ULL, SIGNAL_RSSI);
+	HOST_Run(1000000);
+	CHECK_EQUAL(3, gEeprom.MrChannel[0]);
+	CHECK_EQUAL(FUNCTION_RECEIVE, gCurrentFunction);
+
+	// While the priority channel is quiet the receiver leaves the busy one
+	// once per interval, for one time slice. No pass of the main loop takes
+	// more than the bus traffic, let alone the 5 ms the dwell used to be.
+	Away = 0;
+	for (i = 0; i < (3U * PRIORITY_LOOKBACK_INTERVAL * 10U); i++) {
+		CHECK(HOST_Run(1000) < 2000);
+		if (BKSIM_GetFrequency() != Busy) {
+			Away += 1000;
+		}
+	}
+	CHECK(Away >= 2U * 10000U);
+	CHECK(Away <= 3U * 11000U);
+	CHECK_EQUAL(3, gEeprom.MrChannel[0]);
+	CHECK_EQUAL(FUNCTION_RECEIVE, gCurrentFunction);
+	CHECK(gBksim.Registers[BK4819_REG_3F] != 0);
+
+	BKSIM_AddSignal(GetFrequency(PRIORITY_CHANNEL), gHostMicroseconds, ~0ULL, SIGNAL_RSSI);
+	Latency = WaitForPriority();
+	printf("  parked:   %u ms to the priority channel\n", Latency / 1000);
+	CHECK(Latency <= gLatencyLimit);
+}
+
+TEST(PriorityLookbackInterruptsStepping)
+{
+	uint32_t Latency;
+
+	StartScan(gAdaptiveSquelch, PRIORITY_CHANNEL);
+	HOST_Run(1230000);
+	CHECK(gEeprom.MrChannel[0] < CHANNELS);
+	BKSIM_AddSignal(GetFrequency(PRIORITY_CHANNEL), gHostMicroseconds, ~0ULL, SIGNAL_RSSI);
+	Latency = WaitForPriority();
+	printf("  stepping: %u ms to the priority channel\n", Latency / 1000);
+	CHECK(Latency <= gLatencyLimit);
+}
+
+#if defined(ENABLE_SCAN_HISTORY)
+// A carrier the scan stops on is logged with its channel and when the
+// squelch closed again, and counted against the channel.
+TEST(ScanHitsAreRecorded)
+{
+	const HISTORY_Entry_t *pEntry;
+	uint32_t End;
+
+	StartScan(gAdaptiveSquelch, 0xFF);
+	End = gGlobalSysTickCounter + 110U;
+	BKSIM_AddSignal(GetFrequency(6), gHostMicroseconds + 100000U, gHostMicroseconds + 1100000U, SIGNAL_RSSI);
+	HOST_Run(3000000);
+	CHECK_EQUAL(1, HISTORY_GetCount());
+	pEntry = HISTORY_Get(0);
+	CHECK_EQUAL(6, pEntry->Channel);
+	CHECK_EQUAL(GetFrequency(6), pEntry->Frequency);
+	CHECK(pEntry->Rssi >= SIGNAL_RSSI / 2U);
+	CHECK(pEntry->Duration < 100);
+	CHECK(pEntry->Tick + pEntry->Duration >= End);
+	CHECK(pEntry->Tick + pEntry->Duration <= End + 2U);
+	CHECK_EQUAL(1, HISTORY_GetHits(6));
+}
+#endif
+
+// Adaptive against fixed dwell over synthetic occupancy traces: bursts of
+// carrier at random times on random channels of the list, the same bursts
+// for both. The scan resumes when the carrier drops, and a burst counts as
+// heard once the radio receives it.
+
+#define TRACE_US		60000000U
+
+typedef struct {
+	const char *pName;
+	uint8_t Count;
+	uint32_t ShortestUs;
+	uint32_t LongestUs;
+} Trace_t;
+
+typedef struct {
+	const Trace_t *pTrace;
+	const char *pDwell;
+	const uint8_t *pSquelch;
+} TraceRun_t;
+
+typedef struct {
+	uint8_t Channel;
+	uint64_t Start;
+	uint64_t End;
+	uint64_t Heard;
+} Burst_t;
+
+static const Trace_t gTraces[] = {
+	{ "empty",  0,                 0,       0 },
+	{ "sparse", 15,          300000U, 2000000U },
+	{ "busy",   BKSIM_MAX_SIGNALS, 500000U, 3000000U },
+};
+
+static Burst_t gBursts[BKSIM_MAX_SIGNALS];
+static uint32_t gRandom;
+
+static uint32_t Random(void)
+{
+	gRandom = (gRandom * 1103515245U) + 12345U;
+
+	return gRandom >> 16;
+}
+
+static void PutTrace(const Trace_t *pTrace, uint64_t Start)
+{
+	uint8_t i;
+
+	gRandom = 1;
+	for (i = 0; i < pTrace->Count; i++) {
+		Burst_t *pBurst = &gBursts[i];
+		const uint32_t Length = pTrace->ShortestUs + (((uint64_t)Random() * Random()) % (pTrace->LongestUs - pTrace->ShortestUs));
+
+		pBurst->Channel = Random() % CHANNELS;
+		pBurst->Start = Start + (((uint64_t)Random() * Random()) % (TRACE_US - pTrace->LongestUs));
+		pBurst->End = pBurst->Start + Length;
+		pBurst->Heard = 0;
+		BKSIM_AddSignal(GetFrequency(pBurst->Channel), pBurst->Start, pBurst->End, SIGNAL_RSSI);
+	}
+}
+
+static void RunTrace(void *pContext)
+{
+	const TraceRun_t *pRun = (const TraceRun_t *)pContext;
+	const Trace_t *pTrace = pRun->pTrace;
+	uint64_t Start;
+	uint64_t Latency;
+	uint32_t Steps;
+	uint8_t Channel;
+	uint8_t Heard;
+	uint8_t i;
+
+	StartScan(pRun->pSquelch, 0xFF);
+	gEeprom.SCAN_RESUME_MODE = SCAN_RESUME_CO;
+	Start = gHostMicroseconds;
+	PutTrace(pTrace, Start);
+
+	Steps = 0;
+	Channel = gEeprom.MrChannel[0];
+	while (gHostMicroseconds - Start < TRACE_US) {
+		HOST_Run(1000);
+		if (gEeprom.MrChannel[0] != Channel) {
+			Channel = gEeprom.MrChannel[0];
+			Steps++;
+		}
+		if (gCurrentFunction != FUNCTION_RECEIVE || BKSIM_GetFrequency() != GetFrequency(Channel)) {
+			continue;
+		}
+		for (i = 0; i < pTrace->Count; i++) {
+			Burst_t *pBurst = &gBursts[i];
+
+			if (pBurst->Channel == Channel && pBurst->Heard == 0 && gHostMicroseconds >= pBurst->Start && gHostMicroseconds < pBurst->End) {
+				pBurst->Heard = gHostMicroseconds;
+			}
+		}
+	}
+
+	Heard = 0;
+	Latency = 0;
+	for (i = 0; i < pTrace->Count; i++) {
+		if (gBursts[i].Heard) {
+			Heard++;
+			Latency += gBursts[i].Heard - gBursts[i].Start;
+		}
+	}
+	if (pTrace->Count == 0) {
+		printf("  %-6s %-8s %5u steps, %3u ms per step\n", pTrace->pName, pRun->pDwell, Steps, (unsigned int)(TRACE_US / 1000U / Steps));
+	} else {
+		printf("  %-6s %-8s %5u steps, %2u of %2u bursts heard, %4u ms mean latency\n", pTrace->pName, pRun->pDwell, Steps, Heard, pTrace->Count, Heard ? (unsigned int)(Latency / Heard / 1000U) : 0U);
+	}
+}
+
+BENCH(ScanDwell)
+{
+	TraceRun_t Run;
+	uint8_t i;
+
+	for (i = 0; i < ARRAY_SIZE(gTraces); i++) {
+		Run.pTrace = &gTraces[i];
+		Run.pDwell = "fixed";
+		Run.pSquelch = gFixedSquelch;
+		CHECK_EQUAL(0, HOST_Fork(RunTrace, &Run));
+		Run.pDwell = "adaptive";
+		Run.pSquelch = gAdaptiveSquelch;
+		CHECK_EQUAL(0, HOST_Fork(RunTrace, &Run));
+	}
+}
+
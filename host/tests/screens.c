@@ -0,0 +1,195 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(ENABLE_AIRCOPY)
+#include "app/aircopy.h"
+#endif
+#include "app/main.h"
+#include "app/menu.h"
+#include "driver/st7565.h"
+#include "host/eeprom-sim.h"
+#include "host/host.h"
+#include "host/screen.h"
+#include "host/test.h"
+#include "misc.h"
+#include "ui/inputbox.h"
+#include "ui/lock.h"
+#include "ui/menu.h"
+#include "ui/status.h"
+#include "ui/ui.h"
+#include "ui/widget.h"
+
+// Golden images of every screen, rendered from a blank EEPROM and compared
+// pixel for pixel with host/golden. `make host-golden` writes them again
+// after a change that is meant to alter how a screen looks. HOST_SCREENS
+// names another directory to write to instead of comparing, and
+// HOST_EEPROM a captured EEPROM image to boot from, to look at the screens
+// of a real radio's settings.
+
+typedef struct {
+	const char *pName;
+	void (*pShow)(void);
+} Screen_t;
+
+static void Boot(void)
+{
+	const char *pImage = getenv("HOST_EEPROM");
+
+	if (pImage) {
+		FILE *pFile = fopen(pImage, "rb");
+
+		CHECK(pFile != NULL);
+		if (pFile) {
+			CHECK_EQUAL(EESIM_SIZE, fread(gEesim->Memory, 1, EESIM_SIZE, pFile));
+			fclose(pFile);
+		}
+	}
+	HOST_Boot();
+	UI_DisplayStatus();
+}
+
+static void Show(GUI_DisplayType_t Screen)
+{
+	GUI_SelectNextDisplay(Screen);
+	GUI_DisplayScreen();
+	ST7565_WaitForBlit();
+}
+
+static void ShowMain(void)
+{
+	Boot();
+	gVFO_RSSI_Level[0] = 4;
+	Show(DISPLAY_MAIN);
+}
+
+// Half way through typing a frequency.
+static void ShowMainInput(void)
+{
+	Boot();
+	Show(DISPLAY_MAIN);
+	MAIN_ProcessKeys(KEY_4, true, false);
+	MAIN_ProcessKeys(KEY_3, true, false);
+	MAIN_ProcessKeys(KEY_8, true, false);
+	Show(DISPLAY_MAIN);
+}
+
+static void ShowMenu(void)
+{
+	Boot();
+	gMenuCursor = MENU_SQL;
+	gIsInSubMenu = true;
+	MENU_ShowCurrentSetting();
+	Show(DISPLAY_MENU);
+}
+
+static void ShowScanner(void)
+{
+	Boot();
+	Show(DISPLAY_SCANNER);
+}
+
+static void ShowLock(void)
+{
+	Boot();
+	memset(gInputBox, 10, sizeof(gInputBox));
+	INPUTBOX_Append(1);
+	INPUTBOX_Append(2);
+	INPUTBOX_Append(3);
+	UI_DrawLock();
+}
+
+#if defined(ENABLE_MODEM)
+static void ShowModem(void)
+{
+	Boot();
+	Show(DISPLAY_MODEM);
+}
+#endif
+
+#if defined(ENABLE_AIRCOPY)
+static void ShowAircopy(void)
+{
+	Boot();
+	gAircopyState = AIRCOPY_READY;
+	Show(DISPLAY_AIRCOPY);
+}
+#endif
+
+static const Screen_t gScreens[] = {
+	{ "main", ShowMain },
+	{ "main-input", ShowMainInput },
+	{ "menu", ShowMenu },
+	{ "scanner", ShowScanner },
+	{ "lock", ShowLock },
+#if defined(ENABLE_MODEM)
+	{ "modem", ShowModem },
+#endif
+#if defined(ENABLE_AIRCOPY)
+	{ "aircopy", ShowAircopy },
+#endif
+};
+
+// Every screen gets a fresh process, as each boots the radio again.
+static void CheckScreen(void *pContext)
+{
+	const Screen_t *pScreen = (const Screen_t *)pContext;
+
+	gTestFailures = 0;
+	HOST_Reset();
+	pScreen->pShow();
+	SCREEN_Check(pScreen->pName);
+}
+
+TEST(ScreensMatchGoldenImages)
+{
+	uint8_t i;
+
+	for (i = 0; i < ARRAY_SIZE(gScreens); i++) {
+		if (HOST_Fork(CheckScreen, (void *)&gScreens[i])) {
+			printf("  %s failed\n", gScreens[i].pName);
+			CHECK(false);
+		}
+	}
+}
+
+// Host time to draw each screen from scratch, status line aside.
+BENCH(ScreenRenderTime)
+{
+	const uint32_t Count = 1000;
+	uint64_t Start;
+	uint32_t j;
+	uint8_t i;
+
+	for (i = 0; i < ARRAY_SIZE(gScreens); i++) {
+		HOST_Reset();
+		gScreens[i].pShow();
+		Start = HOST_GetNanoseconds();
+		for (j = 0; j < Count; j++) {
+			UI_InvalidateWidgets();
+			if (gScreens[i].pShow == ShowLock) {
+				UI_DrawLock();
+			} else {
+				GUI_DisplayScreen();
+			}
+			ST7565_WaitForBlit();
+		}
+		printf("  %-10s %6u ns\n", gScreens[i].pName, (unsigned int)((HOST_GetNanoseconds() - Start) / Count));
+	}
+}
+
@@ -0,0 +1,170 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+#include "driver/st7565.h"
+#include "host/dma-sim.h"
+#include "host/host.h"
+#include "host/test.h"
+
+// The dirty span bookkeeping, seen through the number of bytes each blit
+// sends. Every byte of the framebuffer is changed before a blit, so the
+// double buffer's diff never trims a span.
+
+static uint16_t Blit(bool bRetained)
+{
+	uint16_t i;
+
+	ST7565_WaitForBlit();
+	for (i = 0; i < sizeof(gFrameBuffer); i++) {
+		gFrameBuffer[i / 128][i % 128]++;
+	}
+	if (bRetained) {
+		ST7565_BlitRetained();
+	} else {
+		ST7565_BlitDirty();
+	}
+
+	return gDisplayBytesSent;
+}
+
+// Leaves the glass with nothing shown, so the next blit sends only what is
+// marked after this.
+static void Clear(void)
+{
+	ST7565_FillScreen(0x00);
+	CHECK_EQUAL(sizeof(gFrameBuffer), Blit(false));
+	CHECK_EQUAL(0, Blit(false));
+}
+
+TEST(DirtySpansMerge)
+{
+	Clear();
+	ST7565_MarkDirty(1, 10, 5);
+	ST7565_MarkDirty(1, 30, 5);
+	ST7565_MarkDirty(1, 12, 2);
+	// One span per line, from the first marked column to the last.
+	CHECK_EQUAL(25, Blit(true));
+
+	ST7565_MarkDirty(1, 40, 4);
+	ST7565_MarkDirty(3, 0, 1);
+	CHECK_EQUAL(5, Blit(true));
+	CHECK_EQUAL(0, Blit(true));
+}
+
+TEST(DirtySpansClip)
+{
+	Clear();
+	// Past the end of a line into the next one.
+	ST7565_MarkDirty(1, 120, 16);
+	CHECK_EQUAL(16, Blit(true));
+
+	// Past the end of the framebuffer.
+	ST7565_MarkDirty(6, 120, 100);
+	CHECK_EQUAL(8, Blit(true));
+
+	// Left of the first column.
+	ST7565_MarkDirty(2, -18, 99);
+	CHECK_EQUAL(81, Blit(true));
+	ST7565_MarkDirty(2, -18, 18);
+	ST7565_MarkDirty(2, -200, 10);
+	CHECK_EQUAL(0, Blit(true));
+}
+
+TEST(DirtySpansCoverWhatWasShown)
+{
+	Clear();
+	ST7565_MarkDirty(0, 10, 10);
+	ST7565_MarkDirty(4, 100, 8);
+	CHECK_EQUAL(18, Blit(false));
+
+	// The screen is drawn again from a cleared framebuffer, so the old
+	// columns have to go out with the new ones: 10..20 and 50..60 make
+	// 10..60 on line 0, and line 4 is only cleared.
+	ST7565_MarkDirty(0, 50, 10);
+	CHECK_EQUAL(50 + 8, Blit(false));
+
+	// Only line 0's 50..60 is shown now.
+	CHECK_EQUAL(10, Blit(false));
+	CHECK_EQUAL(0, Blit(false));
+}
+
+TEST(RetainedBlitsKeepWhatWasShown)
+{
+	Clear();
+	ST7565_MarkDirty(5, 0, 20);
+	CHECK_EQUAL(20, Blit(true));
+	ST7565_MarkDirty(5, 60, 4);
+	CHECK_EQUAL(4, Blit(true));
+
+	// A full redraw afterwards has to cover both, and everything between.
+	CHECK_EQUAL(64, Blit(false));
+}
+
+#if defined(ENABLE_DISPLAY_DMA)
+// A blit only starts the first line. Each of the others is started by
+// ST7565_ServiceBlit once the DMA interrupt says the one before is done,
+// as it would be from the main loop.
+TEST(DmaBlitsFinishInServiceBlit)
+{
+	const uint64_t Timeout = HOST_GetNanoseconds() + 1000000000U;
+
+	Clear();
+	ST7565_MarkDirty(1, 10, 10);
+	ST7565_MarkDirty(3, 0, 5);
+	ST7565_MarkDirty(6, 120, 8);
+	gDmasim.bHeld = true;
+	gDmasim.OutputSize = 0;
+	gDmasim.Transfers = 0;
+	gDmasim.Interrupts = 0;
+	CHECK_EQUAL(23, Blit(true));
+	CHECK(gDisplayBusy);
+	ST7565_ServiceBlit();
+	CHECK(gDisplayBusy);
+	CHECK_EQUAL(0, gDmasim.Transfers);
+
+	gDmasim.bHeld = false;
+	while (gDisplayBusy && HOST_GetNanoseconds() < Timeout) {
+		ST7565_ServiceBlit();
+	}
+	CHECK(!gDisplayBusy);
+	CHECK_EQUAL(3, gDmasim.Transfers);
+	CHECK_EQUAL(3, gDmasim.Interrupts);
+	CHECK_EQUAL(23, gDmasim.OutputSize);
+	CHECK(memcmp(gDmasim.Output, &gFrameBuffer[1][10], 10) == 0);
+	CHECK(memcmp(gDmasim.Output + 10, &gFrameBuffer[3][0], 5) == 0);
+	CHECK(memcmp(gDmasim.Output + 15, &gFrameBuffer[6][120], 8) == 0);
+}
+
+// Anything that needs the bus or the buffer waits for the blit, and the
+// wait itself moves the blit on.
+TEST(DmaBlitsFinishInWaitForBlit)
+{
+	uint16_t i;
+
+	Clear();
+	for (i = 0; i < sizeof(gFrameBuffer); i++) {
+		gFrameBuffer[i / 128][i % 128] = i * 7;
+	}
+	gDmasim.OutputSize = 0;
+	ST7565_BlitFullScreen();
+	ST7565_WaitForBlit();
+	CHECK(!gDisplayBusy);
+	CHECK_EQUAL(sizeof(gFrameBuffer), gDmasim.OutputSize);
+	CHECK(memcmp(gDmasim.Output, gFrameBuffer, sizeof(gFrameBuffer)) == 0);
+}
+#endif
+
@@ -0,0 +1,208 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+#include "app/uart.h"
+#include "bsp/dp32g030/dma.h"
+#include "driver/uart.h"
+#include "host/eeprom-sim.h"
+#include "host/host.h"
+#include "host/test.h"
+
+#if defined(ENABLE_UART)
+// Frames go in through the DMA ring and replies come back out of UART1,
+// so these run the real framing, CRC and command code end to end.
+
+#define TIMESTAMP	0x12345678U
+
+static uint16_t Crc16(const uint8_t *pData, uint16_t Size)
+{
+	uint16_t Crc = 0;
+	uint8_t i;
+
+	while (Size--) {
+		Crc ^= *pData++ << 8;
+		for (i = 0; i < 8; i++) {
+			Crc = (Crc & 0x8000U) ? (Crc << 1) ^ 0x1021U : Crc << 1;
+		}
+	}
+
+	return Crc;
+}
+
+// Sends a plain frame, which is what the host uses once 0x0514 has
+// switched the obfuscation off.
+static void SendFrame(const uint8_t *pPayload, uint16_t Size, bool bCorrupt)
+{
+	uint8_t Frame[256];
+	uint16_t Crc;
+
+	Crc = Crc16(pPayload, Size);
+	if (bCorrupt) {
+		Crc ^= 1;
+	}
+	Frame[0] = 0xAB;
+	Frame[1] = 0xCD;
+	Frame[2] = Size & 0xFFU;
+	Frame[3] = Size >> 8;
+	memcpy(Frame + 4, pPayload, Size);
+	Frame[4 + Size] = Crc & 0xFFU;
+	Frame[5 + Size] = Crc >> 8;
+	Frame[6 + Size] = 0xDC;
+	Frame[7 + Size] = 0xBA;
+	HOST_UartReceive(Frame, Size + 8);
+}
+
+static uint8_t HandleCommands(void)
+{
+	uint8_t Count = 0;
+
+	while (UART_IsCommandAvailable()) {
+		UART_HandleCommand();
+		Count++;
+	}
+
+	return Count;
+}
+
+static void PutWord(uint8_t *pData, uint16_t Value)
+{
+	pData[0] = Value & 0xFFU;
+	pData[1] = Value >> 8;
+}
+
+static void PutLong(uint8_t *pData, uint32_t Value)
+{
+	PutWord(pData, Value & 0xFFFFU);
+	PutWord(pData + 2, Value >> 16);
+}
+
+static uint16_t GetWord(const uint8_t *pData)
+{
+	return pData[0] | (pData[1] << 8);
+}
+
+static void SendHello(void)
+{
+	uint8_t Payload[8];
+
+	PutWord(Payload, 0x0514);
+	PutWord(Payload + 2, 4);
+	PutLong(Payload + 4, TIMESTAMP);
+	SendFrame(Payload, sizeof(Payload), false);
+}
+
+static void SendRead(uint16_t Offset, uint8_t Size, uint32_t Timestamp, bool bCorrupt)
+{
+	uint8_t Payload[12];
+
+	PutWord(Payload, 0x051B);
+	PutWord(Payload + 2, 8);
+	PutWord(Payload + 4, Offset);
+	Payload[6] = Size;
+	Payload[7] = 0;
+	PutLong(Payload + 8, Timestamp);
+	SendFrame(Payload, sizeof(Payload), bCorrupt);
+}
+
+// Checks the reply to a read of Size bytes at Offset and returns where
+// its data starts.
+static const uint8_t *CheckReadReply(uint16_t Offset, uint8_t Size)
+{
+	CHECK_EQUAL(Size + 16, gHostUartOutputSize);
+	CHECK_EQUAL(0xCDAB, GetWord(gHostUartOutput));
+	CHECK_EQUAL(Size + 8, GetWord(gHostUartOutput + 2));
+	CHECK_EQUAL(0x051C, GetWord(gHostUartOutput + 4));
+	CHECK_EQUAL(Offset, GetWord(gHostUartOutput + 8));
+	CHECK_EQUAL(Size, gHostUartOutput[10]);
+	CHECK_EQUAL(0xBADC, GetWord(gHostUartOutput + Size + 14));
+
+	return gHostUartOutput + 12;
+}
+
+static void Connect(void)
+{
+	UART_Init();
+	SendHello();
+	CHECK_EQUAL(1, HandleCommands());
+	CHECK_EQUAL(0xCDAB, GetWord(gHostUartOutput));
+	CHECK_EQUAL(0x0515, GetWord(gHostUartOutput + 4));
+	gHostUartOutputSize = 0;
+}
+
+TEST(UartReadsEeprom)
+{
+	uint16_t i;
+
+	for (i = 0; i < 64; i++) {
+		gEesim->Memory[0x0100 + i] = (uint8_t)(i * 7);
+	}
+
+	Connect();
+	SendRead(0x0100, 64, TIMESTAMP, false);
+	CHECK_EQUAL(1, HandleCommands());
+	CHECK(memcmp(CheckReadReply(0x0100, 64), &gEesim->Memory[0x0100], 64) == 0);
+}
+
+TEST(UartIgnoresBadFrames)
+{
+	Connect();
+
+	SendRead(0x0100, 16, TIMESTAMP, true);
+	CHECK_EQUAL(0, HandleCommands());
+
+	// A well formed command from another session is dropped as well.
+	SendRead(0x0100, 16, TIMESTAMP + 1, false);
+	CHECK_EQUAL(1, HandleCommands());
+	CHECK_EQUAL(0, gHostUartOutputSize);
+
+	SendRead(0x0100, 16, TIMESTAMP, false);
+	CHECK_EQUAL(1, HandleCommands());
+	CheckReadReply(0x0100, 16);
+}
+
+TEST(UartReadsAFrameAcrossTheRingEnd)
+{
+	const uint8_t Noise[250] = { 0 };
+	uint16_t Index;
+
+	gEesim->Memory[0x0200] = 0x5A;
+	Connect();
+
+	// Leave the DMA index a few bytes short of the end of the ring, then
+	// send a command that wraps round it.
+	HOST_UartReceive(Noise, sizeof(Noise) - (DMA_CH0->ST & 0xFFFU));
+	CHECK_EQUAL(0, HandleCommands());
+	SendRead(0x0200, 1, TIMESTAMP, false);
+	Index = DMA_CH0->ST & 0xFFFU;
+	CHECK(Index < sizeof(Noise));
+	CHECK_EQUAL(1, HandleCommands());
+	CHECK_EQUAL(0x5A, CheckReadReply(0x0200, 1)[0]);
+}
+
+TEST(UartResetCommandReboots)
+{
+	uint8_t Payload[4];
+
+	Connect();
+	PutWord(Payload, 0x05DD);
+	PutWord(Payload + 2, 0);
+	SendFrame(Payload, sizeof(Payload), false);
+	CHECK_EQUAL(1, HandleCommands());
+	CHECK(gHostResetRequested);
+}
+#endif
+
@@ -0,0 +1,413 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "app/dtmf.h"
+#include "app/main.h"
+#include "app/menu.h"
+#include "app/scanner.h"
+#if defined(ENABLE_SPECTRUM)
+#include "app/spectrum.h"
+#endif
+#include "driver/st7565.h"
+#include "host/host.h"
+#include "host/screen.h"
+#include "host/test.h"
+#include "misc.h"
+#include "settings.h"
+#include "ui/menu.h"
+#include "ui/rssi.h"
+#include "ui/ui.h"
+#include "ui/widget.h"
+
+// Boots from a blank EEPROM and draws the main screen through the real
+// ST7565 driver, so only the SPI bytes themselves go nowhere.
+
+#define TRACE_EVENTS	1600
+
+static bool IsBlank(void)
+{
+	uint16_t i;
+
+	for (i = 0; i < sizeof(gFrameBuffer); i++) {
+		if (gFrameBuffer[i / 128][i % 128]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static uint16_t Redraw(void)
+{
+	GUI_DisplayScreen();
+	ST7565_WaitForBlit();
+
+	return gDisplayBytesSent;
+}
+
+static void ShowMain(void)
+{
+	HOST_Boot();
+	GUI_SelectNextDisplay(DISPLAY_MAIN);
+	GUI_DisplayScreen();
+}
+
+static void ShowMenu(void)
+{
+	HOST_Boot();
+	GUI_SelectNextDisplay(DISPLAY_MENU);
+	gMenuCursor = MENU_SQL;
+	MENU_ShowCurrentSetting();
+	GUI_DisplayScreen();
+}
+
+static void ShowScanner(void)
+{
+	HOST_Boot();
+	GUI_SelectNextDisplay(DISPLAY_SCANNER);
+	GUI_DisplayScreen();
+}
+
+// Levels 1, 2, 4 and 6 at RSSI 40, 100, 130 and 140 on every band.
+static void SetRssiCalibration(void)
+{
+	uint8_t i;
+
+	for (i = 0; i < 7; i++) {
+		gEEPROM_RSSI_CALIB[i][0] = 40;
+		gEEPROM_RSSI_CALIB[i][1] = 100;
+		gEEPROM_RSSI_CALIB[i][2] = 130;
+		gEEPROM_RSSI_CALIB[i][3] = 140;
+	}
+}
+
+// One event of a session on the main screen, as the main loop would handle
+// it: every 16th is a keypress that steps the frequency up or down through
+// the main screen's key handler, the rest are RSSI readings of a carrier
+// that comes and goes under some noise. Returns the bytes sent for it.
+static uint16_t ReplayEvent(uint16_t Index, bool bRedrawAll)
+{
+	ST7565_WaitForBlit();
+	gDisplayBytesSent = 0;
+	if ((Index % 16) == 15) {
+		MAIN_ProcessKeys(((Index / 16) % 8) < 5 ? KEY_UP : KEY_DOWN, true, false);
+		gRequestSaveChannel = 0;
+		if (bRedrawAll) {
+			UI_InvalidateWidgets();
+		}
+		GUI_DisplayScreen();
+	} else {
+		const uint16_t Noise = (Index * 37U) % 23U;
+
+		UI_UpdateRSSI(((Index % 160) < 100 ? 120 : 20) + Noise);
+	}
+	ST7565_WaitForBlit();
+
+	return gDisplayBytesSent;
+}
+
+// The main screen is made of retained widgets: with nothing changed nothing
+// goes out, and a new frequency or RSSI level sends only its own widget.
+TEST(MainScreenRedrawsOnlyChanges)
+{
+	uint16_t Changed;
+
+	ShowMain();
+	SetRssiCalibration();
+	CHECK(!IsBlank());
+	CHECK(gDisplayBytesSent > 0);
+	CHECK_EQUAL(0, Redraw());
+
+	gEeprom.VfoInfo[0].pRX->Frequency += 2500;
+	Changed = Redraw();
+#if defined(ENABLE_DISPLAY_DOUBLE_BUFFER)
+	CHECK(Changed > 0);
+	CHECK(Changed < 2 * 97);
+#else
+	CHECK_EQUAL(2 * 97, Changed);
+#endif
+	CHECK_EQUAL(0, Redraw());
+
+	gDisplayBytesSent = 0;
+	UI_UpdateRSSI(200);
+	ST7565_WaitForBlit();
+	CHECK_EQUAL(6, gVFO_RSSI_Level[gEeprom.RX_VFO]);
+#if defined(ENABLE_DISPLAY_DOUBLE_BUFFER)
+	CHECK(gDisplayBytesSent > 0);
+	CHECK(gDisplayBytesSent <= 23);
+#else
+	CHECK_EQUAL(23, gDisplayBytesSent);
+#endif
+	CHECK_EQUAL(0, Redraw());
+}
+
+// Whatever the widgets leave in the framebuffer after each event is what a
+// redraw from a cleared framebuffer draws.
+TEST(MainScreenWidgetsMatchFullRedraw)
+{
+	static uint8_t Retained[7][128];
+	uint32_t Frequency;
+	uint16_t i;
+
+	ShowMain();
+	SetRssiCalibration();
+	Frequency = gEeprom.VfoInfo[gEeprom.TX_VFO].pRX->Frequency;
+	for (i = 0; i < 320; i++) {
+		switch (i) {
+		case 100:
+			VfoState[1] = VFO_STATE_BUSY;
+			break;
+		case 200:
+			VfoState[1] = VFO_STATE_NORMAL;
+			gEeprom.VfoInfo[0].CHANNEL_BANDWIDTH ^= 1;
+			break;
+		case 250:
+			gDTMF_InputMode = true;
+			break;
+		case 260:
+			gDTMF_InputMode = false;
+			break;
+		}
+		ReplayEvent(i, false);
+		Redraw();
+		memcpy(Retained, gFrameBuffer, sizeof(Retained));
+		UI_InvalidateWidgets();
+		Redraw();
+		if (memcmp(Retained, gFrameBuffer, sizeof(Retained))) {
+			printf("  event %u\n", i);
+			CHECK(false);
+			break;
+		}
+	}
+	CHECK(Frequency != gEeprom.VfoInfo[gEeprom.TX_VFO].pRX->Frequency);
+}
+
+// The menu is drawn from scratch every time, so without the double buffer
+// everything it draws goes out again.
+TEST(MenuScreenRedrawsOnlyChanges)
+{
+	uint16_t Unchanged;
+	uint16_t Changed;
+
+	ShowMenu();
+	CHECK(gDisplayBytesSent > 0);
+	Redraw();
+	Unchanged = Redraw();
+	gSubMenuSelection = (gSubMenuSelection + 1) % 10;
+	Changed = Redraw();
+#if defined(ENABLE_DISPLAY_DOUBLE_BUFFER)
+	CHECK_EQUAL(0, Unchanged);
+	// Only the columns of the one digit that changed.
+	CHECK(Changed > 0);
+	CHECK(Changed <= 2 * 16);
+#else
+	CHECK(Unchanged > 0);
+	CHECK(Unchanged < sizeof(gFrameBuffer));
+	CHECK_EQUAL(Unchanged, Changed);
+#endif
+}
+
+// The scanner screen is made of retained widgets, so only a widget whose
+// text changed is sent at all.
+TEST(ScannerScreenRedrawsOnlyChanges)
+{
+	uint16_t Changed;
+
+	ShowScanner();
+	CHECK(gDisplayBytesSent > 0);
+	CHECK_EQUAL(0, Redraw());
+	gScanProgressIndicator++;
+	Changed = Redraw();
+#if defined(ENABLE_DISPLAY_DOUBLE_BUFFER)
+	// One more progress dot.
+	CHECK(Changed > 0);
+	CHECK(Changed < 2 * 16);
+#else
+	// The whole state widget.
+	CHECK_EQUAL(2 * 128, Changed);
+#endif
+	CHECK_EQUAL(0, Redraw());
+}
+
+BENCH(MainScreenRedraw)
+{
+	const uint32_t Count = 1000;
+	uint64_t Start;
+	uint32_t i;
+
+	ShowMain();
+	Start = HOST_GetNanoseconds();
+	for (i = 0; i < Count; i++) {
+		GUI_DisplayScreen();
+	}
+	printf("  %u ns of host time per unchanged redraw, %u bytes sent\n",
+		(unsigned int)((HOST_GetNanoseconds() - Start) / Count),
+		gDisplayBytesSent);
+}
+
+// Host time and bytes sent for a session of keypresses and RSSI readings,
+// with the widgets and with the screen redrawn from a cleared framebuffer on
+// every keypress as it was before them.
+BENCH(MainScreenTrace)
+{
+	static const char *const pNames[] = { "widgets", "redrawn" };
+	uint32_t Bytes;
+	uint64_t Start;
+	uint64_t Time;
+	uint16_t i;
+	uint8_t j;
+
+	for (j = 0; j < 2; j++) {
+		ShowMain();
+		SetRssiCalibration();
+		Bytes = 0;
+		Start = HOST_GetNanoseconds();
+		for (i = 0; i < TRACE_EVENTS; i++) {
+			Bytes += ReplayEvent(i, j == 1);
+		}
+		Time = HOST_GetNanoseconds() - Start;
+		printf("  %-7s %5u ns of host time per event, %6u bytes for %u keypresses and %u RSSI readings\n",
+			pNames[j], (unsigned int)(Time / TRACE_EVENTS), (unsigned int)Bytes,
+			TRACE_EVENTS / 16, TRACE_EVENTS - (TRACE_EVENTS / 16));
+	}
+}
+
+// Bytes sent for the first frame of each screen, for a redraw with nothing
+// changed and for one with a single value changed.
+BENCH(ScreenBytes)
+{
+	static const char *const pNames[] = { "main", "menu", "scanner" };
+	uint16_t First;
+	uint16_t Unchanged;
+	uint16_t Changed;
+	uint8_t i;
+
+	for (i = 0; i < 3; i++) {
+		switch (i) {
+		case 0:
+			ShowMain();
+			break;
+		case 1:
+			ShowMenu();
+			break;
+		default:
+			ShowScanner();
+			break;
+		}
+		First = gDisplayBytesSent;
+		Redraw();
+		Unchanged = Redraw();
+		switch (i) {
+		case 0:
+			gEeprom.VfoInfo[0].pRX->Frequency += 2500;
+			break;
+		case 1:
+			gSubMenuSelection = (gSubMenuSelection + 1) % 10;
+			break;
+		default:
+			gScanProgressIndicator++;
+			break;
+		}
+		Changed = Redraw();
+		printf("  %-7s %3u bytes first, %3u unchanged, %3u with one value changed\n", pNames[i], First, Unchanged, Changed);
+	}
+}
+
+#if defined(ENABLE_SPECTRUM)
+// One sweep over a noise floor of 60 to 64 dB: a steady carrier 30 dB up
+// at point 40, one 20 dB up at point 90 that keys up every other 8 sweeps
+// and a weak one drifting across the band.
+static void Sweep(uint16_t Index)
+{
+	uint8_t i;
+
+	for (i = 0; i < SPECTRUM_POINTS; i++) {
+		gSpectrumRssi[i] = 60 + (((i * 7U) + (Index * 13U)) % 5U);
+	}
+	gSpectrumRssi[39] += 15;
+	gSpectrumRssi[40] += 30;
+	gSpectrumRssi[41] += 15;
+	if (((Index / 8) % 2) == 0) {
+		gSpectrumRssi[90] += 20;
+	}
+	gSpectrumRssi[(Index * 3U) % SPECTRUM_POINTS] += 8;
+	gSpectrumSweepCount++;
+}
+
+static void ShowSpectrum(SPECTRUM_Mode_t Mode)
+{
+	HOST_Boot();
+	gSpectrumStart = 43300000;
+	gSpectrumPointsPerSecond = 1234;
+	gSpectrumMode = Mode;
+	Sweep(0);
+	GUI_SelectNextDisplay(DISPLAY_SPECTRUM);
+	GUI_DisplayScreen();
+	ST7565_WaitForBlit();
+}
+
+TEST(SpectrumScreensMatchGoldenImages)
+{
+	uint16_t i;
+
+	ShowSpectrum(SPECTRUM_MODE_BARS);
+	SCREEN_Check("spectrum");
+
+	// Past the height of the graph, so the oldest rows have scrolled off.
+	ShowSpectrum(SPECTRUM_MODE_WATERFALL);
+	for (i = 1; i < 60; i++) {
+		Sweep(i);
+		Redraw();
+	}
+	SCREEN_Check("waterfall");
+}
+
+// A new waterfall row sends the graph and nothing else, and without a new
+// sweep nothing goes out.
+TEST(WaterfallSendsOnlyTheGraph)
+{
+	ShowSpectrum(SPECTRUM_MODE_WATERFALL);
+	Sweep(1);
+#if defined(ENABLE_DISPLAY_DOUBLE_BUFFER)
+	CHECK(Redraw() <= 5 * 128);
+#else
+	CHECK_EQUAL(5 * 128, Redraw());
+#endif
+	CHECK_EQUAL(0, Redraw());
+}
+
+// Host time and bytes sent for the scroll and render of each new sweep.
+BENCH(WaterfallScroll)
+{
+	const uint32_t Count = 10000;
+	uint32_t Bytes = 0;
+	uint64_t Time = 0;
+	uint64_t Start;
+	uint32_t i;
+
+	ShowSpectrum(SPECTRUM_MODE_WATERFALL);
+	for (i = 1; i <= Count; i++) {
+		Sweep(i);
+		Start = HOST_GetNanoseconds();
+		Bytes += Redraw();
+		Time += HOST_GetNanoseconds() - Start;
+	}
+	printf("  %u ns of host time and %u bytes sent per sweep\n", (unsigned int)(Time / Count), (unsigned int)(Bytes / Count));
+}
+#endif
+
@@ -0,0 +1,199 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+#include "driver/crc.h"
+#include "driver/eeprom.h"
+#include "integrity.h"
+
+#define TABLE_MAGIC	0x4352U
+// Goes over the magic before the first write the stored table does not
+// cover yet, and stays there until the whole table catches up.
+#define TABLE_STALE	0x0000U
+#define CHUNK_SIZE	128U
+
+// The checksums are CRC-16/XMODEM over each region as EEPROM_ReadBuffer
+// returns it, so a programming tool can compute them from an image.
+typedef struct {
+	uint16_t Magic;
+	uint16_t Crc[INTEGRITY_REGIONS];
+	uint16_t Check;
+	uint8_t Padding[2];
+} Table_t;
+
+const INTEGRITY_Region_t gIntegrityRegions[INTEGRITY_REGIONS] = {
+	{ 0x0000, 0x0E40 }, // Channels, VFO bands and channel attributes
+	{ 0x0E40, 0x0F50 }, // FM channels and settings
+	{ 0x0F50, 0x1BD0 }, // Channel names
+	{ 0x1C00, 0x1D00 }, // DTMF contacts
+	{ 0x1E00, 0x2000 }, // Calibration
+};
+
+uint8_t gIntegrityFailures;
+
+static Table_t gTable;
+static bool gIsValid;
+static bool gIsPending;
+
+// The stored table has to be either right for what is in the EEPROM or
+// plainly stale, or a power cut with writes still in the cache would boot
+// into a false alarm. So the first change marks it stale, before the data
+// can reach the EEPROM, and the table itself only goes out from
+// INTEGRITY_Flush once every write it covers has.
+static void MarkPending(void)
+{
+	static const uint16_t Stale = TABLE_STALE;
+
+	if (!gIsPending) {
+		EEPROM_WritePages(INTEGRITY_EEPROM, &Stale, sizeof(Stale));
+		gIsPending = true;
+	}
+}
+
+// With a zero start value and no final inversion the CRC is linear, so a
+// write changes the checksum by the CRC of the old bytes XOR the new ones,
+// carried on with zeros to the end of the region. Leading zeros leave it
+// unchanged, so the CRC only starts at the first byte that differs.
+static bool UpdateRegion(uint8_t Region, uint16_t Address, const uint8_t *pData, uint16_t Size)
+{
+	bool bStarted = false;
+	uint8_t Delta[32];
+
+	while (Size) {
+		const uint8_t Chunk = (Size < sizeof(Delta)) ? Size : sizeof(Delta);
+		uint8_t i;
+
+		EEPROM_ReadBuffer(Address, Delta, Chunk);
+		for (i = 0; i < Chunk; i++) {
+			Delta[i] ^= pData[i];
+			if (!bStarted && Delta[i]) {
+				CRC_Start();
+				bStarted = true;
+			}
+			if (bStarted) {
+				CRC_Update(&Delta[i], 1);
+			}
+		}
+		Address += Chunk;
+		pData += Chunk;
+		Size -= Chunk;
+	}
+
+	if (!bStarted) {
+		return false;
+	}
+	CRC_UpdateZeros(gIntegrityRegions[Region].End - Address);
+	gTable.Crc[Region] ^= CRC_Finish();
+
+	return true;
+}
+
+void INTEGRITY_Load(void)
+{
+	EEPROM_ReadBuffer(INTEGRITY_EEPROM, &gTable, sizeof(gTable));
+	gIsValid = gTable.Magic == TABLE_MAGIC && gTable.Check == CRC_Calculate(gTable.Crc, sizeof(gTable.Crc));
+}
+
+// Reads every region once. Regions that do not match a valid table are
+// flagged, and the table is rebuilt from what was read either way, so that
+// later writes keep it in step with the contents.
+void INTEGRITY_Verify(void)
+{
+	bool bChanged = !gIsValid;
+	uint8_t Data[CHUNK_SIZE];
+	uint8_t i;
+
+	gIntegrityFailures = 0;
+	for (i = 0; i < INTEGRITY_REGIONS; i++) {
+		uint16_t Address;
+		uint16_t Chunk;
+		uint16_t Crc;
+
+		// EEPROM reads never use the CRC unit, so it can run across them.
+		CRC_Start();
+		for (Address = gIntegrityRegions[i].Start; Address < gIntegrityRegions[i].End; Address += Chunk) {
+			Chunk = gIntegrityRegions[i].End - Address;
+			if (Chunk > CHUNK_SIZE) {
+				Chunk = CHUNK_SIZE;
+			}
+			EEPROM_ReadBuffer(Address, Data, Chunk);
+			CRC_Update(Data, Chunk);
+		}
+		Crc = CRC_Finish();
+
+		if (Crc != gTable.Crc[i]) {
+			if (gIsValid) {
+				gIntegrityFailures |= 1U << i;
+			}
+			gTable.Crc[i] = Crc;
+			bChanged = true;
+		}
+	}
+
+	if (bChanged) {
+		gTable.Magic = TABLE_MAGIC;
+		memset(gTable.Padding, 0xFF, sizeof(gTable.Padding));
+		gIsValid = true;
+		MarkPending();
+	}
+}
+
+bool INTEGRITY_IsValid(void)
+{
+	return gIsValid;
+}
+
+uint16_t INTEGRITY_GetCrc(uint8_t Region)
+{
+	return gTable.Crc[Region];
+}
+
+// Has to run before the write reaches the EEPROM, cache or journal, as it
+// reads the bytes being replaced.
+void INTEGRITY_Update(uint16_t Address, const void *pBuffer, uint16_t Size)
+{
+	const uint8_t *pData = (const uint8_t *)pBuffer;
+	bool bChanged = false;
+	uint8_t i;
+
+	if (!gIsValid) {
+		return;
+	}
+
+	for (i = 0; i < INTEGRITY_REGIONS; i++) {
+		const uint16_t Start = (gIntegrityRegions[i].Start > Address) ? gIntegrityRegions[i].Start : Address;
+		const uint16_t End = (gIntegrityRegions[i].End < Address + Size) ? gIntegrityRegions[i].End : Address + Size;
+
+		if (Start < End && UpdateRegion(i, Start, pData + (Start - Address), End - Start)) {
+			bChanged = true;
+		}
+	}
+
+	if (bChanged) {
+		MarkPending();
+	}
+}
+
+// Only to be called with nothing left in the write cache.
+void INTEGRITY_Flush(void)
+{
+	if (gIsPending) {
+		gTable.Check = CRC_Calculate(gTable.Crc, sizeof(gTable.Crc));
+		EEPROM_WritePages(INTEGRITY_EEPROM, &gTable, sizeof(gTable));
+		gIsPending = false;
+	}
+}
+
@@ -0,0 +1,45 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef INTEGRITY_H
+#define INTEGRITY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define INTEGRITY_EEPROM	0x1BD0U
+#define INTEGRITY_SIZE		16U
+#define INTEGRITY_REGIONS	5U
+
+typedef struct {
+	uint16_t Start;
+	uint16_t End;
+} INTEGRITY_Region_t;
+
+extern const INTEGRITY_Region_t gIntegrityRegions[INTEGRITY_REGIONS];
+
+// Regions whose contents did not match their checksum at boot, one bit each.
+extern uint8_t gIntegrityFailures;
+
+void INTEGRITY_Load(void);
+void INTEGRITY_Verify(void);
+bool INTEGRITY_IsValid(void);
+uint16_t INTEGRITY_GetCrc(uint8_t Region);
+void INTEGRITY_Update(uint16_t Address, const void *pBuffer, uint16_t Size);
+void INTEGRITY_Flush(void);
+
+#endif
+
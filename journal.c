@@ -0,0 +1,276 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "driver/eeprom.h"
+#if defined(ENABLE_EEPROM_INTEGRITY)
+#include "integrity.h"
+#endif
+#include "journal.h"
+
+// Each record is keyed by the number of the word it holds, which fits in
+// 11 bits as the journalled words all lie below the journal. The top bits
+// hold the lap number, and KEY_MORE is set on every record of a write but
+// its last, so that a write is replayed either whole or not at all.
+#define KEY_WORD_MASK 0x07FFU
+#define KEY_MORE 0x0800U
+#define KEY_LAP_SHIFT 12U
+#define KEY_LAP_MASK 0x0FU
+
+// Slot 0 of every lap holds a marker instead of a word.
+#define MARKER_WORD KEY_WORD_MASK
+
+typedef struct {
+	uint16_t Key;
+	uint8_t Data[JOURNAL_WORD_SIZE];
+	uint16_t Check;
+} Record_t;
+
+typedef struct {
+	uint16_t Address;
+	uint8_t Data[JOURNAL_WORD_SIZE];
+} Word_t;
+
+uint16_t gJournalAppends;
+uint16_t gJournalCompactions;
+
+static Word_t gWords[JOURNAL_SLOTS];
+static uint8_t gWordCount;
+static uint8_t gHead;
+static uint8_t gLap;
+
+// CRC-16/CCITT with a non-zero start, so that neither erased nor zeroed
+// slots pass as records. A torn record passes about once in 65536 cuts.
+static uint16_t Check(const Record_t *pRecord)
+{
+	const uint8_t *pData = (const uint8_t *)pRecord;
+	uint16_t Crc = 0xFFFF;
+	uint8_t i;
+	uint8_t j;
+
+	for (i = 0; i < offsetof(Record_t, Check); i++) {
+		Crc ^= pData[i] << 8;
+		for (j = 0; j < 8; j++) {
+			Crc = (Crc & 0x8000) ? (Crc << 1) ^ 0x1021 : Crc << 1;
+		}
+	}
+
+	return Crc;
+}
+
+static uint8_t GetLap(const Record_t *pRecord)
+{
+	return (pRecord->Key >> KEY_LAP_SHIFT) & KEY_LAP_MASK;
+}
+
+static uint16_t GetAddress(const Record_t *pRecord)
+{
+	return (pRecord->Key & KEY_WORD_MASK) * JOURNAL_WORD_SIZE;
+}
+
+static bool IsValid(const Record_t *pRecord)
+{
+	return pRecord->Check == Check(pRecord);
+}
+
+// Tells whether the record holds a word of the current lap.
+static bool IsWord(const Record_t *pRecord)
+{
+	return IsValid(pRecord)
+		&& GetLap(pRecord) == gLap
+		&& GetAddress(pRecord) < JOURNAL_EEPROM;
+}
+
+static void WriteSlot(uint8_t Slot, uint16_t Word, const uint8_t *pData, bool bMore)
+{
+	const uint16_t Offset = JOURNAL_EEPROM + (Slot * JOURNAL_RECORD_SIZE);
+	Record_t Record;
+
+	Record.Key = ((uint16_t)gLap << KEY_LAP_SHIFT) | (bMore ? KEY_MORE : 0) | Word;
+	memcpy(Record.Data, pData, JOURNAL_WORD_SIZE);
+	Record.Check = Check(&Record);
+
+	// The marker has to reach the EEPROM before any record of its lap, or a
+	// prefix of the previous lap could replay over the compacted values.
+	if (Slot == 0) {
+		EEPROM_WritePages(Offset, &Record, sizeof(Record));
+	} else {
+		EEPROM_WriteCached(Offset, &Record, sizeof(Record));
+	}
+}
+
+static void Store(uint16_t Address, const uint8_t *pData)
+{
+	uint8_t i;
+
+	for (i = 0; i < gWordCount; i++) {
+		if (gWords[i].Address == Address) {
+			break;
+		}
+	}
+	if (i == gWordCount) {
+		gWords[gWordCount++].Address = Address;
+	}
+	memcpy(gWords[i].Data, pData, JOURNAL_WORD_SIZE);
+}
+
+// Records of older laps stay behind in the slots, so the new lap number
+// must not match any of them. There are more lap numbers than slots, so
+// one is always free.
+static void StartLap(void)
+{
+	static const uint8_t Erased[JOURNAL_WORD_SIZE] = { 0xFF, 0xFF, 0xFF, 0xFF };
+	Record_t Records[JOURNAL_SLOTS];
+	uint8_t i;
+
+	EEPROM_ReadBuffer(JOURNAL_EEPROM, Records, sizeof(Records));
+	gLap = (gLap + 1) & KEY_LAP_MASK;
+	for (i = 1; i < JOURNAL_SLOTS; i++) {
+		if (IsValid(&Records[i]) && GetLap(&Records[i]) == gLap) {
+			gLap = (gLap + 1) & KEY_LAP_MASK;
+			i = 0;
+		}
+	}
+	WriteSlot(0, MARKER_WORD, Erased, false);
+	gHead = 1;
+}
+
+// Applies the writes that were completed in the unbroken run of records
+// after the marker. Anything else of the current lap past that point comes
+// from a torn or out of order write, so the next append starts a new lap.
+void JOURNAL_Replay(void)
+{
+	Record_t Records[JOURNAL_SLOTS];
+	uint8_t Complete;
+	uint8_t i;
+
+	gWordCount = 0;
+	gHead = 0;
+	EEPROM_ReadBuffer(JOURNAL_EEPROM, &Records[0], JOURNAL_RECORD_SIZE);
+	if (!IsValid(&Records[0]) || (Records[0].Key & KEY_WORD_MASK) != MARKER_WORD) {
+		return;
+	}
+	EEPROM_ReadBuffer(JOURNAL_EEPROM + JOURNAL_RECORD_SIZE, &Records[1], sizeof(Records) - JOURNAL_RECORD_SIZE);
+	gLap = GetLap(&Records[0]);
+
+	Complete = 1;
+	for (i = 1; i < JOURNAL_SLOTS && IsWord(&Records[i]); i++) {
+		if ((Records[i].Key & KEY_MORE) == 0) {
+			Complete = i + 1;
+		}
+	}
+	for (i = Complete; i < JOURNAL_SLOTS; i++) {
+		if (IsWord(&Records[i])) {
+			break;
+		}
+	}
+
+	for (gHead = 1; gHead < Complete; gHead++) {
+		Store(GetAddress(&Records[gHead]), Records[gHead].Data);
+	}
+	if (i < JOURNAL_SLOTS) {
+		gHead = JOURNAL_SLOTS;
+	}
+}
+
+// Address and Size must be multiples of JOURNAL_WORD_SIZE, with at most
+// eight words that lie below the journal itself. Only the words that differ
+// from the current contents are appended.
+void JOURNAL_Write(uint16_t Address, const void *pBuffer, uint8_t Size)
+{
+	const uint8_t *pData = (const uint8_t *)pBuffer;
+	uint8_t Changed = 0;
+	uint8_t Count = 0;
+	uint8_t i;
+
+	for (i = 0; i < Size / JOURNAL_WORD_SIZE; i++) {
+		uint8_t Current[JOURNAL_WORD_SIZE];
+
+		EEPROM_ReadBuffer(Address + (i * JOURNAL_WORD_SIZE), Current, sizeof(Current));
+		if (memcmp(Current, pData + (i * JOURNAL_WORD_SIZE), sizeof(Current)) != 0) {
+			Changed |= 1U << i;
+			Count++;
+		}
+	}
+	if (Count == 0) {
+		return;
+	}
+#if defined(ENABLE_EEPROM_INTEGRITY)
+	// Marks the stored checksums stale, which has to happen before any
+	// record of the write can reach the EEPROM.
+	INTEGRITY_Update(Address, pData, Size);
+#endif
+
+	if (gHead + Count > JOURNAL_SLOTS) {
+		JOURNAL_Compact();
+	}
+	if (gHead == 0) {
+		StartLap();
+	}
+
+	for (i = 0; Changed; i++) {
+		if (Changed & (1U << i)) {
+			Changed &= ~(1U << i);
+			WriteSlot(gHead++, (Address / JOURNAL_WORD_SIZE) + i, pData + (i * JOURNAL_WORD_SIZE), Changed != 0);
+			Store(Address + (i * JOURNAL_WORD_SIZE), pData + (i * JOURNAL_WORD_SIZE));
+			gJournalAppends++;
+		}
+	}
+}
+
+void JOURNAL_Overlay(uint16_t Address, uint8_t *pData, uint8_t Size)
+{
+	uint8_t i;
+
+	for (i = 0; i < gWordCount; i++) {
+		const Word_t *pWord = &gWords[i];
+		uint16_t Start;
+		uint16_t End;
+
+		Start = (pWord->Address > Address) ? pWord->Address : Address;
+		End = (pWord->Address + JOURNAL_WORD_SIZE < Address + Size) ? pWord->Address + JOURNAL_WORD_SIZE : Address + Size;
+		if (Start < End) {
+			memcpy(pData + (Start - Address), pWord->Data + (Start - pWord->Address), End - Start);
+		}
+	}
+}
+
+// Writes the journalled words back to their own addresses and empties the
+// journal. Anything that writes those addresses directly has to call this
+// first, or the journal would replay older values over its data.
+void JOURNAL_Compact(void)
+{
+	uint8_t i;
+
+	if (gHead <= 1) {
+		return;
+	}
+
+	// The whole lap goes out first, so that a power cut part way through
+	// still replays the newest value of every word. Only the words are
+	// written back, as a torn write to their neighbours could not be undone.
+	EEPROM_Flush();
+	for (i = 0; i < gWordCount; i++) {
+		EEPROM_WritePages(gWords[i].Address, gWords[i].Data, JOURNAL_WORD_SIZE);
+	}
+	gWordCount = 0;
+	gJournalCompactions++;
+
+	StartLap();
+}
+
@@ -0,0 +1,36 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdint.h>
+
+#define JOURNAL_EEPROM		0x1D80U
+#define JOURNAL_SLOTS		16U
+#define JOURNAL_RECORD_SIZE	8U
+#define JOURNAL_WORD_SIZE	4U
+
+extern uint16_t gJournalAppends;
+extern uint16_t gJournalCompactions;
+
+void JOURNAL_Replay(void);
+void JOURNAL_Write(uint16_t Address, const void *pBuffer, uint8_t Size);
+void JOURNAL_Overlay(uint16_t Address, uint8_t *pData, uint8_t Size);
+void JOURNAL_Compact(void);
+
+#endif
+
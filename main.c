@@ -24,16 +24,29 @@
 #include "driver/backlight.h"
 #include "driver/bk4819.h"
 #include "driver/gpio.h"
+#if defined(ENABLE_DISPLAY_DMA)
+#include "driver/st7565.h"
+#endif
 #include "driver/system.h"
 #include "driver/systick.h"
 #if defined(ENABLE_UART)
 #include "driver/uart.h"
+#include "external/printf/printf.h"
 #endif
 #if defined(ENABLE_MODEM)
 #include "app/modem.h"
 #endif
+#if defined(ENABLE_SCAN_HISTORY)
+#include "app/history.h"
+#endif
 #include "helper/battery.h"
 #include "helper/boot.h"
+#if defined(ENABLE_EEPROM_INTEGRITY)
+#include "integrity.h"
+#endif
+#if defined(ENABLE_EEPROM_JOURNAL)
+#include "journal.h"
+#endif
 #include "misc.h"
 #include "radio.h"
 #include "settings.h"
@@ -87,8 +100,17 @@ void Main(void)
 
 	BK4819_Init();
 	BOARD_ADC_GetBatteryInfo(&gBatteryCurrentVoltage, &gBatteryCurrent);
+#if defined(ENABLE_EEPROM_JOURNAL)
+	JOURNAL_Replay();
+#endif
+#if defined(ENABLE_EEPROM_INTEGRITY)
+	INTEGRITY_Load();
+#endif
 	BOARD_EEPROM_Init();
 	BOARD_EEPROM_LoadCalibration();
+#if defined(ENABLE_SCAN_HISTORY)
+	HISTORY_Load();
+#endif
 
 	RADIO_ConfigureChannel(0, 2);
 	RADIO_ConfigureChannel(1, 2);
@@ -109,8 +131,33 @@ void Main(void)
 		uint8_t Channel;
 
 		UI_DisplayWelcome();
+#if defined(ENABLE_UART) && defined(ENABLE_BOOT_TIME)
+		{
+			char String[24];
+			int Length;
+
+			// Reports the time to the welcome screen.
+			Length = sprintf(String, "BOOT %u us\r\n", (unsigned int)SYSTICK_GetMicroseconds());
+			UART_LogSend(String, Length);
+		}
+#endif
 		BACKLIGHT_TurnOn();
+#if defined(ENABLE_EEPROM_INTEGRITY)
+		{
+			// The check reads the whole EEPROM once, in the time the
+			// welcome screen is up anyway.
+			const uint32_t Start = SYSTICK_GetMicroseconds();
+			uint32_t Elapsed;
+
+			INTEGRITY_Verify();
+			Elapsed = (SYSTICK_GetMicroseconds() - Start) / 1000U;
+			if (Elapsed < 1000) {
+				SYSTEM_DelayMs(1000 - Elapsed);
+			}
+		}
+#else
 		SYSTEM_DelayMs(1000);
+#endif
 		gMenuListCount = 49;
 #if defined(ENABLE_ALARM)
 		gMenuListCount++;
@@ -145,6 +192,9 @@ void Main(void)
 	}
 
 	while (1) {
+#if defined(ENABLE_DISPLAY_DMA)
+		ST7565_ServiceBlit();
+#endif
 		APP_Update();
 		if (gNextTimeslice) {
 			APP_TimeSlice10ms();
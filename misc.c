@@ -47,9 +47,11 @@ uint16_t gEEPROM_1F8C;
 
 uint8_t gMR_ChannelAttributes[FREQ_CHANNEL_LAST + 1];
 
+volatile uint32_t gGlobalSysTickCounter;
 volatile bool gNextTimeslice500ms;
 volatile uint16_t gBatterySaveCountdown = 1000;
 volatile uint16_t gDualWatchCountdown;
+volatile uint16_t gPriorityLookbackCountdown;
 volatile uint16_t gTxTimerCountdown;
 volatile uint16_t gTailNoteEliminationCountdown;
 #if defined(ENABLE_NOAA)
@@ -149,6 +151,7 @@ volatile bool gNextTimeslice40ms;
 volatile bool gSchedulePowerSave;
 volatile bool gBatterySaveCountdownExpired;
 volatile bool gScheduleDualWatch = true;
+volatile bool gSchedulePriorityLookback;
 #if defined(ENABLE_NOAA)
 volatile bool gScheduleNOAA = true;
 #endif
@@ -193,6 +196,34 @@ void NUMBER_ToDigits(uint32_t Value, char *pDigits)
 	}
 }
 
+uint8_t NUMBER_FormatFixed(char *pString, uint32_t Value, uint8_t Decimals)
+{
+	char Digits[10];
+	uint8_t Count;
+	uint8_t Length;
+
+	// Same output as printf("%.*f", Decimals, Value / 10^Decimals) without
+	// going near the soft-float library.
+	Count = 0;
+	do {
+		const uint32_t Result = Value / 10U;
+
+		Digits[Count++] = '0' + (Value - (Result * 10U));
+		Value = Result;
+	} while (Value || Count <= Decimals);
+
+	Length = 0;
+	while (Count) {
+		if (Count == Decimals) {
+			pString[Length++] = '.';
+		}
+		pString[Length++] = Digits[--Count];
+	}
+	pString[Length] = 0;
+
+	return Length;
+}
+
 uint8_t NUMBER_AddWithWraparound(uint8_t Base, int8_t Add, uint8_t LowerLimit, uint8_t UpperLimit)
 {
 	Base += Add;
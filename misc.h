@@ -30,6 +30,12 @@
 #define IS_NOT_NOAA_CHANNEL(x) ((x) >= MR_CHANNEL_FIRST && (x) <= FREQ_CHANNEL_LAST)
 #define IS_VALID_CHANNEL(x) ((x) < LAST_CHANNEL)
 
+// Memory scan priority look-back period, in 10 ms ticks. Each priority
+// channel is listened to for one tick before its RSSI is read.
+#if !defined(PRIORITY_LOOKBACK_INTERVAL)
+#define PRIORITY_LOOKBACK_INTERVAL 200U
+#endif
+
 enum {
 	MR_CHANNEL_FIRST = 0U,
 	MR_CHANNEL_LAST = 199U,
@@ -104,9 +110,11 @@ extern uint16_t gEEPROM_1F8C;
 
 extern uint8_t gMR_ChannelAttributes[207];
 
+extern volatile uint32_t gGlobalSysTickCounter;
 extern volatile bool gNextTimeslice500ms;
 extern volatile uint16_t gBatterySaveCountdown;
 extern volatile uint16_t gDualWatchCountdown;
+extern volatile uint16_t gPriorityLookbackCountdown;
 extern volatile uint16_t gTxTimerCountdown;
 extern volatile uint16_t gTailNoteEliminationCountdown;
 extern volatile uint16_t gFmPlayCountdown;
@@ -205,6 +213,7 @@ extern volatile bool gNextTimeslice40ms;
 extern volatile bool gSchedulePowerSave;
 extern volatile bool gBatterySaveCountdownExpired;
 extern volatile bool gScheduleDualWatch;
+extern volatile bool gSchedulePriorityLookback;
 #if defined(ENABLE_NOAA)
 extern volatile bool gScheduleNOAA;
 #endif
@@ -221,6 +230,7 @@ extern uint8_t gIsLocked;
 
 void NUMBER_Get(char *pDigits, uint32_t *pInteger);
 void NUMBER_ToDigits(uint32_t Value, char *pDigits);
+uint8_t NUMBER_FormatFixed(char *pString, uint32_t Value, uint8_t Decimals);
 uint8_t NUMBER_AddWithWraparound(uint8_t Base, int8_t Add, uint8_t LowerLimit, uint8_t UpperLimit);
 
 #endif
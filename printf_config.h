@@ -1,3 +1,6 @@
 #define PRINTF_DISABLE_SUPPORT_LONG_LONG
 #define PRINTF_DISABLE_SUPPORT_EXPONENTIAL
 #define PRINTF_DISABLE_SUPPORT_PTRDIFF_T
+#if !defined(ENABLE_PRINTF_FLOAT)
+#define PRINTF_DISABLE_SUPPORT_FLOAT
+#endif
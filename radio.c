@@ -26,6 +26,7 @@
 #include "driver/eeprom.h"
 #include "driver/gpio.h"
 #include "driver/system.h"
+#include "driver/systick.h"
 #include "frequencies.h"
 #include "functions.h"
 #include "helper/battery.h"
@@ -45,71 +46,241 @@ STEP_Setting_t gStepSetting;
 
 VfoState_t VfoState[2];
 
-bool RADIO_CheckValidChannel(uint16_t Channel, bool bCheckScanList, uint8_t VFO)
-{
-	uint8_t Attributes;
-	uint8_t PriorityCh1;
-	uint8_t PriorityCh2;
+#define CHANNEL_MAP_WORDS	((MR_CHANNEL_LAST + 32U) / 32U)
 
-	if (!IS_MR_CHANNEL(Channel)) {
-		return false;
+// One bit per memory channel. Map 0 holds every valid channel, maps 1 and 2
+// the valid members of scan list 1 and 2 without that list's priority
+// channels, which is what RADIO_CheckValidChannel used to work out per call.
+static uint32_t gChannelMaps[3][CHANNEL_MAP_WORDS];
+
+static uint8_t GetChannelMap(bool bCheckScanList, uint8_t VFO)
+{
+	if (bCheckScanList && VFO < 2) {
+		return 1 + VFO;
 	}
 
-	// Check channel is valid
-	Attributes = gMR_ChannelAttributes[Channel];
+	return 0;
+}
+
+static bool IsInMap(uint8_t Map, uint8_t Channel)
+{
+	const uint8_t Attributes = gMR_ChannelAttributes[Channel];
+
 	if ((Attributes & MR_CH_BAND_MASK) > BAND7_470MHz) {
 		return false;
 	}
-	
-	if (bCheckScanList) {
-		switch (VFO) {
-		case 0:
-			if ((Attributes & MR_CH_SCANLIST1) == 0) {
-				return false;
-			}
-			PriorityCh1 = gEeprom.SCANLIST_PRIORITY_CH1[0];
-			PriorityCh2 = gEeprom.SCANLIST_PRIORITY_CH2[0];
-			break;
-		case 1:
-			if ((Attributes & MR_CH_SCANLIST2) == 0) {
-				return false;
-			}
-			PriorityCh1 = gEeprom.SCANLIST_PRIORITY_CH1[1];
-			PriorityCh2 = gEeprom.SCANLIST_PRIORITY_CH2[1];
-			break;
-		default:
-			return true;
+	if (Map == 0) {
+		return true;
+	}
+	if ((Attributes & (Map == 1 ? MR_CH_SCANLIST1 : MR_CH_SCANLIST2)) == 0) {
+		return false;
+	}
+
+	return Channel != gEeprom.SCANLIST_PRIORITY_CH1[Map - 1] && Channel != gEeprom.SCANLIST_PRIORITY_CH2[Map - 1];
+}
+
+// Lowest set bit at or above Channel, or 0xFF.
+static uint8_t FindChannelUp(const uint32_t *pMap, uint8_t Channel)
+{
+	uint8_t Word = Channel / 32U;
+	uint32_t Bits = pMap[Word] & (0xFFFFFFFFU << (Channel % 32U));
+
+	while (!Bits) {
+		if (++Word == CHANNEL_MAP_WORDS) {
+			return 0xFF;
 		}
-		if (PriorityCh1 == Channel) {
-			return false;
+		Bits = pMap[Word];
+	}
+
+	return (Word * 32U) + __builtin_ctz(Bits);
+}
+
+// Highest set bit at or below Channel, or 0xFF.
+static uint8_t FindChannelDown(const uint32_t *pMap, uint8_t Channel)
+{
+	uint8_t Word = Channel / 32U;
+	uint32_t Bits = pMap[Word] & (0xFFFFFFFFU >> (31U - (Channel % 32U)));
+
+	while (!Bits) {
+		if (Word-- == 0) {
+			return 0xFF;
 		}
-		if (PriorityCh2 == Channel) {
-			return false;
+		Bits = pMap[Word];
+	}
+
+	return (Word * 32U) + 31U - __builtin_clz(Bits);
+}
+
+void RADIO_UpdateChannelMaps(uint8_t Channel)
+{
+	const uint32_t Mask = 1U << (Channel % 32U);
+	uint8_t Map;
+
+	for (Map = 0; Map < ARRAY_SIZE(gChannelMaps); Map++) {
+		if (IsInMap(Map, Channel)) {
+			gChannelMaps[Map][Channel / 32U] |= Mask;
+		} else {
+			gChannelMaps[Map][Channel / 32U] &= ~Mask;
 		}
 	}
+}
+
+void RADIO_InitChannelMaps(void)
+{
+	uint8_t Channel;
+
+	for (Channel = MR_CHANNEL_FIRST; Channel <= MR_CHANNEL_LAST; Channel++) {
+		RADIO_UpdateChannelMaps(Channel);
+	}
+}
+
+bool RADIO_CheckValidChannel(uint16_t Channel, bool bCheckScanList, uint8_t VFO)
+{
+	if (!IS_MR_CHANNEL(Channel)) {
+		return false;
+	}
 
-	return true;
+	return (gChannelMaps[GetChannelMap(bCheckScanList, VFO)][Channel / 32U] >> (Channel % 32U)) & 1U;
 }
 
 uint8_t RADIO_FindNextChannel(uint8_t Channel, int8_t Direction, bool bCheckScanList, uint8_t VFO)
 {
+	const uint32_t *pMap = gChannelMaps[GetChannelMap(bCheckScanList, VFO)];
+	uint8_t Next;
+
+	if (Channel == 0xFF) {
+		Channel = MR_CHANNEL_LAST;
+	} else if (Channel > MR_CHANNEL_LAST) {
+		Channel = MR_CHANNEL_FIRST;
+	}
+
+	if (Direction > 0) {
+		Next = FindChannelUp(pMap, Channel);
+		if (Next == 0xFF && Channel != MR_CHANNEL_FIRST) {
+			Next = FindChannelUp(pMap, MR_CHANNEL_FIRST);
+		}
+	} else {
+		Next = FindChannelDown(pMap, Channel);
+		if (Next == 0xFF && Channel != MR_CHANNEL_LAST) {
+			Next = FindChannelDown(pMap, MR_CHANNEL_LAST);
+		}
+	}
+
+	return Next;
+}
+
+// The raw 16 byte record of a channel or VFO band and, for memory
+// channels, its name.
+typedef struct {
+	uint16_t Base;
+	uint16_t Used;
+	uint8_t Record[16];
+	uint8_t Name[10];
+} ChannelRecord_t;
+
+#if defined(ENABLE_CHANNEL_CACHE)
+uint16_t gChannelCacheHits;
+uint16_t gChannelCacheMisses;
+uint32_t gChannelCacheMissUs;
+
+// Scanning memories reconfigures a channel per step, so the most recently
+// used records are kept in RAM instead of being read over I2C every time.
+static ChannelRecord_t gChannelCache[CHANNEL_CACHE_SIZE];
+static uint8_t gChannelCacheCount;
+static uint16_t gChannelCacheClock;
+
+// Calibration rows of the last squelch level and output power used. A
+// scan rarely leaves either, so one of each is enough.
+static uint16_t gSquelchBase;
+static uint8_t gSquelch[6];
+static uint16_t gTxpBase;
+static uint8_t gTxp[3];
+#else
+static ChannelRecord_t gChannelRecord;
+#endif
+
+static const ChannelRecord_t *GetChannelRecord(uint8_t Channel, uint16_t Base)
+{
+	ChannelRecord_t *pRecord;
+#if defined(ENABLE_CHANNEL_CACHE)
+	uint32_t Start;
 	uint8_t i;
 
-	for (i = 0; i <= MR_CHANNEL_LAST; i++) {
-		if (Channel == 0xFF) {
-			Channel = MR_CHANNEL_LAST;
-		} else if (Channel > MR_CHANNEL_LAST) {
-			Channel = MR_CHANNEL_FIRST;
+	gChannelCacheClock++;
+	for (i = 0; i < gChannelCacheCount; i++) {
+		if (gChannelCache[i].Base == Base) {
+			gChannelCache[i].Used = gChannelCacheClock;
+			gChannelCacheHits++;
+			return &gChannelCache[i];
 		}
-		if (RADIO_CheckValidChannel(Channel, bCheckScanList, VFO)) {
-			return Channel;
+	}
+
+	if (gChannelCacheCount < CHANNEL_CACHE_SIZE) {
+		pRecord = &gChannelCache[gChannelCacheCount++];
+	} else {
+		// Ages are taken relative to the clock so that it may wrap.
+		pRecord = &gChannelCache[0];
+		for (i = 1; i < CHANNEL_CACHE_SIZE; i++) {
+			if ((uint16_t)(gChannelCacheClock - gChannelCache[i].Used) > (uint16_t)(gChannelCacheClock - pRecord->Used)) {
+				pRecord = &gChannelCache[i];
+			}
 		}
-		Channel += Direction;
 	}
+	Start = SYSTICK_GetMicroseconds();
+#else
+	pRecord = &gChannelRecord;
+#endif
 
-	return 0xFF;
+	EEPROM_ReadBuffer(Base, pRecord->Record, sizeof(pRecord->Record));
+	if (IS_MR_CHANNEL(Channel)) {
+		// 16 bytes allocated but only 12 used
+		EEPROM_ReadBuffer(0x0F50 + Base, pRecord->Name, sizeof(pRecord->Name));
+	} else {
+		memset(pRecord->Name, 0, sizeof(pRecord->Name));
+	}
+	pRecord->Base = Base;
+
+#if defined(ENABLE_CHANNEL_CACHE)
+	gChannelCacheMissUs += SYSTICK_GetMicroseconds() - Start;
+	gChannelCacheMisses++;
+	pRecord->Used = gChannelCacheClock;
+#endif
+
+	return pRecord;
 }
 
+#if defined(ENABLE_CHANNEL_CACHE)
+void RADIO_InvalidateChannel(uint8_t Channel)
+{
+	uint16_t Base;
+	uint16_t Size;
+	uint8_t i;
+
+	if (IS_MR_CHANNEL(Channel)) {
+		Base = Channel * 16;
+		Size = 16;
+	} else {
+		Base = 0x0C80 + ((Channel - FREQ_CHANNEL_FIRST) * 32);
+		Size = 32;
+	}
+
+	for (i = 0; i < gChannelCacheCount; ) {
+		if (gChannelCache[i].Base >= Base && gChannelCache[i].Base < Base + Size) {
+			gChannelCache[i] = gChannelCache[--gChannelCacheCount];
+		} else {
+			i++;
+		}
+	}
+}
+
+void RADIO_InvalidateChannels(void)
+{
+	gChannelCacheCount = 0;
+	gSquelchBase = 0;
+	gTxpBase = 0;
+}
+#endif
+
 void RADIO_InitInfo(VFO_Info_t *pInfo, uint8_t ChannelSave, uint8_t Band, uint32_t Frequency)
 {
 	memset(pInfo, 0, sizeof(*pInfo));
@@ -137,7 +308,8 @@ void RADIO_ConfigureChannel(uint8_t VFO, uint32_t Configure)
 	uint8_t Band;
 	bool bParticipation2;
 	uint16_t Base;
-	uint8_t Data[8];
+	const ChannelRecord_t *pRecord;
+	const uint8_t *Data;
 	uint8_t Tmp;
 	uint32_t Frequency;
 
@@ -215,9 +387,10 @@ void RADIO_ConfigureChannel(uint8_t VFO, uint32_t Configure)
 	} else {
 		Base = 0x0C80 + ((Channel - FREQ_CHANNEL_FIRST) * 32) + (VFO * 16);
 	}
+	pRecord = GetChannelRecord(Channel, Base);
 
 	if (Configure == VFO_CONFIGURE_RELOAD || Channel >= FREQ_CHANNEL_FIRST) {
-		EEPROM_ReadBuffer(Base + 8, Data, 8);
+		Data = pRecord->Record + 8;
 
 		Tmp = Data[3] & 0x0F;
 		if (Tmp > 2) {
@@ -305,7 +478,7 @@ void RADIO_ConfigureChannel(uint8_t VFO, uint32_t Configure)
 			uint32_t Offset;
 		} Info;
 
-		EEPROM_ReadBuffer(Base, &Info, 8);
+		memcpy(&Info, pRecord->Record, sizeof(Info));
 
 		pRadio->ConfigRX.Frequency = Info.Frequency;
 		if (Info.Offset >= 100000000) {
@@ -331,11 +504,7 @@ void RADIO_ConfigureChannel(uint8_t VFO, uint32_t Configure)
 	}
 	RADIO_ApplyOffset(pRadio);
 	memset(gEeprom.VfoInfo[VFO].Name, 0, sizeof(gEeprom.VfoInfo[VFO].Name));
-	if (IS_MR_CHANNEL(Channel)) {
-		// 16 bytes allocated but only 12 used
-		EEPROM_ReadBuffer(0x0F50 + (Channel * 0x10), gEeprom.VfoInfo[VFO].Name + 0, 8);
-		EEPROM_ReadBuffer(0x0F58 + (Channel * 0x10), gEeprom.VfoInfo[VFO].Name + 8, 2);
-	}
+	memcpy(gEeprom.VfoInfo[VFO].Name, pRecord->Name, sizeof(pRecord->Name));
 
 	if (!gEeprom.VfoInfo[VFO].FrequencyReverse) {
 		gEeprom.VfoInfo[VFO].pRX = &gEeprom.VfoInfo[VFO].ConfigRX;
@@ -365,19 +534,69 @@ void RADIO_ConfigureChannel(uint8_t VFO, uint32_t Configure)
 	RADIO_ConfigureSquelchAndOutputPower(pRadio);
 }
 
+// One threshold per row of 16 bytes, in the order open RSSI, close RSSI,
+// open noise, close noise, close glitch and open glitch.
+static void ReadSquelch(uint16_t Base, uint8_t *pSquelch)
+{
+	uint8_t i;
+
+#if defined(ENABLE_CHANNEL_CACHE)
+	if (Base == gSquelchBase) {
+		memcpy(pSquelch, gSquelch, sizeof(gSquelch));
+		return;
+	}
+#endif
+	for (i = 0; i < 6; i++) {
+		EEPROM_ReadBuffer(Base + (i * 0x10), &pSquelch[i], 1);
+	}
+#if defined(ENABLE_CHANNEL_CACHE)
+	memcpy(gSquelch, pSquelch, sizeof(gSquelch));
+	gSquelchBase = Base;
+#endif
+}
+
+static void ReadTxp(uint16_t Address, uint8_t *pTxp)
+{
+#if defined(ENABLE_CHANNEL_CACHE)
+	if (Address == gTxpBase) {
+		memcpy(pTxp, gTxp, sizeof(gTxp));
+		return;
+	}
+#endif
+	EEPROM_ReadBuffer(Address, pTxp, 3);
+#if defined(ENABLE_CHANNEL_CACHE)
+	memcpy(gTxp, pTxp, sizeof(gTxp));
+	gTxpBase = Address;
+#endif
+}
+
+// The squelch rows of the current level for Frequency's half of the bands.
+static uint16_t GetSquelchBase(uint32_t Frequency)
+{
+	if (FREQUENCY_GetBand(Frequency) < BAND4_174MHz) {
+		return 0x1E60 + gEeprom.SQUELCH_LEVEL;
+	}
+
+	return 0x1E00 + gEeprom.SQUELCH_LEVEL;
+}
+
+uint8_t RADIO_GetSquelchOpenRSSI(uint32_t Frequency)
+{
+	uint8_t Squelch[6];
+
+	if (gEeprom.SQUELCH_LEVEL == 0) {
+		return 0x00;
+	}
+	ReadSquelch(GetSquelchBase(Frequency), Squelch);
+
+	return Squelch[0];
+}
+
 void RADIO_ConfigureSquelchAndOutputPower(VFO_Info_t *pInfo)
 {
 	uint8_t Txp[3];
-	uint16_t Base;
 	FREQUENCY_Band_t Band;
 
-	Band = FREQUENCY_GetBand(pInfo->pRX->Frequency);
-	if (Band < BAND4_174MHz) {
-		Base = 0x1E60;
-	} else {
-		Base = 0x1E00;
-	}
-
 	if (gEeprom.SQUELCH_LEVEL == 0) {
 		pInfo->SquelchOpenRSSI = 0x00;
 		pInfo->SquelchOpenNoise = 0x7F;
@@ -386,13 +605,15 @@ void RADIO_ConfigureSquelchAndOutputPower(VFO_Info_t *pInfo)
 		pInfo->SquelchCloseNoise = 0x7F;
 		pInfo->SquelchOpenGlitch = 0xFF;
 	} else {
-		Base += gEeprom.SQUELCH_LEVEL;
-		EEPROM_ReadBuffer(Base + 0x00, &pInfo->SquelchOpenRSSI, 1);
-		EEPROM_ReadBuffer(Base + 0x10, &pInfo->SquelchCloseRSSI, 1);
-		EEPROM_ReadBuffer(Base + 0x20, &pInfo->SquelchOpenNoise, 1);
-		EEPROM_ReadBuffer(Base + 0x30, &pInfo->SquelchCloseNoise, 1);
-		EEPROM_ReadBuffer(Base + 0x40, &pInfo->SquelchCloseGlitch, 1);
-		EEPROM_ReadBuffer(Base + 0x50, &pInfo->SquelchOpenGlitch, 1);
+		uint8_t Squelch[6];
+
+		ReadSquelch(GetSquelchBase(pInfo->pRX->Frequency), Squelch);
+		pInfo->SquelchOpenRSSI = Squelch[0];
+		pInfo->SquelchCloseRSSI = Squelch[1];
+		pInfo->SquelchOpenNoise = Squelch[2];
+		pInfo->SquelchCloseNoise = Squelch[3];
+		pInfo->SquelchCloseGlitch = Squelch[4];
+		pInfo->SquelchOpenGlitch = Squelch[5];
 		if (pInfo->SquelchOpenNoise >= 0x80) {
 			pInfo->SquelchOpenNoise = 0x7F;
 		}
@@ -402,7 +623,7 @@ void RADIO_ConfigureSquelchAndOutputPower(VFO_Info_t *pInfo)
 	}
 
 	Band = FREQUENCY_GetBand(pInfo->pTX->Frequency);
-	EEPROM_ReadBuffer(0x1ED0 + (Band * 0x10) + (pInfo->OUTPUT_POWER * 3), Txp, 3);
+	ReadTxp(0x1ED0 + (Band * 0x10) + (pInfo->OUTPUT_POWER * 3), Txp);
 	pInfo->TXP_CalculatedSetting =
 		FREQUENCY_CalculateOutputPower(
 				Txp[0],
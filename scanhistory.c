@@ -0,0 +1,203 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+#include "scanhistory.h"
+#include "misc.h"
+
+// Nothing in here touches the hardware, so the statistics can be built and
+// exercised on a host as they are.
+
+static HISTORY_Entry_t gEntries[HISTORY_SIZE];
+static uint8_t gHits[MR_CHANNEL_LAST + 1];
+static uint16_t gSequence;
+static uint16_t gFlushed;
+static uint8_t gCount;
+
+static HISTORY_Entry_t *GetEntry(uint16_t Sequence)
+{
+	return &gEntries[Sequence % HISTORY_SIZE];
+}
+
+static void CountHit(uint8_t Channel)
+{
+	uint8_t i;
+
+	if (Channel > MR_CHANNEL_LAST) {
+		return;
+	}
+	// Halving every counter keeps the ratios between channels while
+	// making room for new hits.
+	if (gHits[Channel] == 0xFF) {
+		for (i = 0; i <= MR_CHANNEL_LAST; i++) {
+			gHits[i] >>= 1;
+		}
+	}
+	gHits[Channel]++;
+}
+
+void HISTORY_Init(uint16_t Sequence)
+{
+	memset(gEntries, 0, sizeof(gEntries));
+	memset(gHits, 0, sizeof(gHits));
+	gSequence = Sequence;
+	gFlushed = Sequence;
+	gCount = 0;
+}
+
+void HISTORY_Open(uint32_t Tick, uint8_t Channel, uint32_t Frequency, uint8_t Rssi, uint8_t CodeType, uint8_t Code)
+{
+	HISTORY_Entry_t *pEntry;
+
+	HISTORY_Close(Tick);
+
+	pEntry = GetEntry(gSequence);
+	pEntry->Tick = Tick;
+	pEntry->Frequency = Frequency;
+	pEntry->Duration = HISTORY_OPEN;
+	pEntry->Sequence = gSequence;
+	pEntry->Channel = Channel;
+	pEntry->Rssi = Rssi;
+	pEntry->CodeType = CodeType;
+	pEntry->Code = Code;
+
+	gSequence++;
+	if (gCount < HISTORY_SIZE) {
+		gCount++;
+	}
+	CountHit(Channel);
+}
+
+void HISTORY_Close(uint32_t Tick)
+{
+	HISTORY_Entry_t *pEntry;
+	uint32_t Elapsed;
+
+	if (gCount == 0) {
+		return;
+	}
+	pEntry = GetEntry(gSequence - 1);
+	if (pEntry->Duration != HISTORY_OPEN) {
+		return;
+	}
+	Elapsed = Tick - pEntry->Tick;
+	pEntry->Duration = (Elapsed < HISTORY_OPEN) ? Elapsed : HISTORY_OPEN - 1;
+}
+
+uint8_t HISTORY_GetCount(void)
+{
+	return gCount;
+}
+
+const HISTORY_Entry_t *HISTORY_Get(uint8_t Age)
+{
+	if (Age >= gCount) {
+		return NULL;
+	}
+
+	return GetEntry(gSequence - 1 - Age);
+}
+
+uint8_t HISTORY_GetHits(uint8_t Channel)
+{
+	if (Channel > MR_CHANNEL_LAST) {
+		return 0;
+	}
+
+	return gHits[Channel];
+}
+
+// Fills pChannels with up to Count channels that had hits, busiest first.
+uint8_t HISTORY_GetBusiest(uint8_t *pChannels, uint8_t Count)
+{
+	uint8_t Found = 0;
+	uint8_t Channel;
+	uint8_t i;
+
+	for (Channel = 0; Channel <= MR_CHANNEL_LAST; Channel++) {
+		const uint8_t Hits = gHits[Channel];
+
+		if (Hits == 0) {
+			continue;
+		}
+		for (i = Found; i > 0 && gHits[pChannels[i - 1]] < Hits; i--) {
+			if (i < Count) {
+				pChannels[i] = pChannels[i - 1];
+			}
+		}
+		if (i < Count) {
+			pChannels[i] = Channel;
+			if (Found < Count) {
+				Found++;
+			}
+		}
+	}
+
+	return Found;
+}
+
+// Copies the next HISTORY_BATCH finished hits that have not been saved yet.
+// Batches always start on an even sequence so that they land on a whole
+// EEPROM page.
+bool HISTORY_TakeBatch(HISTORY_Entry_t *pBatch)
+{
+	uint8_t i;
+
+	// Hits that dropped out of RAM before they could be saved are lost.
+	if ((uint16_t)(gSequence - gFlushed) > gCount) {
+		gFlushed = gSequence - gCount;
+		gFlushed = (gFlushed + HISTORY_BATCH - 1) & ~(HISTORY_BATCH - 1);
+	}
+	if ((uint16_t)(gSequence - gFlushed) < HISTORY_BATCH) {
+		return false;
+	}
+	for (i = 0; i < HISTORY_BATCH; i++) {
+		const HISTORY_Entry_t *pEntry = GetEntry(gFlushed + i);
+
+		if (pEntry->Duration == HISTORY_OPEN) {
+			return false;
+		}
+		pBatch[i] = *pEntry;
+	}
+	gFlushed += HISTORY_BATCH;
+
+	return true;
+}
+
+// Picks the sequence to continue from after the hits saved in EEPROM, so
+// that new batches overwrite the oldest ones first.
+uint16_t HISTORY_GetNextSequence(const HISTORY_Entry_t *pSaved, uint8_t Count)
+{
+	bool bFound = false;
+	uint16_t Newest = 0;
+	uint8_t i;
+
+	for (i = 0; i < Count; i++) {
+		if (pSaved[i].Tick == 0xFFFFFFFFU && pSaved[i].Sequence == 0xFFFFU) {
+			continue;
+		}
+		if (!bFound || (int16_t)(pSaved[i].Sequence - Newest) > 0) {
+			Newest = pSaved[i].Sequence;
+			bFound = true;
+		}
+	}
+	if (!bFound) {
+		return 0;
+	}
+
+	return (Newest + HISTORY_BATCH) & ~(HISTORY_BATCH - 1);
+}
+
@@ -0,0 +1,55 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef SCANHISTORY_H
+#define SCANHISTORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Scan hits kept in RAM, newest overwriting oldest.
+#define HISTORY_SIZE 16U
+// Hits that fit the reserved EEPROM area, and how many make up one 32 byte
+// EEPROM page.
+#define HISTORY_SAVED 8U
+#define HISTORY_BATCH 2U
+// Duration of a hit whose squelch is still open.
+#define HISTORY_OPEN 0xFFFFU
+
+typedef struct {
+	uint32_t Tick;
+	uint32_t Frequency;
+	uint16_t Duration;
+	uint16_t Sequence;
+	uint8_t Channel;
+	uint8_t Rssi;
+	uint8_t CodeType;
+	uint8_t Code;
+} HISTORY_Entry_t;
+
+void HISTORY_Init(uint16_t Sequence);
+void HISTORY_Open(uint32_t Tick, uint8_t Channel, uint32_t Frequency, uint8_t Rssi, uint8_t CodeType, uint8_t Code);
+void HISTORY_Close(uint32_t Tick);
+uint8_t HISTORY_GetCount(void);
+// Age 0 is the newest hit.
+const HISTORY_Entry_t *HISTORY_Get(uint8_t Age);
+uint8_t HISTORY_GetHits(uint8_t Channel);
+uint8_t HISTORY_GetBusiest(uint8_t *pChannels, uint8_t Count);
+bool HISTORY_TakeBatch(HISTORY_Entry_t *pBatch);
+uint16_t HISTORY_GetNextSequence(const HISTORY_Entry_t *pSaved, uint8_t Count);
+
+#endif
+
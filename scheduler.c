@@ -33,8 +33,6 @@
 		} \
 	} while(0)
 
-static volatile uint32_t gGlobalSysTickCounter;
-
 void SystickHandler(void);
 
 void SystickHandler(void)
@@ -88,6 +86,12 @@ void SystickHandler(void)
 		}
 	}
 
+	if (gScanState != SCAN_OFF && IS_MR_CHANNEL(gNextMrChannel) && gEeprom.SCAN_LIST_ENABLED[gEeprom.SCAN_LIST_DEFAULT]) {
+		if (gCurrentFunction != FUNCTION_MONITOR && gCurrentFunction != FUNCTION_TRANSMIT) {
+			DECREMENT_AND_TRIGGER(gPriorityLookbackCountdown, gSchedulePriorityLookback);
+		}
+	}
+
 	DECREMENT_AND_TRIGGER(gTailNoteEliminationCountdown, gFlagTteComplete);
 
 	DECREMENT_AND_TRIGGER(gCountdownToPlayNextVoice, gFlagPlayQueuedVoice);
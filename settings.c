@@ -22,6 +22,9 @@
 #if defined(ENABLE_UART)
 #include "driver/uart.h"
 #endif
+#if defined(ENABLE_EEPROM_JOURNAL)
+#include "journal.h"
+#endif
 #include "misc.h"
 #include "settings.h"
 
@@ -71,7 +74,11 @@ void SETTINGS_SaveVfoIndices(void)
 	State[6] = gEeprom.NoaaChannel[0];
 	State[7] = gEeprom.NoaaChannel[1];
 
+#if defined(ENABLE_EEPROM_JOURNAL)
+	JOURNAL_Write(0x0E80, State, sizeof(State));
+#else
 	EEPROM_WriteBuffer(0x0E80, State);
+#endif
 }
 
 void SETTINGS_SaveSettings(void)
@@ -203,37 +210,45 @@ void SETTINGS_SaveChannel(uint8_t Channel, uint8_t VFO, const VFO_Info_t *pVFO,
 		}
 
 		if (Mode == 2 || !IS_MR_CHANNEL(Channel)) {
-			uint32_t State32[2];
-			uint8_t State8[8];
+			uint32_t State32[4];
+			uint8_t *pState8 = (uint8_t *)&State32[2];
 
 			State32[0] = pVFO->ConfigRX.Frequency;
 			State32[1] = pVFO->FREQUENCY_OF_DEVIATION;
 
-			EEPROM_WriteBuffer(OffsetVFO + 0, State32);
-
-			State8[0] = pVFO->ConfigRX.Code;
-			State8[1] = pVFO->ConfigTX.Code;
-			State8[2] = (pVFO->ConfigTX.CodeType << 4) | pVFO->ConfigRX.CodeType;
-			State8[3] = (pVFO->AM_CHANNEL_MODE << 4) | pVFO->FREQUENCY_DEVIATION_SETTING;
-			State8[4] = 0
+			pState8[0] = pVFO->ConfigRX.Code;
+			pState8[1] = pVFO->ConfigTX.Code;
+			pState8[2] = (pVFO->ConfigTX.CodeType << 4) | pVFO->ConfigRX.CodeType;
+			pState8[3] = (pVFO->AM_CHANNEL_MODE << 4) | pVFO->FREQUENCY_DEVIATION_SETTING;
+			pState8[4] = 0
 				| (pVFO->BUSY_CHANNEL_LOCK << 4)
 				| (pVFO->OUTPUT_POWER << 2)
 				| (pVFO->CHANNEL_BANDWIDTH << 1)
 				| (pVFO->FrequencyReverse << 0)
 				;
-			State8[5] = (pVFO->DTMF_PTT_ID_TX_MODE << 1) | pVFO->DTMF_DECODING_ENABLE;
-			State8[6] = pVFO->STEP_SETTING;
-			State8[7] = pVFO->SCRAMBLING_TYPE;
+			pState8[5] = (pVFO->DTMF_PTT_ID_TX_MODE << 1) | pVFO->DTMF_DECODING_ENABLE;
+			pState8[6] = pVFO->STEP_SETTING;
+			pState8[7] = pVFO->SCRAMBLING_TYPE;
 
-			EEPROM_WriteBuffer(OffsetVFO + 8, State8);
+#if defined(ENABLE_EEPROM_JOURNAL)
+			if (!IS_MR_CHANNEL(Channel)) {
+				JOURNAL_Write(OffsetVFO, State32, sizeof(State32));
+			} else {
+				EEPROM_WriteCached(OffsetVFO, State32, sizeof(State32));
+			}
+#else
+			EEPROM_WriteCached(OffsetVFO, State32, sizeof(State32));
+#endif
 
 			SETTINGS_UpdateChannel(Channel, pVFO, true);
 
 			if (IS_MR_CHANNEL(Channel)) {
 				memset(&State32, 0xFF, sizeof(State32));
-				EEPROM_WriteBuffer(OffsetMR + 0x0F50, State32);
-				EEPROM_WriteBuffer(OffsetMR + 0x0F58, State32);
+				EEPROM_WriteCached(OffsetMR + 0x0F50, State32, sizeof(State32));
 			}
+#if defined(ENABLE_CHANNEL_CACHE)
+			RADIO_InvalidateChannel(Channel);
+#endif
 		}
 	}
 }
@@ -265,6 +280,7 @@ void SETTINGS_UpdateChannel(uint8_t Channel, const VFO_Info_t *pVFO, bool bUpdat
 		State[Channel & 7U] = Attributes;
 		EEPROM_WriteBuffer(Offset, State);
 		gMR_ChannelAttributes[Channel] = Attributes;
+		RADIO_UpdateChannelMaps(Channel);
 	}
 }
 
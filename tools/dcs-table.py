@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+
+# Precomputes the Golay parity of every DCS code in dcs.c, so that neither
+# building a CDCSS codeword nor recognising a received one needs the 12
+# step polynomial division at run time.
+#
+# Usage: tools/dcs-table.py dcs.c dcs-table.c
+
+import re
+import sys
+
+HEADER = '''/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// Generated by tools/dcs-table.py from dcs.c, do not edit.
+
+#include "dcs.h"
+'''
+
+def golay(code):
+    word = code
+    for i in range(12):
+        word <<= 1
+        if word & 0x1000:
+            word ^= 0x08EA
+    return code | ((word & 0x0FFE) << 11)
+
+def load(source, name):
+    m = re.search(r'const uint16_t ' + name + r'\[(\d+)\] = \{(.*?)\n\};', source, re.S)
+    if m is None:
+        print('%s not found!' % name)
+        sys.exit(1)
+    values = [int(x, 16) for x in m.group(2).replace(',', ' ').split()]
+    if len(values) != int(m.group(1)):
+        print('%s has %d entries!' % (name, len(values)))
+        sys.exit(1)
+    # Both tables are binary searched by the firmware.
+    if values != sorted(set(values)):
+        print('%s must be sorted and unique!' % name)
+        sys.exit(1)
+    return values
+
+source = open(sys.argv[1]).read()
+load(source, 'CTCSS_Options')
+options = load(source, 'DCS_Options')
+if options[-1] > 0x1FF:
+    print('DCS_Options must fit in 9 bits!')
+    sys.exit(1)
+
+out = [HEADER]
+out.append('const uint16_t DCS_Parity[%d] = {' % len(options))
+for i in range(0, len(options), 4):
+    out.append('\t' + ' '.join('0x%03X,' % (golay(code + 0x800) >> 12) for code in options[i:i + 4]))
+out.append('};\n')
+
+open(sys.argv[2], 'w').write('\n'.join(out) + '\n')
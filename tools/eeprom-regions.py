@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+
+# Reads the EEPROM region checksums over the programming cable (UART
+# command 0x0537) and prints them with the regions that failed the check at
+# boot. Given an 8 KB EEPROM image, it also lists the regions whose contents
+# differ from the image, so only those need to be read or written.
+#
+# Usage: tools/eeprom-regions.py PORT [IMAGE]
+
+import crcmod
+import serial
+import struct
+import sys
+import time
+
+crc = crcmod.predefined.mkCrcFun('xmodem')
+
+def send(port, msg_id, body):
+    payload = struct.pack('<HH', msg_id, len(body)) + body
+    port.write(struct.pack('<HH', 0xCDAB, len(payload)) + payload + struct.pack('<HH', crc(payload), 0xBADC))
+
+def receive(port, msg_id):
+    while True:
+        header = port.read(4)
+        if len(header) != 4:
+            print('Timed out waiting for 0x%04X!' % msg_id)
+            sys.exit(1)
+        magic, size = struct.unpack('<HH', header)
+        if magic != 0xCDAB:
+            continue
+        payload = port.read(size)
+        port.read(4)
+        if struct.unpack('<H', payload[:2])[0] == msg_id:
+            return payload[4:]
+
+port = serial.Serial(sys.argv[1], 38400, timeout=3)
+image = open(sys.argv[2], 'rb').read() if len(sys.argv) > 2 else None
+timestamp = int(time.time()) & 0xFFFFFFFF
+
+# 0x0514 starts an unencrypted session.
+send(port, 0x0514, struct.pack('<I', timestamp))
+receive(port, 0x0515)
+
+send(port, 0x0537, struct.pack('<I', timestamp))
+reply = receive(port, 0x0538)
+count, failures = struct.unpack('<BB2x', reply[:4])
+
+differ = 0
+for i in range(count):
+    start, end, checksum = struct.unpack('<HHH', reply[4 + i * 6:10 + i * 6])
+    line = '0x%04X-0x%04X 0x%04X' % (start, end - 1, checksum)
+    if failures & (1 << i):
+        line += ' failed at boot'
+    if image is not None and crc(image[start:end]) != checksum:
+        line += ' differs from image'
+        differ += 1
+    print(line)
+
+if differ:
+    sys.exit(1)
@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+
+# Asks the radio to time a 1 KB EEPROM read (UART command 0x0535) and prints
+# the I2C throughput. The byte sum has to match between builds with and
+# without ENABLE_I2C_FAST, or the fast timing is corrupting reads.
+#
+# Usage: tools/eeprom-speed.py PORT [RUNS]
+
+import crcmod
+import serial
+import struct
+import sys
+import time
+
+crc = crcmod.predefined.mkCrcFun('xmodem')
+
+def send(port, msg_id, body):
+    payload = struct.pack('<HH', msg_id, len(body)) + body
+    port.write(struct.pack('<HH', 0xCDAB, len(payload)) + payload + struct.pack('<HH', crc(payload), 0xBADC))
+
+def receive(port, msg_id):
+    while True:
+        header = port.read(4)
+        if len(header) != 4:
+            print('Timed out waiting for 0x%04X!' % msg_id)
+            sys.exit(1)
+        magic, size = struct.unpack('<HH', header)
+        if magic != 0xCDAB:
+            continue
+        payload = port.read(size)
+        port.read(4)
+        if struct.unpack('<H', payload[:2])[0] == msg_id:
+            return payload[4:]
+
+port = serial.Serial(sys.argv[1], 38400, timeout=1)
+runs = int(sys.argv[2]) if len(sys.argv) > 2 else 5
+timestamp = int(time.time()) & 0xFFFFFFFF
+
+# 0x0514 starts an unencrypted session.
+send(port, 0x0514, struct.pack('<I', timestamp))
+receive(port, 0x0515)
+
+sums = set()
+for run in range(runs):
+    send(port, 0x0535, struct.pack('<I', timestamp))
+    microseconds, rate, size, total = struct.unpack('<IIHH', receive(port, 0x0536)[:12])
+    sums.add(total)
+    print('%d bytes in %d us, %d bytes/s, sum 0x%04X' % (size, microseconds, rate, total))
+
+if len(sums) != 1:
+    print('Byte sums differ between runs!')
+    sys.exit(1)
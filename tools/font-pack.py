@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+
+# Packs the big font and the big frequency digits from font.c into a shared
+# column dictionary. Every glyph column is two bytes (upper and lower page);
+# glyphs are stored as one-byte indices into the dictionary, which keeps
+# random access to a glyph O(1) while removing the many repeated columns.
+#
+# Usage: tools/font-pack.py font.c font-packed.c
+
+import re
+import sys
+
+HEADER = '''/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// Generated by tools/font-pack.py from font.c, do not edit.
+
+#include "font.h"
+'''
+
+def load(source, name):
+    m = re.search(r'const uint8_t ' + name + r'\[(\d+)\]\[(\d+)\] = \{(.*?)\n\};', source, re.S)
+    if m is None:
+        print('%s not found!' % name)
+        sys.exit(1)
+    count, size = int(m.group(1)), int(m.group(2))
+    glyphs = []
+    for row in re.findall(r'\{([^{}]*)\}', m.group(3)):
+        glyph = [int(x, 16) for x in row.replace(',', ' ').split()]
+        if len(glyph) != size:
+            print('%s has a glyph of %d bytes!' % (name, len(glyph)))
+            sys.exit(1)
+        glyphs.append(glyph)
+    if len(glyphs) != count:
+        print('%s has %d glyphs!' % (name, len(glyphs)))
+        sys.exit(1)
+    return glyphs, size // 2
+
+def columns(glyph, width):
+    return [(glyph[i], glyph[i + width]) for i in range(width)]
+
+def unpack(dictionary, indices, width):
+    return [dictionary[i][0] for i in indices] + [dictionary[i][1] for i in indices]
+
+source = open(sys.argv[1]).read()
+fonts = [('gFontBig', 'gFontBigColumns'), ('gFontBigDigits', 'gFontBigDigitsColumns')]
+
+dictionary = [(0x00, 0x00)]
+lookup = {dictionary[0]: 0}
+packed = []
+raw_size = 0
+
+for name, packed_name in fonts:
+    glyphs, width = load(source, name)
+    raw_size += len(glyphs) * width * 2
+    tables = []
+    for glyph in glyphs:
+        indices = []
+        for column in columns(glyph, width):
+            if column not in lookup:
+                lookup[column] = len(dictionary)
+                dictionary.append(column)
+            indices.append(lookup[column])
+        # The firmware has no other copy of the glyphs, so make sure the
+        # packed form expands back to exactly the same pixels.
+        if unpack(dictionary, indices, width) != glyph:
+            print('%s does not round-trip!' % name)
+            sys.exit(1)
+        tables.append(indices)
+    packed.append((packed_name, width, tables))
+
+if len(dictionary) > 256:
+    print('Too many distinct columns (%d)!' % len(dictionary))
+    sys.exit(1)
+
+out = [HEADER]
+out.append('const uint8_t gFontColumns[%d][2] = {' % len(dictionary))
+for column in dictionary:
+    out.append('\t{ 0x%02X, 0x%02X },' % column)
+out.append('};\n')
+
+packed_size = len(dictionary) * 2
+for packed_name, width, tables in packed:
+    out.append('const uint8_t %s[%d][%d] = {' % (packed_name, len(tables), width))
+    for indices in tables:
+        out.append('\t{ ' + ', '.join('0x%02X' % i for i in indices) + ' },')
+    out.append('};\n')
+    packed_size += len(tables) * width
+
+open(sys.argv[2], 'w').write('\n'.join(out) + '\n')
+
+print('%d columns, %d -> %d bytes' % (len(dictionary), raw_size, packed_size))
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+
+# Reads the scan history back over the programming cable (UART command
+# 0x0533) and prints the recorded hits, newest first, followed by the
+# memory channels that had hits, busiest first.
+#
+# Usage: tools/scan-history.py PORT
+
+import crcmod
+import serial
+import struct
+import sys
+import time
+
+CHANNELS = 200
+CODES = ['', 'CTCSS', 'DCS-N', 'DCS-I']
+
+crc = crcmod.predefined.mkCrcFun('xmodem')
+
+def send(port, msg_id, body):
+    payload = struct.pack('<HH', msg_id, len(body)) + body
+    port.write(struct.pack('<HH', 0xCDAB, len(payload)) + payload + struct.pack('<HH', crc(payload), 0xBADC))
+
+def receive(port, msg_id):
+    while True:
+        header = port.read(4)
+        if len(header) != 4:
+            print('Timed out waiting for 0x%04X!' % msg_id)
+            sys.exit(1)
+        magic, size = struct.unpack('<HH', header)
+        if magic != 0xCDAB:
+            continue
+        payload = port.read(size)
+        port.read(4)
+        if struct.unpack('<H', payload[:2])[0] == msg_id:
+            return payload[4:]
+
+def read_history(name):
+    port = serial.Serial(name, 38400, timeout=1)
+    timestamp = int(time.time()) & 0xFFFFFFFF
+
+    # 0x0514 starts an unencrypted session.
+    send(port, 0x0514, struct.pack('<I', timestamp))
+    receive(port, 0x0515)
+
+    # Every reply carries one hit and eight channel counters.
+    hits = []
+    counters = []
+    index = 0
+    count = 0
+    while index < (CHANNELS + 7) // 8 or index < count:
+        send(port, 0x0533, struct.pack('<B3xI', index, timestamp))
+        reply = receive(port, 0x0534)
+        count = reply[1]
+        if index < count:
+            hits.append(struct.unpack('<IIHHBBBB', reply[4:20]))
+        counters += list(reply[20:28])
+        index += 1
+
+    return hits, counters[:CHANNELS]
+
+hits, counters = read_history(sys.argv[1])
+
+for tick, frequency, duration, sequence, channel, rssi, code_type, code in hits:
+    where = 'CH-%03d' % (channel + 1) if channel < CHANNELS else '%.5f MHz' % (frequency / 100000)
+    length = 'open' if duration == 0xFFFF else '%.2f s' % (duration / 100)
+    tone = '%s %d' % (CODES[code_type], code) if code_type else '-'
+    print('#%-5d t=%-10.2f %-16s %4d dBm  %-10s %s' % (sequence, tick / 100, where, rssi - 160, tone, length))
+
+busiest = sorted((n, c) for c, n in enumerate(counters) if n)
+for hits_count, channel in reversed(busiest):
+    print('CH-%03d %d' % (channel + 1, hits_count))
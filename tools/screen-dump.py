@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+
+# Reads the display contents back over the programming cable (UART command
+# 0x0531) and writes them as a plain PBM image. When a reference image is
+# given the two are compared and the exit status tells whether they match,
+# so screens can be checked against known-good captures after UI changes.
+#
+# Usage: tools/screen-dump.py PORT OUTPUT.pbm [REFERENCE.pbm]
+
+import crcmod
+import serial
+import struct
+import sys
+import time
+
+WIDTH = 128
+PAGES = 8
+
+crc = crcmod.predefined.mkCrcFun('xmodem')
+
+def send(port, msg_id, body):
+    payload = struct.pack('<HH', msg_id, len(body)) + body
+    port.write(struct.pack('<HH', 0xCDAB, len(payload)) + payload + struct.pack('<HH', crc(payload), 0xBADC))
+
+def receive(port, msg_id):
+    while True:
+        header = port.read(4)
+        if len(header) != 4:
+            print('Timed out waiting for 0x%04X!' % msg_id)
+            sys.exit(1)
+        magic, size = struct.unpack('<HH', header)
+        if magic != 0xCDAB:
+            continue
+        payload = port.read(size)
+        port.read(4)
+        if struct.unpack('<H', payload[:2])[0] == msg_id:
+            return payload[4:]
+
+def read_screen(name):
+    port = serial.Serial(name, 38400, timeout=1)
+    timestamp = int(time.time()) & 0xFFFFFFFF
+
+    # 0x0514 starts an unencrypted session.
+    send(port, 0x0514, struct.pack('<I', timestamp))
+    receive(port, 0x0515)
+
+    pages = []
+    for page in range(PAGES):
+        send(port, 0x0531, struct.pack('<B3xI', page, timestamp))
+        reply = receive(port, 0x0532)
+        pages.append(reply[4:4 + WIDTH])
+
+    return pages
+
+def to_pixels(pages):
+    return [[(pages[y // 8][x] >> (y % 8)) & 1 for x in range(WIDTH)] for y in range(PAGES * 8)]
+
+def write_pbm(name, pixels):
+    with open(name, 'w') as f:
+        f.write('P1\n%d %d\n' % (WIDTH, len(pixels)))
+        for row in pixels:
+            f.write(''.join(str(p) for p in row) + '\n')
+
+def read_pbm(name):
+    tokens = open(name).read().split()
+    if tokens[0] != 'P1':
+        print('%s is not a plain PBM!' % name)
+        sys.exit(1)
+    width, height = int(tokens[1]), int(tokens[2])
+    bits = [int(c) for c in ''.join(tokens[3:])]
+    return [bits[y * width:(y + 1) * width] for y in range(height)]
+
+pixels = to_pixels(read_screen(sys.argv[1]))
+write_pbm(sys.argv[2], pixels)
+
+if len(sys.argv) > 3:
+    reference = read_pbm(sys.argv[3])
+    if len(reference) != len(pixels):
+        print('Reference has %d rows!' % len(reference))
+        sys.exit(1)
+    diff = sum(a != b for row_a, row_b in zip(pixels, reference) for a, b in zip(row_a, row_b))
+    if diff:
+        print('%d pixels differ from %s' % (diff, sys.argv[3]))
+        sys.exit(1)
+    print('Matches %s' % sys.argv[3])
@@ -55,6 +55,6 @@ void UI_DisplayAircopy(void)
 		sprintf(String, "SND:%d", gAirCopyBlockNumber);
 	}
 	UI_PrintString(String, 2, 127, 4, 8, true);
-	ST7565_BlitFullScreen();
+	ST7565_BlitDirty();
 }
 
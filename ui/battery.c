@@ -19,6 +19,7 @@
 #include "driver/st7565.h"
 #include "functions.h"
 #include "ui/battery.h"
+#include "ui/status.h"
 
 void UI_DisplayBattery(uint8_t Level)
 {
@@ -48,6 +49,7 @@ void UI_DisplayBattery(uint8_t Level)
 			break;
 		}
 		ST7565_DrawLine(110, 0, 18, pBitmap, bClearMode);
+		UI_InvalidateStatus();
 	}
 }
 
@@ -78,13 +78,13 @@ void UI_DisplayFM(void)
 		} else {
 			UI_DisplayFrequency(gInputBox, 23, 4, true, false);
 		}
-		ST7565_BlitFullScreen();
+		ST7565_BlitDirty();
 		return;
 	} else {
 		sprintf(String, "CH-%02d", gEeprom.FM_SelectedChannel + 1);
 	}
 
 	UI_PrintString(String, 0, 127, 4, 10, true);
-	ST7565_BlitFullScreen();
+	ST7565_BlitDirty();
 }
 
@@ -21,6 +21,40 @@
 #include "ui/helper.h"
 #include "ui/inputbox.h"
 
+#if defined(ENABLE_PACKED_FONT)
+static void DrawGlyph(uint8_t *pLine0, uint8_t *pLine1, const uint8_t *pColumns, uint8_t Width)
+{
+	uint8_t i;
+
+	for (i = 0; i < Width; i++) {
+		const uint8_t *pColumn = gFontColumns[pColumns[i]];
+
+		pLine0[i] = pColumn[0];
+		pLine1[i] = pColumn[1];
+	}
+}
+#endif
+
+static void DrawBigGlyph(uint8_t *pLine0, uint8_t *pLine1, uint8_t Index)
+{
+#if defined(ENABLE_PACKED_FONT)
+	DrawGlyph(pLine0, pLine1, gFontBigColumns[Index], 8);
+#else
+	memcpy(pLine0, &gFontBig[Index][0], 8);
+	memcpy(pLine1, &gFontBig[Index][8], 8);
+#endif
+}
+
+static void DrawBigDigit(uint8_t *pLine0, uint8_t *pLine1, uint8_t Digit)
+{
+#if defined(ENABLE_PACKED_FONT)
+	DrawGlyph(pLine0, pLine1, gFontBigDigitsColumns[Digit], 13);
+#else
+	memcpy(pLine0, gFontBigDigits[Digit] +  0, 13);
+	memcpy(pLine1, gFontBigDigits[Digit] + 13, 13);
+#endif
+}
+
 void UI_GenerateChannelString(char *pString, uint8_t Channel)
 {
 	uint8_t i;
@@ -81,8 +115,9 @@ void UI_PrintString(const char *pString, uint8_t Start, uint8_t End, uint8_t Lin
 	for (i = 0; i < Length; i++) {
 		if (pString[i] >= ' ' && pString[i] < 0x7F) {
 			uint8_t Index = pString[i] - ' ';
-			memcpy(gFrameBuffer[Line + 0] + (i * Width) + Start, &gFontBig[Index][0], 8);
-			memcpy(gFrameBuffer[Line + 1] + (i * Width) + Start, &gFontBig[Index][8], 8);
+			DrawBigGlyph(gFrameBuffer[Line + 0] + (i * Width) + Start, gFrameBuffer[Line + 1] + (i * Width) + Start, Index);
+			ST7565_MarkDirty(Line + 0, (i * Width) + Start, 8);
+			ST7565_MarkDirty(Line + 1, (i * Width) + Start, 8);
 		}
 	}
 }
@@ -96,14 +131,18 @@ void UI_DisplayFrequency(const char *pDigits, uint8_t X, uint8_t Y, bool bDispla
 	pFb0 = gFrameBuffer[Y] + X;
 	pFb1 = pFb0 + 128;
 
+	// Blanked leading digits shift everything left by up to 18 columns, the
+	// part of that left of the glass is clipped by ST7565_MarkDirty.
+	ST7565_MarkDirty(Y + 0, bFlag ? X - 18 : X, bFlag ? 99 : 81);
+	ST7565_MarkDirty(Y + 1, bFlag ? X - 18 : X, bFlag ? 99 : 81);
+
 	bCanDisplay = false;
 	for (i = 0; i < 3; i++) {
 		const uint8_t Digit = pDigits[i];
 
 		if (bDisplayLeadingZero || bCanDisplay || Digit) {
 			bCanDisplay = true;
-			memcpy(pFb0 + (i * 13), gFontBigDigits[Digit] +  0, 13);
-			memcpy(pFb1 + (i * 13), gFontBigDigits[Digit] + 13, 13);
+			DrawBigDigit(pFb0 + (i * 13), pFb1 + (i * 13), Digit);
 		} else if (bFlag) {
 			pFb1 -= 6;
 			pFb0 -= 6;
@@ -117,8 +156,7 @@ void UI_DisplayFrequency(const char *pDigits, uint8_t X, uint8_t Y, bool bDispla
 	for (i = 0; i < 3; i++) {
 		const uint8_t Digit = pDigits[i + 3];
 
-		memcpy(pFb0 + (i * 13) + 42, gFontBigDigits[Digit] +  0, 13);
-		memcpy(pFb1 + (i * 13) + 42, gFontBigDigits[Digit] + 13, 13);
+		DrawBigDigit(pFb0 + (i * 13) + 42, pFb1 + (i * 13) + 42, Digit);
 	}
 }
 
@@ -129,5 +167,14 @@ void UI_DisplaySmallDigits(uint8_t Size, const char *pString, uint8_t X, uint8_t
 	for (i = 0; i < Size; i++) {
 		memcpy(gFrameBuffer[Y] + (i * 7) + X, gFontSmallDigits[(uint8_t)pString[i]], 7);
 	}
+	ST7565_MarkDirty(Y, X, Size * 7);
+}
+
+void UI_DrawBitmap(uint8_t *pLine, const uint8_t *pBitmap, uint8_t Size)
+{
+	const uint16_t Offset = pLine - gFrameBuffer[0];
+
+	memcpy(pLine, pBitmap, Size);
+	ST7565_MarkDirty(Offset / 128, Offset % 128, Size);
 }
 
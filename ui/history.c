@@ -0,0 +1,127 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+#include "app/history.h"
+#include "dcs.h"
+#include "driver/st7565.h"
+#include "external/printf/printf.h"
+#include "misc.h"
+#include "scanhistory.h"
+#include "ui/helper.h"
+#include "ui/history.h"
+#include "ui/widget.h"
+
+static UI_Widget_t gRowWidgets[3] = {
+	UI_WIDGET(0, 0, 128, 2),
+	UI_WIDGET(2, 0, 128, 2),
+	UI_WIDGET(4, 0, 128, 2),
+};
+
+static void FormatCode(char *pString, const HISTORY_Entry_t *pEntry)
+{
+	uint8_t Length;
+
+	switch (pEntry->CodeType) {
+	case CODE_TYPE_CONTINUOUS_TONE:
+		Length = NUMBER_FormatFixed(pString, CTCSS_Options[pEntry->Code], 1);
+		strcpy(pString + Length, "Hz");
+		break;
+	case CODE_TYPE_DIGITAL:
+		sprintf(pString, "D%03oN", DCS_Options[pEntry->Code]);
+		break;
+	case CODE_TYPE_REVERSE_DIGITAL:
+		sprintf(pString, "D%03oI", DCS_Options[pEntry->Code]);
+		break;
+	default:
+		strcpy(pString, "OFF");
+		break;
+	}
+}
+
+// One hit: where, what code and how strong, then how long and how long ago.
+static void DrawLog(void)
+{
+	const HISTORY_Entry_t *pEntry = HISTORY_Get(gHistoryAge);
+	char String[17];
+	uint32_t Age;
+	uint8_t Length;
+
+	if (pEntry == NULL) {
+		UI_WidgetText(&gRowWidgets[0], "NO HITS", 0, 8, true);
+		UI_WidgetText(&gRowWidgets[1], "", 0, 8, false);
+		UI_WidgetText(&gRowWidgets[2], "", 0, 8, false);
+		return;
+	}
+
+	Length = sprintf(String, "%u ", gHistoryAge + 1);
+	if (IS_MR_CHANNEL(pEntry->Channel)) {
+		sprintf(String + Length, "CH-%03u", pEntry->Channel + 1);
+	} else {
+		NUMBER_FormatFixed(String + Length, pEntry->Frequency, 5);
+	}
+	UI_WidgetText(&gRowWidgets[0], String, 0, 8, false);
+
+	FormatCode(String, pEntry);
+	Length = strlen(String);
+	sprintf(String + Length, " %ddBm", (int)pEntry->Rssi - 160);
+	UI_WidgetText(&gRowWidgets[1], String, 0, 8, false);
+
+	Age = (gGlobalSysTickCounter - pEntry->Tick) / 100;
+	if (Age > 9999) {
+		Age = 9999;
+	}
+	if (pEntry->Duration == HISTORY_OPEN) {
+		Length = sprintf(String, "OPEN");
+	} else {
+		Length = sprintf(String, "%u.%us", pEntry->Duration / 100, (pEntry->Duration / 10) % 10);
+	}
+	sprintf(String + Length, " -%us", (unsigned int)Age);
+	UI_WidgetText(&gRowWidgets[2], String, 0, 8, false);
+}
+
+static void DrawBusiest(void)
+{
+	uint8_t Channels[3];
+	uint8_t Count;
+	uint8_t i;
+
+	Count = HISTORY_GetBusiest(Channels, 3);
+	for (i = 0; i < 3; i++) {
+		char String[17];
+
+		if (i < Count) {
+			sprintf(String, "CH-%03u %3u", Channels[i] + 1, HISTORY_GetHits(Channels[i]));
+		} else if (i == 0) {
+			strcpy(String, "NO HITS");
+		} else {
+			String[0] = 0;
+		}
+		UI_WidgetText(&gRowWidgets[i], String, 0, 8, false);
+	}
+}
+
+void UI_DisplayHistory(void)
+{
+	if (gHistoryView == HISTORY_VIEW_LOG) {
+		DrawLog();
+	} else {
+		DrawBusiest();
+	}
+
+	ST7565_BlitRetained();
+}
+
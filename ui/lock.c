@@ -27,13 +27,15 @@
 #include "ui/helper.h"
 #include "ui/inputbox.h"
 #include "ui/lock.h"
+#include "ui/status.h"
 
-static void Render(void)
+void UI_DrawLock(void)
 {
 	char String[7];
 	uint8_t i;
 
 	memset(gStatusLine, 0, sizeof(gStatusLine));
+	UI_InvalidateStatus();
 	memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
 	strcpy(String, "LOCK");
 	UI_PrintString(String, 0, 127, 1, 10, true);
@@ -120,7 +122,7 @@ void UI_DisplayLock(void)
 #endif
 
 		if (gUpdateDisplay) {
-			Render();
+			UI_DrawLock();
 			gUpdateDisplay = false;
 		}
 	}
@@ -18,6 +18,8 @@
 #define UI_LOCK_H
 
 void UI_DisplayLock(void);
+// Draws the password prompt for what is in gInputBox.
+void UI_DrawLock(void);
 
 #endif
 
@@ -26,6 +26,7 @@
 #include "ui/helper.h"
 #include "ui/inputbox.h"
 #include "ui/main.h"
+#include "ui/widget.h"
 
 enum {
 	LEVEL_MODE_OFF = 0,
@@ -33,36 +34,246 @@ enum {
 	LEVEL_MODE_RSSI,
 };
 
+enum {
+	FREQUENCY_STATE = 0,
+	FREQUENCY_INPUT,
+	FREQUENCY_DIGITS,
+	FREQUENCY_TEXT,
+};
+
+enum {
+	CODE_NONE = 0,
+	CODE_AM,
+	CODE_CT,
+	CODE_DCS,
+};
+
+// Each VFO block is four widgets: the arrow, RX/TX and channel number on
+// the left, the frequency or name, the level bar and the bitmaps beside it.
+static UI_Widget_t gChannelWidgets[2] = { UI_WIDGET(0, 0, 31, 2), UI_WIDGET(4, 0, 31, 2) };
+static UI_Widget_t gFrequencyWidgets[2] = { UI_WIDGET(0, 31, 97, 2), UI_WIDGET(4, 31, 97, 2) };
+static UI_Widget_t gLevelWidgets[2] = { UI_WIDGET(2, 0, 23, 1), UI_WIDGET(6, 0, 23, 1) };
+static UI_Widget_t gAttributeWidgets[2] = { UI_WIDGET(2, 23, 105, 1), UI_WIDGET(6, 23, 105, 1) };
+
+// The lock message and the DTMF call lines are drawn across the blocks.
+static bool gMainIsImmediate;
+
+static bool BeginFrequency(uint8_t VFO, uint8_t Kind, const void *pData, uint8_t Size)
+{
+	uint32_t Value;
+
+	Value = UI_WidgetHash(UI_WIDGET_HASH_SEED, &Kind, 1);
+	Value = UI_WidgetHash(Value, pData, Size);
+
+	return UI_WidgetBegin(&gFrequencyWidgets[VFO], Value);
+}
+
+static void DisplayChannel(uint8_t VFO, const uint8_t *pArrow, const uint8_t *pActivity)
+{
+	UI_Widget_t *pWidget = &gChannelWidgets[VFO];
+	const uint8_t Channel = gEeprom.ScreenChannel[VFO];
+	const uint8_t *pBitmap = NULL;
+	uint8_t BitmapColumn = 0;
+	uint8_t DigitsColumn = 0;
+	uint8_t Digits = 0;
+	char String[8];
+	uint32_t Value;
+
+	if (IS_MR_CHANNEL(Channel)) {
+		pBitmap = BITMAP_M;
+		BitmapColumn = 2;
+		if (gInputBoxIndex == 0 || gEeprom.TX_VFO != VFO) {
+			NUMBER_ToDigits(Channel + 1, String);
+		} else {
+			memcpy(String + 5, gInputBox, 3);
+		}
+		Digits = 3;
+		DigitsColumn = 10;
+	} else if (IS_FREQ_CHANNEL(Channel)) {
+		pBitmap = BITMAP_F;
+		BitmapColumn = 14;
+		String[7] = (Channel - FREQ_CHANNEL_FIRST) + 1;
+		Digits = 1;
+		DigitsColumn = 22;
+	} else {
+#if defined(ENABLE_NOAA)
+		pBitmap = BITMAP_NarrowBand;
+		BitmapColumn = 7;
+		if (gInputBoxIndex == 0 || gEeprom.TX_VFO != VFO) {
+			NUMBER_ToDigits((Channel - NOAA_CHANNEL_FIRST) + 1, String);
+		} else {
+			String[6] = gInputBox[0];
+			String[7] = gInputBox[1];
+		}
+		Digits = 2;
+		DigitsColumn = 15;
+#endif
+	}
+
+	Value = UI_WidgetHash(UI_WIDGET_HASH_SEED, &pArrow, sizeof(pArrow));
+	Value = UI_WidgetHash(Value, &pActivity, sizeof(pActivity));
+	Value = UI_WidgetHash(Value, &pBitmap, sizeof(pBitmap));
+	Value = UI_WidgetHash(Value, String + 8 - Digits, Digits);
+	if (!UI_WidgetBegin(pWidget, Value)) {
+		return;
+	}
+
+	if (pArrow) {
+		UI_DrawBitmap(gFrameBuffer[pWidget->Line] + 2, pArrow, sizeof(BITMAP_VFO_Default));
+	}
+	if (pActivity) {
+		UI_DrawBitmap(gFrameBuffer[pWidget->Line] + 14, pActivity, sizeof(BITMAP_TX));
+	}
+	if (pBitmap) {
+		UI_DrawBitmap(gFrameBuffer[pWidget->Line + 1] + BitmapColumn, pBitmap, sizeof(BITMAP_M));
+		UI_DisplaySmallDigits(Digits, String + 8 - Digits, DigitsColumn, pWidget->Line + 1);
+	}
+}
+
+static void DisplayAttributes(uint8_t VFO, uint8_t LevelMode)
+{
+	const VFO_Info_t *pInfo = &gEeprom.VfoInfo[VFO];
+	uint8_t *pLine = gFrameBuffer[gAttributeWidgets[VFO].Line];
+	uint32_t Value;
+
+	if (pInfo->IsAM) {
+		Value = CODE_AM;
+	} else {
+		const FREQ_Config_t *pConfig;
+
+		if (LevelMode == LEVEL_MODE_TX) {
+			pConfig = pInfo->pTX;
+		} else {
+			pConfig = pInfo->pRX;
+		}
+		switch (pConfig->CodeType) {
+		case CODE_TYPE_CONTINUOUS_TONE:
+			Value = CODE_CT;
+			break;
+		case CODE_TYPE_DIGITAL:
+		case CODE_TYPE_REVERSE_DIGITAL:
+			Value = CODE_DCS;
+			break;
+		default:
+			Value = CODE_NONE;
+			break;
+		}
+	}
+	Value |= (pInfo->OUTPUT_POWER & 7U) << 2;
+	if (pInfo->ConfigRX.Frequency != pInfo->ConfigTX.Frequency) {
+		Value |= (pInfo->FREQUENCY_DEVIATION_SETTING & 3U) << 5;
+	}
+	Value |= (pInfo->FrequencyReverse ? 1U : 0U) << 7;
+	Value |= (pInfo->CHANNEL_BANDWIDTH == BANDWIDTH_NARROW ? 1U : 0U) << 8;
+	Value |= (pInfo->DTMF_DECODING_ENABLE || gSetting_KILLED ? 1U : 0U) << 9;
+	Value |= (pInfo->SCRAMBLING_TYPE && gSetting_ScrambleEnable ? 1U : 0U) << 10;
+	if (!UI_WidgetBegin(&gAttributeWidgets[VFO], Value)) {
+		return;
+	}
+
+	// 0x931E
+	switch (Value & 3U) {
+	case CODE_AM:
+		UI_DrawBitmap(pLine + 27, BITMAP_AM, sizeof(BITMAP_AM));
+		break;
+	case CODE_CT:
+		UI_DrawBitmap(pLine + 27, BITMAP_CT, sizeof(BITMAP_CT));
+		break;
+	case CODE_DCS:
+		UI_DrawBitmap(pLine + 24, BITMAP_DCS, sizeof(BITMAP_DCS));
+		break;
+	}
+
+	// 0x936C
+	switch (pInfo->OUTPUT_POWER) {
+	case OUTPUT_POWER_LOW:
+		UI_DrawBitmap(pLine + 44, BITMAP_PowerLow, sizeof(BITMAP_PowerLow));
+		break;
+	case OUTPUT_POWER_MID:
+		UI_DrawBitmap(pLine + 44, BITMAP_PowerMid, sizeof(BITMAP_PowerMid));
+		break;
+	case OUTPUT_POWER_HIGH:
+		UI_DrawBitmap(pLine + 44, BITMAP_PowerHigh, sizeof(BITMAP_PowerHigh));
+		break;
+	}
+
+	switch ((Value >> 5) & 3U) {
+	case FREQUENCY_DEVIATION_ADD:
+		UI_DrawBitmap(pLine + 54, BITMAP_Add, sizeof(BITMAP_Add));
+		break;
+	case FREQUENCY_DEVIATION_SUB:
+		UI_DrawBitmap(pLine + 54, BITMAP_Sub, sizeof(BITMAP_Sub));
+		break;
+	}
+
+	if (Value & (1U << 7)) {
+		UI_DrawBitmap(pLine + 64, BITMAP_ReverseMode, sizeof(BITMAP_ReverseMode));
+	}
+	if (Value & (1U << 8)) {
+		UI_DrawBitmap(pLine + 74, BITMAP_NarrowBand, sizeof(BITMAP_NarrowBand));
+	}
+	if (Value & (1U << 9)) {
+		UI_DrawBitmap(pLine + 84, BITMAP_DTMF, sizeof(BITMAP_DTMF));
+	}
+	if (Value & (1U << 10)) {
+		UI_DrawBitmap(pLine + 110, BITMAP_Scramble, sizeof(BITMAP_Scramble));
+	}
+}
+
+void UI_DisplayLevel(uint8_t VFO, uint8_t Level)
+{
+	uint8_t *pLine = gFrameBuffer[gLevelWidgets[VFO].Line];
+
+	if (!UI_WidgetBegin(&gLevelWidgets[VFO], Level) || Level == 0) {
+		return;
+	}
+
+	// TODO: not quite how the original does it, but it's quite entangled in Ghidra.
+	UI_DrawBitmap(pLine + 0, BITMAP_Antenna, sizeof(BITMAP_Antenna));
+	UI_DrawBitmap(pLine + 5, BITMAP_AntennaLevel1, sizeof(BITMAP_AntennaLevel1));
+	if (Level >= 2) {
+		UI_DrawBitmap(pLine + 8, BITMAP_AntennaLevel2, sizeof(BITMAP_AntennaLevel2));
+	}
+	if (Level >= 3) {
+		UI_DrawBitmap(pLine + 11, BITMAP_AntennaLevel3, sizeof(BITMAP_AntennaLevel3));
+	}
+	if (Level >= 4) {
+		UI_DrawBitmap(pLine + 14, BITMAP_AntennaLevel4, sizeof(BITMAP_AntennaLevel4));
+	}
+	if (Level >= 5) {
+		UI_DrawBitmap(pLine + 17, BITMAP_AntennaLevel5, sizeof(BITMAP_AntennaLevel5));
+	}
+	if (Level >= 6) {
+		UI_DrawBitmap(pLine + 20, BITMAP_AntennaLevel6, sizeof(BITMAP_AntennaLevel6));
+	}
+}
+
 void UI_DisplayMain(void)
 {
+	const bool bIsLocked = gEeprom.KEY_LOCK && gKeypadLocked;
+	const bool bIsDtmfShown = gDTMF_CallState != DTMF_CALL_STATE_NONE || gDTMF_IsTx || gDTMF_InputMode;
 	char String[16];
 	uint8_t i;
 
-	memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
-	if (gEeprom.KEY_LOCK && gKeypadLocked) {
+	// Whatever was drawn outside the widgets last frame has to be cleared.
+	if (bIsLocked || bIsDtmfShown || gMainIsImmediate) {
+		UI_InvalidateWidgets();
+	}
+	gMainIsImmediate = bIsLocked || bIsDtmfShown;
+
+	if (bIsLocked) {
 		UI_PrintString("Long Press #", 0, 127, 1, 8, true);
 		UI_PrintString("To Unlock", 0, 127, 3, 8, true);
-		ST7565_BlitFullScreen();
+		ST7565_BlitRetained();
 		return;
 	}
 
 	for (i = 0; i < 2; i++) {
-		uint8_t *pLine0;
-		uint8_t *pLine1;
-		uint8_t Line;
+		const uint8_t *pArrow = NULL;
+		const uint8_t *pActivity = NULL;
 		uint8_t Channel;
 		bool bIsSameVfo;
 
-		if (i == 0) {
-			pLine0 = gFrameBuffer[0];
-			pLine1 = gFrameBuffer[1];
-			Line = 0;
-		} else {
-			pLine0 = gFrameBuffer[4];
-			pLine1 = gFrameBuffer[5];
-			Line = 4;
-		}
-
 		Channel = gEeprom.TX_VFO;
 		bIsSameVfo = !!(Channel == i);
 
@@ -71,7 +282,7 @@ void UI_DisplayMain(void)
 		}
 
 		if (Channel != i) {
-			if (gDTMF_CallState != DTMF_CALL_STATE_NONE || gDTMF_IsTx || gDTMF_InputMode) {
+			if (bIsDtmfShown) {
 				char Contact[16];
 
 				if (!gDTMF_InputMode) {
@@ -122,13 +333,13 @@ void UI_DisplayMain(void)
 				UI_PrintString(String, 2, 127, 2 + (i * 3), 8, false);
 				continue;
 			} else if (bIsSameVfo) {
-				memcpy(pLine0 + 2, BITMAP_VFO_Default, sizeof(BITMAP_VFO_Default));
+				pArrow = BITMAP_VFO_Default;
 			}
 		} else {
 			if (bIsSameVfo) {
-				memcpy(pLine0 + 2, BITMAP_VFO_Default, sizeof(BITMAP_VFO_Default));
+				pArrow = BITMAP_VFO_Default;
 			} else {
-				memcpy(pLine0 + 2, BITMAP_VFO_NotDefault, sizeof(BITMAP_VFO_NotDefault));
+				pArrow = BITMAP_VFO_NotDefault;
 			}
 		}
 
@@ -150,43 +361,18 @@ void UI_DisplayMain(void)
 				}
 				if (Channel == i) {
 					LevelMode = LEVEL_MODE_TX;
-					memcpy(pLine0 + 14, BITMAP_TX, sizeof(BITMAP_TX));
+					pActivity = BITMAP_TX;
 				}
 			}
 		} else {
 			LevelMode = LEVEL_MODE_RSSI;
 			if ((gCurrentFunction == FUNCTION_RECEIVE || gCurrentFunction == FUNCTION_MONITOR) && gEeprom.RX_VFO == i) {
-				memcpy(pLine0 + 14, BITMAP_RX, sizeof(BITMAP_RX));
+				pActivity = BITMAP_RX;
 			}
 		}
 
 		// 0x8F3C
-		if (IS_MR_CHANNEL(gEeprom.ScreenChannel[i])) {
-			memcpy(pLine1 + 2, BITMAP_M, sizeof(BITMAP_M));
-			if (gInputBoxIndex == 0 || gEeprom.TX_VFO != i) {
-				NUMBER_ToDigits(gEeprom.ScreenChannel[i] + 1, String);
-			} else {
-				memcpy(String + 5, gInputBox, 3);
-			}
-			UI_DisplaySmallDigits(3, String + 5, 10, Line + 1);
-		} else if (IS_FREQ_CHANNEL(gEeprom.ScreenChannel[i])) {
-			char c;
-
-			memcpy(pLine1 + 14, BITMAP_F, sizeof(BITMAP_F));
-			c = (gEeprom.ScreenChannel[i] - FREQ_CHANNEL_FIRST) + 1;
-			UI_DisplaySmallDigits(1, &c, 22, Line + 1);
-		} else {
-#if defined(ENABLE_NOAA)
-			memcpy(pLine1 + 7, BITMAP_NarrowBand, sizeof(BITMAP_NarrowBand));
-			if (gInputBoxIndex == 0 || gEeprom.TX_VFO != i) {
-				NUMBER_ToDigits((gEeprom.ScreenChannel[i] - NOAA_CHANNEL_FIRST) + 1, String);
-			} else {
-				String[6] = gInputBox[0];
-				String[7] = gInputBox[1];
-			}
-			UI_DisplaySmallDigits(2, String + 6, 15, Line + 1);
-#endif
-		}
+		DisplayChannel(i, pArrow, pActivity);
 
 		// 0x8FEC
 
@@ -204,76 +390,87 @@ void UI_DisplayMain(void)
 		}
 #endif
 		if (State) {
-			uint8_t Width = 10;
-
-			memset(String, 0, sizeof(String));
-			switch (State) {
-			case 1:
-				strcpy(String, "BUSY");
-				Width = 15;
-				break;
-			case 2:
-				strcpy(String, "BAT LOW");
-				break;
-			case 3:
-				strcpy(String, "DISABLE");
-				break;
-			case 4:
-				strcpy(String, "TIMEOUT");
-				break;
+			if (BeginFrequency(i, FREQUENCY_STATE, &State, 1)) {
+				uint8_t Width = 10;
+
+				memset(String, 0, sizeof(String));
+				switch (State) {
+				case 1:
+					strcpy(String, "BUSY");
+					Width = 15;
+					break;
+				case 2:
+					strcpy(String, "BAT LOW");
+					break;
+				case 3:
+					strcpy(String, "DISABLE");
+					break;
+				case 4:
+					strcpy(String, "TIMEOUT");
+					break;
 #if defined(ENABLE_ALARM)
-			case 5:
-				strcpy(String, "ALARM");
-				break;
+				case 5:
+					strcpy(String, "ALARM");
+					break;
 #endif
-			case 6:
-				sprintf(String, "VOL HIGH");
-				Width = 8;
-				break;
+				case 6:
+					sprintf(String, "VOL HIGH");
+					Width = 8;
+					break;
+				}
+				UI_PrintString(String, 31, 111, i * 4, Width, true);
 			}
-			UI_PrintString(String, 31, 111, i * 4, Width, true);
-		} else {
-			if (gInputBoxIndex && IS_FREQ_CHANNEL(gEeprom.ScreenChannel[i]) && gEeprom.TX_VFO == i) {
+		} else if (gInputBoxIndex && IS_FREQ_CHANNEL(gEeprom.ScreenChannel[i]) && gEeprom.TX_VFO == i) {
+			if (BeginFrequency(i, FREQUENCY_INPUT, gInputBox, sizeof(gInputBox))) {
 				UI_DisplayFrequency(gInputBox, 31, i * 4, true, false);
+			}
+		} else if (!IS_MR_CHANNEL(gEeprom.ScreenChannel[i]) || gEeprom.CHANNEL_DISPLAY_MODE == MDF_FREQUENCY) {
+			if (gCurrentFunction == FUNCTION_TRANSMIT) {
+				if (gEeprom.CROSS_BAND_RX_TX == CROSS_BAND_OFF) {
+					Channel = gEeprom.RX_VFO;
+				} else {
+					Channel = gEeprom.TX_VFO;
+				}
+				if (Channel == i) {
+					NUMBER_ToDigits(gEeprom.VfoInfo[i].pTX->Frequency, String);
+				} else {
+					NUMBER_ToDigits(gEeprom.VfoInfo[i].pRX->Frequency, String);
+				}
 			} else {
-				if (!IS_MR_CHANNEL(gEeprom.ScreenChannel[i]) || gEeprom.CHANNEL_DISPLAY_MODE == MDF_FREQUENCY) {
-					if (gCurrentFunction == FUNCTION_TRANSMIT) {
-						if (gEeprom.CROSS_BAND_RX_TX == CROSS_BAND_OFF) {
-							Channel = gEeprom.RX_VFO;
-						} else {
-							Channel = gEeprom.TX_VFO;
-						}
-						if (Channel == i) {
-							NUMBER_ToDigits(gEeprom.VfoInfo[i].pTX->Frequency, String);
-						} else {
-							NUMBER_ToDigits(gEeprom.VfoInfo[i].pRX->Frequency, String);
-						}
-					} else {
-						NUMBER_ToDigits(gEeprom.VfoInfo[i].pRX->Frequency, String);
-					}
-					UI_DisplayFrequency(String, 31, i * 4, false, false);
-					if (IS_MR_CHANNEL(gEeprom.ScreenChannel[i])) {
-						const uint8_t Attributes = gMR_ChannelAttributes[gEeprom.ScreenChannel[i]];
-						if (Attributes & MR_CH_SCANLIST1) {
-							memcpy(pLine0 + 113, BITMAP_ScanList, sizeof(BITMAP_ScanList));
-						}
-						if (Attributes & MR_CH_SCANLIST2) {
-							memcpy(pLine0 + 120, BITMAP_ScanList, sizeof(BITMAP_ScanList));
-						}
-					}
-					UI_DisplaySmallDigits(2, String + 6, 112, Line + 1);
-				} else if (gEeprom.CHANNEL_DISPLAY_MODE == MDF_CHANNEL) {
+				NUMBER_ToDigits(gEeprom.VfoInfo[i].pRX->Frequency, String);
+			}
+			// The scan list marks go with the digits.
+			String[8] = 0;
+			if (IS_MR_CHANNEL(gEeprom.ScreenChannel[i])) {
+				String[8] = gMR_ChannelAttributes[gEeprom.ScreenChannel[i]] & (MR_CH_SCANLIST1 | MR_CH_SCANLIST2);
+			}
+			if (BeginFrequency(i, FREQUENCY_DIGITS, String, 9)) {
+				UI_DisplayFrequency(String, 31, i * 4, false, false);
+				if (String[8] & MR_CH_SCANLIST1) {
+					UI_DrawBitmap(gFrameBuffer[i * 4] + 113, BITMAP_ScanList, sizeof(BITMAP_ScanList));
+				}
+				if (String[8] & MR_CH_SCANLIST2) {
+					UI_DrawBitmap(gFrameBuffer[i * 4] + 120, BITMAP_ScanList, sizeof(BITMAP_ScanList));
+				}
+				UI_DisplaySmallDigits(2, String + 6, 112, (i * 4) + 1);
+			}
+		} else {
+			const char *pText = "";
+
+			if (gEeprom.CHANNEL_DISPLAY_MODE == MDF_CHANNEL) {
+				sprintf(String, "CH-%03d", gEeprom.ScreenChannel[i] + 1);
+				pText = String;
+			} else if (gEeprom.CHANNEL_DISPLAY_MODE == MDF_NAME) {
+				if(gEeprom.VfoInfo[i].Name[0] == 0 || gEeprom.VfoInfo[i].Name[0] == 0xFF) {
 					sprintf(String, "CH-%03d", gEeprom.ScreenChannel[i] + 1);
-					UI_PrintString(String, 31, 112, i * 4, 8, true);
-				} else if (gEeprom.CHANNEL_DISPLAY_MODE == MDF_NAME) {
-					if(gEeprom.VfoInfo[i].Name[0] == 0 || gEeprom.VfoInfo[i].Name[0] == 0xFF) {
-						sprintf(String, "CH-%03d", gEeprom.ScreenChannel[i] + 1);
-						UI_PrintString(String, 31, 112, i * 4, 8, true);
-					} else {
-						UI_PrintString(gEeprom.VfoInfo[i].Name, 31, 112, i * 4, 8, true);
-					}
+					pText = String;
+				} else {
+					pText = gEeprom.VfoInfo[i].Name;
 				}
 			}
+			if (BeginFrequency(i, FREQUENCY_TEXT, pText, strlen(pText))) {
+				UI_PrintString(pText, 31, 112, i * 4, 8, true);
+			}
 		}
 
 		// 0x926E
@@ -292,89 +489,11 @@ void UI_DisplayMain(void)
 				Level = gVFO_RSSI_Level[i];
 			}
 		}
+		UI_DisplayLevel(i, Level);
 
-		// TODO: not quite how the original does it, but it's quite entangled in Ghidra.
-		if (Level) {
-			memcpy(pLine1 + 128 + 0, BITMAP_Antenna, sizeof(BITMAP_Antenna));
-			memcpy(pLine1 + 128 + 5, BITMAP_AntennaLevel1, sizeof(BITMAP_AntennaLevel1));
-			if (Level >= 2) {
-				memcpy(pLine1 + 128 + 8, BITMAP_AntennaLevel2, sizeof(BITMAP_AntennaLevel2));
-			}
-			if (Level >= 3) {
-				memcpy(pLine1 + 128 + 11, BITMAP_AntennaLevel3, sizeof(BITMAP_AntennaLevel3));
-			}
-			if (Level >= 4) {
-				memcpy(pLine1 + 128 + 14, BITMAP_AntennaLevel4, sizeof(BITMAP_AntennaLevel4));
-			}
-			if (Level >= 5) {
-				memcpy(pLine1 + 128 + 17, BITMAP_AntennaLevel5, sizeof(BITMAP_AntennaLevel5));
-			}
-			if (Level >= 6) {
-				memcpy(pLine1 + 128 + 20, BITMAP_AntennaLevel6, sizeof(BITMAP_AntennaLevel6));
-			}
-		}
-
-		// 0x931E
-		if (gEeprom.VfoInfo[i].IsAM) {
-			memcpy(pLine1 + 128 + 27, BITMAP_AM, sizeof(BITMAP_AM));
-		} else {
-			const FREQ_Config_t *pConfig;
-
-			if (LevelMode == LEVEL_MODE_TX) {
-				pConfig = gEeprom.VfoInfo[i].pTX;
-			} else {
-				pConfig = gEeprom.VfoInfo[i].pRX;
-			}
-			switch (pConfig->CodeType) {
-			case CODE_TYPE_CONTINUOUS_TONE:
-				memcpy(pLine1 + 128 + 27, BITMAP_CT, sizeof(BITMAP_CT));
-				break;
-			case CODE_TYPE_DIGITAL:
-			case CODE_TYPE_REVERSE_DIGITAL:
-				memcpy(pLine1 + 128 + 24, BITMAP_DCS, sizeof(BITMAP_DCS));
-				break;
-			default:
-				break;
-			}
-		}
-
-		// 0x936C
-		switch (gEeprom.VfoInfo[i].OUTPUT_POWER) {
-		case OUTPUT_POWER_LOW:
-			memcpy(pLine1 + 128 + 44, BITMAP_PowerLow, sizeof(BITMAP_PowerLow));
-			break;
-		case OUTPUT_POWER_MID:
-			memcpy(pLine1 + 128 + 44, BITMAP_PowerMid, sizeof(BITMAP_PowerMid));
-			break;
-		case OUTPUT_POWER_HIGH:
-			memcpy(pLine1 + 128 + 44, BITMAP_PowerHigh, sizeof(BITMAP_PowerHigh));
-			break;
-		}
-
-		if (gEeprom.VfoInfo[i].ConfigRX.Frequency != gEeprom.VfoInfo[i].ConfigTX.Frequency) {
-			if (gEeprom.VfoInfo[i].FREQUENCY_DEVIATION_SETTING == FREQUENCY_DEVIATION_ADD) {
-				memcpy(pLine1 + 128 + 54, BITMAP_Add, sizeof(BITMAP_Add));
-			}
-			if (gEeprom.VfoInfo[i].FREQUENCY_DEVIATION_SETTING == FREQUENCY_DEVIATION_SUB) {
-				memcpy(pLine1 + 128 + 54, BITMAP_Sub, sizeof(BITMAP_Sub));
-			}
-
-		}
-
-		if (gEeprom.VfoInfo[i].FrequencyReverse) {
-			memcpy(pLine1 + 128 + 64, BITMAP_ReverseMode, sizeof(BITMAP_ReverseMode));
-		}
-		if (gEeprom.VfoInfo[i].CHANNEL_BANDWIDTH == BANDWIDTH_NARROW) {
-			memcpy(pLine1 + 128 + 74, BITMAP_NarrowBand, sizeof(BITMAP_NarrowBand));
-		}
-		if (gEeprom.VfoInfo[i].DTMF_DECODING_ENABLE || gSetting_KILLED) {
-			memcpy(pLine1 + 128 + 84, BITMAP_DTMF, sizeof(BITMAP_DTMF));
-		}
-		if (gEeprom.VfoInfo[i].SCRAMBLING_TYPE && gSetting_ScrambleEnable) {
-			memcpy(pLine1 + 128 + 110, BITMAP_Scramble, sizeof(BITMAP_Scramble));
-		}
+		DisplayAttributes(i, LevelMode);
 	}
 
-	ST7565_BlitFullScreen();
+	ST7565_BlitRetained();
 }
 
@@ -17,6 +17,9 @@
 #ifndef UI_MAIN_H
 #define UI_MAIN_H
 
+#include <stdint.h>
+
+void UI_DisplayLevel(uint8_t VFO, uint8_t Level);
 void UI_DisplayMain(void);
 
 #endif
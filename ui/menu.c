@@ -197,14 +197,17 @@ void UI_DisplayMenu(void)
 		gFrameBuffer[2][i] ^= 0xFF;
 		gFrameBuffer[3][i] ^= 0xFF;
 	}
+	ST7565_MarkDirty(2, 0, 48);
+	ST7565_MarkDirty(3, 0, 48);
 	for (i = 0; i < 7; i++) {
 		gFrameBuffer[i][48] = 0xFF;
 		gFrameBuffer[i][49] = 0xFF;
+		ST7565_MarkDirty(i, 48, 2);
 	}
 	NUMBER_ToDigits(gMenuCursor + 1, String);
 	UI_DisplaySmallDigits(2, String + 6, 33, 6);
 	if (gIsInSubMenu) {
-		memcpy(gFrameBuffer[0] + 50, BITMAP_CurrentIndicator, sizeof(BITMAP_CurrentIndicator));
+		UI_DrawBitmap(gFrameBuffer[0] + 50, BITMAP_CurrentIndicator, sizeof(BITMAP_CurrentIndicator));
 	}
 
 	memset(String, 0, sizeof(String));
@@ -216,7 +219,8 @@ void UI_DisplayMenu(void)
 		break;
 
 	case MENU_STEP:
-		sprintf(String, "%.2fKHz", gSubMenu_Step[gSubMenuSelection] * 0.01);
+		i = NUMBER_FormatFixed(String, gSubMenu_Step[gSubMenuSelection], 2);
+		strcpy(String + i, "KHz");
 		break;
 
 	case MENU_TXP:
@@ -239,7 +243,8 @@ void UI_DisplayMenu(void)
 		if (gSubMenuSelection == 0) {
 			strcpy(String, "OFF");
 		} else {
-			sprintf(String, "%.1fHz", CTCSS_Options[gSubMenuSelection - 1] * 0.1);
+			i = NUMBER_FormatFixed(String, CTCSS_Options[gSubMenuSelection - 1], 1);
+			strcpy(String + i, "Hz");
 		}
 		break;
 
@@ -249,7 +254,7 @@ void UI_DisplayMenu(void)
 
 	case MENU_OFFSET:
 		if (!gIsInSubMenu || gInputBoxIndex == 0) {
-			sprintf(String, "%.5f", gSubMenuSelection * 1e-05);
+			NUMBER_FormatFixed(String, gSubMenuSelection, 5);
 			break;
 		}
 		for (i = 0; i < 3; i++) {
@@ -412,7 +417,8 @@ void UI_DisplayMenu(void)
 		break;
 
 	case MENU_VOL:
-		sprintf(String, "%.2fV", gBatteryVoltageAverage * 0.01);
+		i = NUMBER_FormatFixed(String, gBatteryVoltageAverage, 2);
+		strcpy(String + i, "V");
 		break;
 
 	case MENU_RESET:
@@ -493,6 +499,6 @@ void UI_DisplayMenu(void)
 		}
 	}
 
-	ST7565_BlitFullScreen();
+	ST7565_BlitDirty();
 }
 
@@ -27,7 +27,7 @@ void UI_DisplayModem(void)
 
     UI_PrintString(szModem, 2, 127, 0, 8, true);
 
-    ST7565_BlitFullScreen();
+    ST7565_BlitDirty();
 
     return;
 }
\ No newline at end of file
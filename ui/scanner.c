@@ -23,32 +23,40 @@
 #include "misc.h"
 #include "ui/helper.h"
 #include "ui/scanner.h"
+#include "ui/widget.h"
+
+static UI_Widget_t gFrequencyWidget = UI_WIDGET(1, 0, 128, 2);
+static UI_Widget_t gCodeWidget = UI_WIDGET(3, 0, 128, 2);
+static UI_Widget_t gStateWidget = UI_WIDGET(5, 0, 128, 2);
 
 void UI_DisplayScanner(void)
 {
 	char String[16];
 	bool bCentered;
 	uint8_t Start;
+	uint8_t Length;
 
-	memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
 	memset(String, 0, sizeof(String));
 
 	if (gScanSingleFrequency || (gScanCssState != SCAN_CSS_STATE_OFF && gScanCssState != SCAN_CSS_STATE_FAILED)) {
-		sprintf(String, "FREQ:%.5f", gScanFrequency * 1e-05);
+		strcpy(String, "FREQ:");
+		NUMBER_FormatFixed(String + 5, gScanFrequency, 5);
 	} else {
 		sprintf(String, "FREQ:**.*****");
 	}
-	UI_PrintString(String, 2, 127, 1, 8, false);
+	UI_WidgetText(&gFrequencyWidget, String, 2, 8, false);
 	memset(String, 0, sizeof(String));
 
 	if (gScanCssState < SCAN_CSS_STATE_FOUND || !gScanUseCssResult) {
 		sprintf(String, "CTC:******");
 	} else if (gScanCssResultType == CODE_TYPE_CONTINUOUS_TONE) {
-		sprintf(String, "CTC:%.1fHz", CTCSS_Options[gScanCssResultCode] * 0.1);
+		strcpy(String, "CTC:");
+		Length = NUMBER_FormatFixed(String + 4, CTCSS_Options[gScanCssResultCode], 1);
+		strcpy(String + 4 + Length, "Hz");
 	} else {
 		sprintf(String, "DCS:D%03oN", DCS_Options[gScanCssResultCode]);
 	}
-	UI_PrintString(String, 2, 127, 3, 8, false);
+	UI_WidgetText(&gCodeWidget, String, 2, 8, false);
 	memset(String, 0, sizeof(String));
 
 	if (gScannerEditState == 2) {
@@ -73,7 +81,7 @@ void UI_DisplayScanner(void)
 		bCentered = 0;
 	}
 
-	UI_PrintString(String, Start, 127, 5, 8, bCentered);
-	ST7565_BlitFullScreen();
+	UI_WidgetText(&gStateWidget, String, Start, 8, bCentered);
+	ST7565_BlitRetained();
 }
 
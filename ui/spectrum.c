@@ -0,0 +1,144 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+#include "app/spectrum.h"
+#include "driver/st7565.h"
+#include "external/printf/printf.h"
+#include "misc.h"
+#include "ui/helper.h"
+#include "ui/spectrum.h"
+#include "ui/widget.h"
+
+#define GRAPH_LINE	2U
+#define GRAPH_LINES	5U
+#define GRAPH_HEIGHT	(GRAPH_LINES * 8U)
+
+// 4x4 ordered dither thresholds, in 2 dB steps above the noise floor.
+static const uint8_t Bayer[4][4] = {
+	{  0,  8,  2, 10 },
+	{ 12,  4, 14,  6 },
+	{  3, 11,  1,  9 },
+	{ 15,  7, 13,  5 },
+};
+
+static UI_Widget_t gHeaderWidget = UI_WIDGET(0, 0, 128, 2);
+static UI_Widget_t gGraphWidget = UI_WIDGET(GRAPH_LINE, 0, 128, GRAPH_LINES);
+static SPECTRUM_Mode_t gShownMode;
+static uint16_t gWaterfallSweep;
+static uint8_t gWaterfallRow;
+
+static uint8_t GetNoiseFloor(void)
+{
+	uint8_t Floor = 0xFF;
+	uint8_t i;
+
+	for (i = 0; i < SPECTRUM_POINTS; i++) {
+		if (gSpectrumRssi[i] < Floor) {
+			Floor = gSpectrumRssi[i];
+		}
+	}
+
+	return Floor ? Floor - 1 : 0;
+}
+
+// One column per point, one pixel per dB above the weakest point.
+static void DrawBars(uint8_t Floor)
+{
+	uint8_t i;
+
+	for (i = 0; i < SPECTRUM_POINTS; i++) {
+		uint8_t Height = gSpectrumRssi[i] - Floor;
+		uint8_t Top;
+		uint8_t Line;
+
+		if (Height > GRAPH_HEIGHT) {
+			Height = GRAPH_HEIGHT;
+		}
+		Top = GRAPH_HEIGHT - Height;
+		for (Line = 0; Line < GRAPH_LINES; Line++) {
+			const uint8_t Row = Line * 8;
+
+			if (Top <= Row) {
+				gFrameBuffer[GRAPH_LINE + Line][i] = 0xFF;
+			} else if (Top < Row + 8) {
+				gFrameBuffer[GRAPH_LINE + Line][i] = 0xFF << (Top - Row);
+			}
+		}
+	}
+}
+
+// Moves the whole graph one pixel down by shifting every column through
+// its pages, then dithers the latest sweep into the freed top row.
+static void AddWaterfallRow(uint8_t Floor)
+{
+	const uint8_t *pThreshold = Bayer[gWaterfallRow & 3];
+	uint8_t i;
+
+	for (i = 0; i < SPECTRUM_POINTS; i++) {
+		uint8_t Carry = 0;
+		uint8_t Level;
+		uint8_t Line;
+
+		for (Line = GRAPH_LINE; Line < GRAPH_LINE + GRAPH_LINES; Line++) {
+			const uint8_t Byte = gFrameBuffer[Line][i];
+
+			gFrameBuffer[Line][i] = (Byte << 1) | Carry;
+			Carry = Byte >> 7;
+		}
+
+		Level = (gSpectrumRssi[i] - Floor) >> 1;
+		if (Level > pThreshold[i & 3]) {
+			gFrameBuffer[GRAPH_LINE][i] |= 1U;
+		}
+	}
+	gWaterfallRow++;
+}
+
+void UI_DisplaySpectrum(void)
+{
+	const uint8_t Floor = GetNoiseFloor();
+	char String[17];
+	uint8_t Length;
+
+	// Centre frequency and sweep rate, e.g. "433.00000 1234/s".
+	Length = NUMBER_FormatFixed(String, gSpectrumStart + ((SPECTRUM_POINTS / 2) * SPECTRUM_GetStep()), 5);
+	sprintf(String + Length, " %4u/s", gSpectrumPointsPerSecond > 9999 ? 9999 : gSpectrumPointsPerSecond);
+	UI_WidgetText(&gHeaderWidget, String, 0, 8, false);
+
+	if (gShownMode != gSpectrumMode) {
+		gShownMode = gSpectrumMode;
+		gGraphWidget.Generation = 0;
+	}
+
+	if (gSpectrumMode == SPECTRUM_MODE_BARS) {
+		if (UI_WidgetBegin(&gGraphWidget, gSpectrumSweepCount)) {
+			DrawBars(Floor);
+		}
+	} else {
+		// The waterfall keeps its history in gFrameBuffer, so the widget
+		// only clears it when the screen or the mode changed.
+		UI_WidgetBegin(&gGraphWidget, 0);
+		if (gWaterfallSweep != gSpectrumSweepCount) {
+			gWaterfallSweep = gSpectrumSweepCount;
+			AddWaterfallRow(Floor);
+			ST7565_MarkDirty(GRAPH_LINE, 0, GRAPH_LINES * 128);
+		}
+	}
+
+	ST7565_BlitRetained();
+}
+
@@ -27,61 +27,165 @@
 #include "settings.h"
 #include "ui/status.h"
 
-void UI_DisplayStatus(void)
+enum {
+	STATUS_SLOT_POWER_SAVE = 0,
+	STATUS_SLOT_NOAA,
+	STATUS_SLOT_FM,
+	STATUS_SLOT_VOICE,
+	STATUS_SLOT_TDR,
+	STATUS_SLOT_WX,
+	STATUS_SLOT_VOX,
+	STATUS_SLOT_KEY,
+	STATUS_SLOT_USB_C,
+	STATUS_SLOT_BATTERY,
+	STATUS_SLOT_COUNT,
+};
+
+typedef struct {
+	uint8_t Column;
+	uint8_t Width;
+} StatusSlot_t;
+
+// Widest icon that can appear in each slot. Some slots overlap (power
+// save and NOAA share column 7) so redraws copy from the composed line.
+static const StatusSlot_t gStatusSlots[STATUS_SLOT_COUNT] = {
+	[STATUS_SLOT_POWER_SAVE] = {   0,  8 },
+	[STATUS_SLOT_NOAA]       = {   7, 12 },
+	[STATUS_SLOT_FM]         = {  21, 12 },
+	[STATUS_SLOT_VOICE]      = {  34,  9 },
+	[STATUS_SLOT_TDR]        = {  45, 12 },
+	[STATUS_SLOT_WX]         = {  58, 12 },
+	[STATUS_SLOT_VOX]        = {  71, 18 },
+	[STATUS_SLOT_KEY]        = {  90, 10 },
+	[STATUS_SLOT_USB_C]      = { 100,  9 },
+	[STATUS_SLOT_BATTERY]    = { 110, 18 },
+};
+
+static const uint8_t BITMAP_Killed[10] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+
+// Icon currently on the glass for each slot, NULL when the slot is blank.
+static const uint8_t *gStatusShown[STATUS_SLOT_COUNT];
+static bool gStatusValid;
+
+uint16_t gStatusBlitCount;
+uint16_t gStatusBlitsPerMinute;
+
+static void GetStatusSnapshot(const uint8_t **pSnapshot)
 {
-	memset(gStatusLine, 0, sizeof(gStatusLine));
+	memset(pSnapshot, 0, sizeof(gStatusShown));
+
 	if (gCurrentFunction == FUNCTION_POWER_SAVE) {
-		memcpy(gStatusLine, BITMAP_PowerSave, sizeof(BITMAP_PowerSave));
+		pSnapshot[STATUS_SLOT_POWER_SAVE] = BITMAP_PowerSave;
 	}
 	if (gBatteryDisplayLevel < 2) {
 		if (gLowBatteryBlink == 1) {
-			memcpy(gStatusLine + 110, BITMAP_BatteryLevel1, sizeof(BITMAP_BatteryLevel1));
+			pSnapshot[STATUS_SLOT_BATTERY] = BITMAP_BatteryLevel1;
 		}
 	} else {
 		if (gBatteryDisplayLevel == 2) {
-			memcpy(gStatusLine + 110, BITMAP_BatteryLevel2, sizeof(BITMAP_BatteryLevel2));
+			pSnapshot[STATUS_SLOT_BATTERY] = BITMAP_BatteryLevel2;
 		} else if (gBatteryDisplayLevel == 3) {
-			memcpy(gStatusLine + 110, BITMAP_BatteryLevel3, sizeof(BITMAP_BatteryLevel3));
+			pSnapshot[STATUS_SLOT_BATTERY] = BITMAP_BatteryLevel3;
 		} else if (gBatteryDisplayLevel == 4) {
-			memcpy(gStatusLine + 110, BITMAP_BatteryLevel4, sizeof(BITMAP_BatteryLevel4));
+			pSnapshot[STATUS_SLOT_BATTERY] = BITMAP_BatteryLevel4;
 		} else {
-			memcpy(gStatusLine + 110, BITMAP_BatteryLevel5, sizeof(BITMAP_BatteryLevel5));
+			pSnapshot[STATUS_SLOT_BATTERY] = BITMAP_BatteryLevel5;
 		}
 	}
 	if (gChargingWithTypeC) {
-		memcpy(gStatusLine + 100, BITMAP_USB_C, sizeof(BITMAP_USB_C));
+		pSnapshot[STATUS_SLOT_USB_C] = BITMAP_USB_C;
 	}
 	if (gEeprom.KEY_LOCK) {
-		memcpy(gStatusLine + 90, BITMAP_KeyLock, sizeof(BITMAP_KeyLock));
+		pSnapshot[STATUS_SLOT_KEY] = BITMAP_KeyLock;
 	} else if (gWasFKeyPressed) {
-		memcpy(gStatusLine + 90, BITMAP_F_Key, sizeof(BITMAP_F_Key));
+		pSnapshot[STATUS_SLOT_KEY] = BITMAP_F_Key;
 	}
 
 	if (gEeprom.VOX_SWITCH) {
-		memcpy(gStatusLine + 71, BITMAP_VOX, sizeof(BITMAP_VOX));
+		pSnapshot[STATUS_SLOT_VOX] = BITMAP_VOX;
 	}
 	if (gEeprom.CROSS_BAND_RX_TX != CROSS_BAND_OFF) {
-		memcpy(gStatusLine + 58, BITMAP_WX, sizeof(BITMAP_WX));
+		pSnapshot[STATUS_SLOT_WX] = BITMAP_WX;
 	}
 	if (gEeprom.DUAL_WATCH != DUAL_WATCH_OFF) {
-		memcpy(gStatusLine + 45, BITMAP_TDR, sizeof(BITMAP_TDR));
+		pSnapshot[STATUS_SLOT_TDR] = BITMAP_TDR;
 	}
 	if (gEeprom.VOICE_PROMPT != VOICE_PROMPT_OFF) {
-		memcpy(gStatusLine + 34, BITMAP_VoicePrompt, sizeof(BITMAP_VoicePrompt));
+		pSnapshot[STATUS_SLOT_VOICE] = BITMAP_VoicePrompt;
 	}
 	if (gSetting_KILLED) {
-		memset(gStatusLine + 21, 0xFF, 10);
+		pSnapshot[STATUS_SLOT_FM] = BITMAP_Killed;
 	}
 #if defined(ENABLE_FMRADIO)
 	else if (gFmRadioMode) {
-		memcpy(gStatusLine + 21, BITMAP_FM, sizeof(BITMAP_FM));
+		pSnapshot[STATUS_SLOT_FM] = BITMAP_FM;
 	}
 #endif
 #if defined(ENABLE_NOAA)
 	if (gIsNoaaMode) {
-		memcpy(gStatusLine + 7, BITMAP_NOAA, sizeof(BITMAP_NOAA));
+		pSnapshot[STATUS_SLOT_NOAA] = BITMAP_NOAA;
 	}
 #endif
-	ST7565_BlitStatusLine();
 }
 
+static uint8_t GetIconSize(uint8_t Slot, const uint8_t *pBitmap)
+{
+	if (pBitmap == BITMAP_KeyLock) {
+		return sizeof(BITMAP_KeyLock);
+	}
+	if (pBitmap == BITMAP_Killed) {
+		return sizeof(BITMAP_Killed);
+	}
+
+	// Every other icon fills its slot exactly.
+	return gStatusSlots[Slot].Width;
+}
+
+void UI_DisplayStatus(void)
+{
+	const uint8_t *Snapshot[STATUS_SLOT_COUNT];
+	uint8_t i;
+
+	GetStatusSnapshot(Snapshot);
+	if (gStatusValid && memcmp(Snapshot, gStatusShown, sizeof(Snapshot)) == 0) {
+		return;
+	}
+
+	memset(gStatusLine, 0, sizeof(gStatusLine));
+	for (i = 0; i < STATUS_SLOT_COUNT; i++) {
+		if (Snapshot[i]) {
+			memcpy(gStatusLine + gStatusSlots[i].Column, Snapshot[i], GetIconSize(i, Snapshot[i]));
+		}
+	}
+
+	if (!gStatusValid) {
+		ST7565_BlitStatusLine();
+	} else {
+		for (i = 0; i < STATUS_SLOT_COUNT; i++) {
+			if (Snapshot[i] != gStatusShown[i]) {
+				ST7565_DrawLine(gStatusSlots[i].Column, 0, gStatusSlots[i].Width, gStatusLine + gStatusSlots[i].Column, false);
+			}
+		}
+	}
+
+	memcpy(gStatusShown, Snapshot, sizeof(gStatusShown));
+	gStatusValid = true;
+	gStatusBlitCount++;
+}
+
+void UI_InvalidateStatus(void)
+{
+	gStatusValid = false;
+}
+
+void UI_UpdateStatusStats(void)
+{
+	static uint8_t Ticks;
+
+	// Called every 500 ms.
+	if (++Ticks == 120) {
+		Ticks = 0;
+		gStatusBlitsPerMinute = gStatusBlitCount;
+		gStatusBlitCount = 0;
+	}
+}
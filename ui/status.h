@@ -17,7 +17,14 @@
 #ifndef UI_STATUS_H
 #define UI_STATUS_H
 
+#include <stdint.h>
+
+extern uint16_t gStatusBlitCount;
+extern uint16_t gStatusBlitsPerMinute;
+
 void UI_DisplayStatus(void);
+void UI_InvalidateStatus(void);
+void UI_UpdateStatusStats(void);
 
 #endif
 
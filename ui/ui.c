@@ -21,11 +21,15 @@
 #endif
 #include "app/scanner.h"
 #include "driver/keyboard.h"
+#include "driver/st7565.h"
 #include "misc.h"
 #if defined(ENABLE_AIRCOPY)
 #include "ui/aircopy.h"
 #endif
 #include "ui/fmradio.h"
+#if defined(ENABLE_SCAN_HISTORY)
+#include "ui/history.h"
+#endif
 #include "ui/inputbox.h"
 #include "ui/main.h"
 #include "ui/menu.h"
@@ -33,7 +37,11 @@
 #include "ui/modem.h"
 #endif
 #include "ui/scanner.h"
+#if defined(ENABLE_SPECTRUM)
+#include "ui/spectrum.h"
+#endif
 #include "ui/ui.h"
+#include "ui/widget.h"
 
 GUI_DisplayType_t gScreenToDisplay;
 GUI_DisplayType_t gRequestDisplayScreen = DISPLAY_INVALID;
@@ -44,6 +52,16 @@ bool gAskToDelete;
 
 void GUI_DisplayScreen(void)
 {
+	static GUI_DisplayType_t PreviousScreen = DISPLAY_INVALID;
+
+#if !defined(ENABLE_DISPLAY_DOUBLE_BUFFER)
+	ST7565_WaitForBlit();
+#endif
+	if (PreviousScreen != gScreenToDisplay) {
+		PreviousScreen = gScreenToDisplay;
+		UI_InvalidateWidgets();
+	}
+
 	switch (gScreenToDisplay) {
 	case DISPLAY_MAIN:
 		UI_DisplayMain();
@@ -68,6 +86,16 @@ void GUI_DisplayScreen(void)
 	case DISPLAY_MODEM:
 		UI_DisplayModem();
 		break;
+#endif
+#if defined(ENABLE_SPECTRUM)
+	case DISPLAY_SPECTRUM:
+		UI_DisplaySpectrum();
+		break;
+#endif
+#if defined(ENABLE_SCAN_HISTORY)
+	case DISPLAY_HISTORY:
+		UI_DisplayHistory();
+		break;
 #endif
 	default:
 		break;
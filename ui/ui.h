@@ -32,6 +32,12 @@ enum GUI_DisplayType_t {
 #endif
 #if defined(ENABLE_MODEM)
 	DISPLAY_MODEM  = 0x05U,
+#endif
+#if defined(ENABLE_SPECTRUM)
+	DISPLAY_SPECTRUM	= 0x06U,
+#endif
+#if defined(ENABLE_SCAN_HISTORY)
+	DISPLAY_HISTORY	= 0x07U,
 #endif
 	DISPLAY_INVALID	= 0xFFU,
 };
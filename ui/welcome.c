@@ -19,8 +19,10 @@
 #include "driver/st7565.h"
 #include "external/printf/printf.h"
 #include "helper/battery.h"
+#include "misc.h"
 #include "settings.h"
 #include "ui/helper.h"
+#include "ui/status.h"
 #include "ui/welcome.h"
 #include "version.h"
 
@@ -28,8 +30,10 @@ void UI_DisplayWelcome(void)
 {
 	char WelcomeString0[16];
 	char WelcomeString1[16];
+	uint8_t Length;
 
 	memset(gStatusLine, 0, sizeof(gStatusLine));
+	UI_InvalidateStatus();
 	memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
 
 	if (gEeprom.POWER_ON_DISPLAY_MODE == POWER_ON_DISPLAY_MODE_FULL_SCREEN) {
@@ -39,7 +43,8 @@ void UI_DisplayWelcome(void)
 		memset(WelcomeString1, 0, sizeof(WelcomeString1));
 		if (gEeprom.POWER_ON_DISPLAY_MODE == POWER_ON_DISPLAY_MODE_VOLTAGE) {
 			sprintf(WelcomeString0, "VOLTAGE");
-			sprintf(WelcomeString1, "%.2fV", gBatteryVoltageAverage * 0.01);
+			Length = NUMBER_FormatFixed(WelcomeString1, gBatteryVoltageAverage, 2);
+			strcpy(WelcomeString1 + Length, "V");
 		} else {
 			EEPROM_ReadBuffer(0x0EB0, WelcomeString0, 16);
 			EEPROM_ReadBuffer(0x0EC0, WelcomeString1, 16);
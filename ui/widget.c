@@ -0,0 +1,73 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+#include "driver/st7565.h"
+#include "ui/helper.h"
+#include "ui/widget.h"
+
+uint32_t gWidgetGeneration = 1;
+
+uint32_t UI_WidgetHash(uint32_t Hash, const void *pData, uint8_t Size)
+{
+	const uint8_t *pBytes = pData;
+	uint8_t i;
+
+	// FNV-1a
+	for (i = 0; i < Size; i++) {
+		Hash = (Hash ^ pBytes[i]) * 16777619U;
+	}
+
+	return Hash;
+}
+
+bool UI_WidgetBegin(UI_Widget_t *pWidget, uint32_t Value)
+{
+	uint8_t i;
+
+	if (pWidget->Generation == gWidgetGeneration && pWidget->Value == Value) {
+		return false;
+	}
+
+	pWidget->Generation = gWidgetGeneration;
+	pWidget->Value = Value;
+	for (i = 0; i < pWidget->Lines; i++) {
+		memset(gFrameBuffer[pWidget->Line + i] + pWidget->Column, 0, pWidget->Width);
+		ST7565_MarkDirty(pWidget->Line + i, pWidget->Column, pWidget->Width);
+	}
+
+	return true;
+}
+
+void UI_InvalidateWidgets(void)
+{
+	gWidgetGeneration++;
+	ST7565_ClearFrameBuffer();
+}
+
+void UI_WidgetText(UI_Widget_t *pWidget, const char *pString, uint8_t Start, uint8_t Width, bool bCentered)
+{
+	uint32_t Value;
+
+	Value = UI_WidgetHash(UI_WIDGET_HASH_SEED, pString, strlen(pString));
+	Value = UI_WidgetHash(Value, &Start, 1);
+	Value = UI_WidgetHash(Value, &Width, 1);
+	Value = UI_WidgetHash(Value, &bCentered, 1);
+	if (UI_WidgetBegin(pWidget, Value)) {
+		UI_PrintString(pString, Start, pWidget->Column + pWidget->Width - 1, pWidget->Line, Width, bCentered);
+	}
+}
+
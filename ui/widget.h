@@ -0,0 +1,52 @@
+/* Copyright 2025 Benjamin Roberts
+ * https://github.com/tsujamin
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef UI_WIDGET_H
+#define UI_WIDGET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// A fixed rectangle of gFrameBuffer that remembers what it last rendered.
+// Widgets only clear, redraw and mark their rectangle dirty when the value
+// they are given changes, or after the screen has been switched. The main,
+// scanner, history and spectrum screens are made of them. The menu draws
+// its cursor bar across every element, so it stays immediate.
+typedef struct {
+	uint8_t Line;
+	uint8_t Column;
+	uint8_t Width;
+	uint8_t Lines;
+	uint32_t Value;
+	uint32_t Generation;
+} UI_Widget_t;
+
+#define UI_WIDGET(Line, Column, Width, Lines) { Line, Column, Width, Lines, 0, 0 }
+
+#define UI_WIDGET_HASH_SEED	2166136261U
+
+extern uint32_t gWidgetGeneration;
+
+void UI_InvalidateWidgets(void);
+// Folds pData into Hash, for widgets whose value is more than one number.
+uint32_t UI_WidgetHash(uint32_t Hash, const void *pData, uint8_t Size);
+// For custom drawing: clears the rectangle and returns true when it has to
+// be redrawn for Value.
+bool UI_WidgetBegin(UI_Widget_t *pWidget, uint32_t Value);
+void UI_WidgetText(UI_Widget_t *pWidget, const char *pString, uint8_t Start, uint8_t Width, bool bCentered);
+
+#endif
+